@@ -0,0 +1,75 @@
+#include "JsonBenchmarkReporter.h"
+
+#include <catch2/reporters/catch_reporter_registrars.hpp>
+
+#include <chrono>
+#include <ctime>
+#include <ostream>
+
+namespace {
+
+template <typename Duration>
+double toNanoseconds(Duration duration) {
+    return std::chrono::duration<double, std::nano>(duration).count();
+}
+
+std::string escaped(const std::string& text) {
+    std::string out;
+    out.reserve(text.size());
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+} // namespace
+
+JsonBenchmarkReporter::JsonBenchmarkReporter(Catch::ReporterConfig&& config)
+    : StreamingReporterBase(std::move(config))
+{
+}
+
+std::string JsonBenchmarkReporter::getDescription() {
+    return "Writes benchmark statistics as JSON for comparison between commits";
+}
+
+void JsonBenchmarkReporter::benchmarkEnded(Catch::BenchmarkStats<> const& stats) {
+    Result result;
+    result.name = stats.info.name;
+    result.samples = stats.info.samples;
+    result.iterations = stats.info.iterations;
+    result.meanNs = toNanoseconds(stats.mean.point);
+    result.lowerNs = toNanoseconds(stats.mean.lower_bound);
+    result.upperNs = toNanoseconds(stats.mean.upper_bound);
+    result.stddevNs = toNanoseconds(stats.standardDeviation.point);
+    m_results.push_back(result);
+}
+
+void JsonBenchmarkReporter::testRunEnded(Catch::TestRunStats const& stats) {
+    StreamingReporterBase::testRunEnded(stats);
+
+    const std::time_t now = std::time(nullptr);
+    char timestamp[32];
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    m_stream << "{\n"
+             << "  \"run\": \"" << escaped(stats.runInfo.name) << "\",\n"
+             << "  \"timestamp\": \"" << timestamp << "\",\n"
+             << "  \"benchmarks\": [";
+    for (size_t i = 0; i < m_results.size(); ++i) {
+        const Result& r = m_results[i];
+        m_stream << (i ? ",\n" : "\n")
+                 << "    { \"name\": \"" << escaped(r.name) << "\""
+                 << ", \"samples\": " << r.samples
+                 << ", \"iterations\": " << r.iterations
+                 << ", \"mean_ns\": " << r.meanNs
+                 << ", \"mean_lower_ns\": " << r.lowerNs
+                 << ", \"mean_upper_ns\": " << r.upperNs
+                 << ", \"stddev_ns\": " << r.stddevNs << " }";
+    }
+    m_stream << "\n  ]\n}\n";
+    m_stream.flush();
+}
+
+CATCH_REGISTER_REPORTER("perfjson", JsonBenchmarkReporter)
@@ -0,0 +1,45 @@
+#ifndef JSONBENCHMARKREPORTER_H
+#define JSONBENCHMARKREPORTER_H
+
+#include <catch2/reporters/catch_reporter_streaming_base.hpp>
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Catch2 reporter writing benchmark results as one JSON document.
+ *
+ * @details Catch2 3.4 has no JSON reporter, and the XML one mixes benchmarks with assertions. This reporter keeps only the
+ * benchmarks: one entry per BENCHMARK with its name, sample count, iterations per sample and the mean, its confidence
+ * bounds and the standard deviation in nanoseconds. Select it with `--reporter perfjson::out=results.json`; it can be
+ * combined with the console reporter.
+ */
+class JsonBenchmarkReporter : public Catch::StreamingReporterBase {
+public:
+    /** @brief Constructs the reporter for a Catch2 run. */
+    explicit JsonBenchmarkReporter(Catch::ReporterConfig&& config);
+
+    /** @brief Returns the description shown by `--list-reporters`. */
+    static std::string getDescription();
+
+    /** @brief Collects the statistics of one finished benchmark. */
+    void benchmarkEnded(Catch::BenchmarkStats<> const& stats) override;
+
+    /** @brief Writes the collected benchmarks. */
+    void testRunEnded(Catch::TestRunStats const& stats) override;
+
+private:
+    struct Result {
+        std::string name;           ///< Benchmark name.
+        unsigned samples = 0;       ///< Number of samples taken.
+        int iterations = 0;         ///< Iterations per sample.
+        double meanNs = 0.0;        ///< Mean time per iteration.
+        double lowerNs = 0.0;       ///< Lower bound of the mean's confidence interval.
+        double upperNs = 0.0;       ///< Upper bound of the mean's confidence interval.
+        double stddevNs = 0.0;      ///< Standard deviation per iteration.
+    };
+
+    std::vector<Result> m_results;  ///< Benchmarks in the order they finished.
+};
+
+#endif // JSONBENCHMARKREPORTER_H
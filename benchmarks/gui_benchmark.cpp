@@ -0,0 +1,343 @@
+/**
+ * @file gui_benchmark.cpp
+ * @brief Headless latency benchmark of MainWindow.
+ *
+ * @details Generates (or reuses) voter databases of the requested sizes, opens a MainWindow on a working copy of each under the
+ * offscreen platform plugin, and drives it with a fixed script: add, edit and delete voters, edit a party, and search. Every
+ * operation is timed from the call until the posted events it caused (model resets, coalesced chart redraws, repaints) have been
+ * processed. Chart render time is measured separately by refreshing and grabbing PartyChartWidget and VoterIdeologyChartWidget.
+ *
+ * Results, together with the InteractionProfiler breakdown of model reloads, chart updates and frame times and the
+ * MetricsRegistry counters (SQL statements, model resets, signal emissions, chart rebuilds), are written as JSON:
+ *
+ * @code
+ * GuiBenchmarks --sizes 10000,100000,1000000 --output gui-benchmark.json
+ * @endcode
+ */
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLineEdit>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QTimer>
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+
+#include "MainWindow.h"
+#include "models/IdeologyModel.h"
+#include "models/PartyModel.h"
+#include "models/VoterModel.h"
+#include "search/VoterSearch.h"
+#include "simulation/EventLog.h"
+#include "widgets/PartyChartWidget.h"
+#include "widgets/VoterIdeologyChartWidget.h"
+#include "diagnostics/InteractionProfiler.h"
+#include "diagnostics/MeteredQuery.h"
+#include "diagnostics/MetricsRegistry.h"
+
+namespace {
+
+bool g_verbose = false;     ///< Forward debug output of the application.
+
+void messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message) {
+    // The models log every change; at a million voters that would dominate the measurements
+    if (type == QtDebugMsg && !g_verbose) return;
+    fprintf(stderr, "%s\n", qPrintable(qFormatLogMessage(type, context, message)));
+}
+
+/** @brief Processes posted events until the queue stays empty, i.e. every queued redraw and repaint has run. */
+void drainEvents() {
+    for (int pass = 0; pass < 3; ++pass) {
+        QCoreApplication::sendPostedEvents();
+        QCoreApplication::processEvents(QEventLoop::AllEvents);
+    }
+}
+
+/**
+ * @brief Runs @p operation, waits for the UI to settle and records the elapsed time as "benchmark/<name>".
+ *
+ * The SQL statements the operation issued are observed in the "benchmark.<name>.sql_statements" histogram.
+ */
+template <typename Operation>
+void measure(const QString& name, Operation operation) {
+    MetricsRegistry& metrics = MetricsRegistry::instance();
+    const qint64 statementsBefore = metrics.counter("sql.statements");
+
+    QElapsedTimer timer;
+    timer.start();
+    operation();
+    drainEvents();
+    InteractionProfiler::instance().record("benchmark/" + name, timer.nsecsElapsed() / 1e6);
+    metrics.observe("benchmark." + name + ".sql_statements", metrics.counter("sql.statements") - statementsBefore);
+}
+
+/**
+ * @brief Writes a database with @p voterCount voters scattered around the default parties.
+ * @return True on success.
+ */
+bool generateDatabase(const QString& path, int voterCount) {
+    const QString connection = "benchmark_generator";
+    bool ok = true;
+    {
+        PartyModel partyModel(connection, nullptr, true, path);
+        VoterModel voterModel(connection, nullptr, path);
+        IdeologyModel ideologyModel(connection);
+        partyModel.reloadData();
+        voterModel.setPartyModel(&partyModel);
+
+        const QVector<Party>& parties = partyModel.getAllParties();
+        if (parties.isEmpty()) {
+            qWarning() << "[GuiBenchmark] No parties in" << path;
+            return false;
+        }
+
+        QSqlDatabase db = QSqlDatabase::database(connection);
+        db.transaction();
+        QSqlQuery insert(db);
+        insert.prepare("INSERT INTO voters (name, ideologyId, ideology_x, ideology_y, party_id) VALUES (?, ?, ?, ?, ?)");
+
+        static const char* firstNames[] = { "Anna", "Ben", "Clara", "David", "Eva", "Felix", "Greta", "Hugo", "Ida", "Jonas" };
+        static const char* lastNames[] = { "Adler", "Brandt", "Castell", "Dorn", "Engel", "Falk", "Graf", "Hahn", "Iser", "Jung" };
+
+        // Fixed seed so every run benchmarks the same population
+        std::mt19937 rng(20240601u);
+        std::normal_distribution<double> spread(0.0, 25.0);
+        std::uniform_int_distribution<int> pickParty(0, parties.size() - 1);
+        for (int i = 0; i < voterCount && ok; ++i) {
+            const Party& centre = parties[pickParty(rng)];
+            const int x = std::clamp(static_cast<int>(centre.ideologyX + spread(rng)), -100, 100);
+            const int y = std::clamp(static_cast<int>(centre.ideologyY + spread(rng)), -100, 100);
+            const int partyId = voterModel.findClosestPartyId(x, y);
+
+            insert.addBindValue(QString("%1 %2 %3").arg(QLatin1String(firstNames[i % 10]), QLatin1String(lastNames[(i / 10) % 10])).arg(i));
+            insert.addBindValue(ideologyModel.findClosestIdeologyId(x, y));
+            insert.addBindValue(x);
+            insert.addBindValue(y);
+            insert.addBindValue(partyId != -1 ? QVariant(partyId) : QVariant());
+            if (!insert.exec()) {
+                qWarning() << "[GuiBenchmark] Insert failed:" << insert.lastError().text();
+                ok = false;
+            }
+        }
+        ok = db.commit() && ok;
+    }
+    QSqlDatabase::removeDatabase(connection);
+    return ok;
+}
+
+/** @brief Options of one benchmark run. */
+struct BenchmarkOptions {
+    int voterOps = 20;          ///< Iterations of each voter operation and of the search.
+    int partyOps = 2;           ///< Iterations of the party edit (reassigns every voter).
+    int renderOps = 10;         ///< Chart renders per chart.
+};
+
+/** @brief Drives one MainWindow on @p dbPath and returns its results. */
+QJsonObject runBenchmark(const QString& dbPath, int voterCount, const BenchmarkOptions& options) {
+    InteractionProfiler& profiler = InteractionProfiler::instance();
+    profiler.clear();
+    profiler.setEnabled(true);
+    MetricsRegistry::instance().reset();
+    MeteredQuery::setEnabled(true);
+    QFile::remove(EventLog::pathForDatabase(dbPath));
+
+    QElapsedTimer startup;
+    startup.start();
+    auto* window = new MainWindow(nullptr, dbPath);
+    window->resize(1600, 1000);
+    window->show();
+    drainEvents();
+    const double startupMs = startup.nsecsElapsed() / 1e6;
+
+    auto* voterModel = window->findChild<VoterModel*>();
+    auto* partyModel = window->findChild<PartyModel*>();
+    auto* ideologyModel = window->findChild<IdeologyModel*>();
+    auto* search = window->findChild<VoterSearch*>();
+    auto* searchEdit = window->findChild<QLineEdit*>("voterSearchEdit");
+    auto* partyChart = window->findChild<PartyChartWidget*>();
+    auto* voterChart = window->findChild<VoterIdeologyChartWidget*>();
+    if (!voterModel || !partyModel || !ideologyModel || !search || !searchEdit || !partyChart || !voterChart) {
+        qWarning() << "[GuiBenchmark] MainWindow is missing an expected child";
+        delete window;
+        return {};
+    }
+
+    std::mt19937 rng(7u);
+    std::uniform_int_distribution<int> coordinate(-100, 100);
+    auto randomVoter = [&]() {
+        std::uniform_int_distribution<int> row(0, voterModel->rowCount() - 1);
+        return voterModel->getVoterAt(row(rng));
+    };
+
+    for (int i = 0; i < options.voterOps; ++i) {
+        measure("add_voter", [&]() {
+            Voter v;
+            v.name = QString("Benchmark Voter %1").arg(i);
+            v.ideologyX = coordinate(rng);
+            v.ideologyY = coordinate(rng);
+            v.ideologyId = ideologyModel->findClosestIdeologyId(v.ideologyX, v.ideologyY);
+            v.partyId = voterModel->findClosestPartyId(v.ideologyX, v.ideologyY);
+            voterModel->addVoter(v);
+        });
+    }
+
+    for (int i = 0; i < options.voterOps; ++i) {
+        Voter v = randomVoter();
+        measure("edit_voter", [&]() {
+            v.ideologyX = coordinate(rng);
+            v.ideologyY = coordinate(rng);
+            v.ideologyId = ideologyModel->findClosestIdeologyId(v.ideologyX, v.ideologyY);
+            v.partyId = voterModel->findClosestPartyId(v.ideologyX, v.ideologyY);
+            voterModel->updateVoter(v.id, v);
+        });
+    }
+
+    for (int i = 0; i < options.voterOps; ++i) {
+        const int id = randomVoter().id;
+        measure("delete_voter", [&]() { voterModel->deleteVoterById(id); });
+    }
+
+    for (int i = 0; i < options.partyOps && partyModel->rowCount() > 0; ++i) {
+        const int row = i % partyModel->rowCount();
+        Party party = partyModel->getPartyAt(row);
+        const int id = partyModel->getPartyIdAt(row);
+        measure("edit_party", [&]() {
+            party.ideologyX = std::clamp(party.ideologyX + (i % 2 ? -5 : 5), -100, 100);
+            partyModel->updateParty(id, party);
+        });
+    }
+
+    // Search without the typing debounce: the time until the filtered table has been repainted
+    search->setDebounceInterval(0);
+    const QStringList queries = { "anna", "brandt", "ida jung", "12", "zzz" };
+    for (int i = 0; i < options.voterOps; ++i) {
+        const QString query = queries[i % queries.size()];
+        measure("search", [&]() {
+            QEventLoop loop;
+            QTimer timeout;
+            timeout.setSingleShot(true);
+            QObject::connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
+            QObject::connect(search, &VoterSearch::resultsReady, &loop, &QEventLoop::quit);
+            timeout.start(30000);
+            searchEdit->setText(query);
+            loop.exec();
+        });
+        measure("clear_search", [&]() { searchEdit->clear(); });
+    }
+
+    for (int i = 0; i < options.renderOps; ++i) {
+        measure("render/PartyChartWidget", [&]() {
+            partyChart->onDataChanged();
+            partyChart->grab();
+        });
+        measure("render/VoterIdeologyChartWidget", [&]() {
+            voterChart->updateChart();
+            voterChart->grab();
+        });
+    }
+
+    QJsonObject result;
+    result.insert("voters", voterCount);
+    result.insert("startup_ms", startupMs);
+    result.insert("series", profiler.toJson());
+    result.insert("metrics", MetricsRegistry::instance().toJson());
+
+    delete window;
+    drainEvents();
+    profiler.setEnabled(false);
+    MeteredQuery::setEnabled(false);
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+    QCoreApplication::setApplicationName("GuiBenchmarks");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless latency benchmark of the PoliticalSim main window.");
+    parser.addHelpOption();
+    QCommandLineOption sizesOption("sizes", "Comma-separated voter counts.", "list", "10000,100000,1000000");
+    QCommandLineOption dataOption("data-dir", "Directory holding the generated databases.", "dir",
+                                  QDir::temp().filePath("politicalsim-benchmark"));
+    QCommandLineOption outputOption("output", "JSON results file.", "file", "gui-benchmark.json");
+    QCommandLineOption voterOpsOption("voter-ops", "Iterations of each voter operation.", "n", "20");
+    QCommandLineOption partyOpsOption("party-ops", "Iterations of the party edit.", "n", "2");
+    QCommandLineOption verboseOption("verbose", "Show the application's debug output.");
+    parser.addOptions({ sizesOption, dataOption, outputOption, voterOpsOption, partyOpsOption, verboseOption });
+    parser.process(app);
+
+    g_verbose = parser.isSet(verboseOption);
+    qInstallMessageHandler(messageHandler);
+
+    BenchmarkOptions options;
+    options.voterOps = std::max(1, parser.value(voterOpsOption).toInt());
+    options.partyOps = std::max(0, parser.value(partyOpsOption).toInt());
+
+    const QString outputPath = QFileInfo(parser.value(outputOption)).absoluteFilePath();
+    QDir dataDir(parser.value(dataOption));
+    if (!dataDir.mkpath(".")) {
+        qWarning() << "[GuiBenchmark] Cannot create" << dataDir.path();
+        return 1;
+    }
+
+    QJsonArray runs;
+    for (const QString& size : parser.value(sizesOption).split(',', Qt::SkipEmptyParts)) {
+        const int voterCount = size.trimmed().toInt();
+        if (voterCount <= 0) continue;
+
+        // Generated databases are kept and reused; each run works on a fresh copy
+        const QString fixture = dataDir.filePath(QString("voters-%1.sqlite").arg(voterCount));
+        if (!QFile::exists(fixture)) {
+            qInfo() << "[GuiBenchmark] Generating" << voterCount << "voters into" << fixture;
+            if (!generateDatabase(fixture, voterCount)) {
+                QFile::remove(fixture);
+                return 1;
+            }
+        }
+        const QString working = dataDir.filePath(QString("run-%1.sqlite").arg(voterCount));
+        QFile::remove(working);
+        if (!QFile::copy(fixture, working)) {
+            qWarning() << "[GuiBenchmark] Cannot copy" << fixture;
+            return 1;
+        }
+
+        qInfo() << "[GuiBenchmark] Running with" << voterCount << "voters";
+        const QJsonObject run = runBenchmark(working, voterCount, options);
+        if (run.isEmpty()) return 1;
+        runs.append(run);
+        QFile::remove(working);
+    }
+
+    QJsonObject root;
+    root.insert("benchmark", "gui");
+    root.insert("platform", QGuiApplication::platformName());
+    root.insert("timestamp", QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    root.insert("runs", runs);
+
+    QFile output(outputPath);
+    if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "[GuiBenchmark] Cannot write" << outputPath << ":" << output.errorString();
+        return 1;
+    }
+    output.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    qInfo() << "[GuiBenchmark] Results written to" << outputPath;
+    return 0;
+}
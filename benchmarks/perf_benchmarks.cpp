@@ -0,0 +1,278 @@
+/**
+ * @file perf_benchmarks.cpp
+ * @brief Microbenchmarks of the model layer at realistic sizes.
+ *
+ * @details Every combination of 1k, 100k and 1M voters with 5, 50 and 500 parties gets a temporary database, generated once
+ * and removed by ScopedFileRemover when the combination is done. Each model path is then measured with Catch2 BENCHMARK.
+ * Benchmark names carry the sizes, e.g. "VoterModel::reloadData [voters=100000 parties=50]", so results of two commits can
+ * be matched by name:
+ *
+ * @code
+ * PerfBenchmarks --reporter console --reporter perfjson::out=perf.json
+ * @endcode
+ *
+ * The nearest-point search is also measured on its own, on 2, 4, 8 and 16 axes, as the packed DistanceKernels and as the
+ * scalar per-candidate scan they replaced.
+ *
+ * Runs take 10 samples unless --benchmark-samples says otherwise.
+ */
+
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QDebug>
+
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "models/IdeologyModel.h"
+#include "models/PartyModel.h"
+#include "models/VoterModel.h"
+#include "simulation/DistanceKernels.h"
+#include "utilities/ScopedFileRemover.h"
+
+namespace {
+
+/** @brief Voters and parties scattered over the compass, generated into a temporary database and loaded into the models. */
+struct BenchmarkDatabase {
+    BenchmarkDatabase(int voterCount, int partyCount)
+        : path(QString("perf_%1_%2.sqlite").arg(voterCount).arg(partyCount)),
+          remover(path),
+          connection(QString("perf_%1_%2").arg(voterCount).arg(partyCount))
+    {
+        QFile::remove(path);
+        partyModel = new PartyModel(connection, nullptr, false, path);
+        voterModel = new VoterModel(connection, nullptr, path);
+        ideologyModel = new IdeologyModel(connection);
+
+        QSqlDatabase db = QSqlDatabase::database(connection);
+        db.transaction();
+
+        // Fixed seed so every run measures the same data
+        std::mt19937 rng(1234u);
+        std::uniform_int_distribution<int> coordinate(-100, 100);
+        QSqlQuery insertParty(db);
+        insertParty.prepare("INSERT INTO parties (name, ideology_id, ideology_x, ideology_y) VALUES (?, ?, ?, ?)");
+        QVector<Party> parties;
+        for (int i = 0; i < partyCount; ++i) {
+            Party p;
+            p.ideologyX = coordinate(rng);
+            p.ideologyY = coordinate(rng);
+            insertParty.addBindValue(QString("Party %1").arg(i));
+            insertParty.addBindValue(ideologyModel->findClosestIdeologyId(p.ideologyX, p.ideologyY));
+            insertParty.addBindValue(p.ideologyX);
+            insertParty.addBindValue(p.ideologyY);
+            if (!insertParty.exec()) qWarning() << "[PerfBenchmarks] Party insert failed:" << insertParty.lastError().text();
+            p.id = insertParty.lastInsertId().toInt();
+            parties.append(p);
+        }
+
+        QSqlQuery insertVoter(db);
+        insertVoter.prepare("INSERT INTO voters (name, ideologyId, ideology_x, ideology_y, party_id) VALUES (?, ?, ?, ?, ?)");
+        for (int i = 0; i < voterCount; ++i) {
+            const int x = coordinate(rng);
+            const int y = coordinate(rng);
+            int partyId = -1, best = std::numeric_limits<int>::max();
+            for (const Party& p : parties) {
+                const int d2 = (p.ideologyX - x) * (p.ideologyX - x) + (p.ideologyY - y) * (p.ideologyY - y);
+                if (d2 < best) {
+                    best = d2;
+                    partyId = p.id;
+                }
+            }
+            insertVoter.addBindValue(QString("Voter %1").arg(i));
+            insertVoter.addBindValue(ideologyModel->findClosestIdeologyId(x, y));
+            insertVoter.addBindValue(x);
+            insertVoter.addBindValue(y);
+            insertVoter.addBindValue(partyId);
+            if (!insertVoter.exec()) qWarning() << "[PerfBenchmarks] Voter insert failed:" << insertVoter.lastError().text();
+        }
+        db.commit();
+
+        partyModel->setIdeologyModel(ideologyModel);
+        voterModel->setIdeologyModel(ideologyModel);
+        partyModel->reloadData();
+        voterModel->setPartyModel(partyModel);
+        partyModel->setVoterModel(voterModel);
+        voterModel->reloadData();
+    }
+
+    ~BenchmarkDatabase() {
+        delete voterModel;
+        delete partyModel;
+        delete ideologyModel;
+        {
+            QSqlDatabase db = QSqlDatabase::database(connection, false);
+            if (db.isValid()) db.close();
+        }
+        QSqlDatabase::removeDatabase(connection);
+    }
+
+    QString path;                           ///< Database file.
+    ScopedFileRemover remover;              ///< Removes the file when the combination is done.
+    QString connection;                     ///< Connection name shared by the models.
+    PartyModel* partyModel = nullptr;       ///< Parties, linked to voterModel.
+    VoterModel* voterModel = nullptr;       ///< Voters, linked to partyModel.
+    IdeologyModel* ideologyModel = nullptr; ///< Ideology lookup.
+};
+
+std::string benchmarkName(const char* path, int voterCount, int partyCount) {
+    return QString("%1 [voters=%2 parties=%3]").arg(path).arg(voterCount).arg(partyCount).toStdString();
+}
+
+void messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message) {
+    // The models log every change; keep the benchmark output readable and the timings free of console I/O
+    if (type == QtDebugMsg) return;
+    fprintf(stderr, "%s\n", qPrintable(qFormatLogMessage(type, context, message)));
+}
+
+} // namespace
+
+TEST_CASE("Model layer at scale", "[benchmark]") {
+    const int voterCount = GENERATE(1000, 100000, 1000000);
+    const int partyCount = GENERATE(5, 50, 500);
+
+    BenchmarkDatabase data(voterCount, partyCount);
+    VoterModel& voters = *data.voterModel;
+    PartyModel& parties = *data.partyModel;
+    REQUIRE(voters.rowCount() == voterCount);
+    REQUIRE(parties.rowCount() == partyCount);
+
+    BENCHMARK(benchmarkName("VoterModel::reloadData", voterCount, partyCount)) {
+        voters.reloadData();
+        return voters.rowCount();
+    };
+
+    voters.setLazyNames(true);
+    BENCHMARK(benchmarkName("VoterModel::reloadData (lazy names)", voterCount, partyCount)) {
+        voters.reloadData();
+        return voters.rowCount();
+    };
+    voters.setLazyNames(false);
+
+    BENCHMARK(benchmarkName("VoterModel::countVotersPerParty", voterCount, partyCount)) {
+        return voters.countVotersPerParty();
+    };
+
+    BENCHMARK(benchmarkName("PartyModel::calculatePopularity (all parties)", voterCount, partyCount)) {
+        double sum = 0.0;
+        for (const Party& p : parties.getAllParties())
+            sum += parties.calculatePopularity(p.id);
+        return sum;
+    };
+
+    BENCHMARK(benchmarkName("VoterModel::ensureVotersPopulated (populated)", voterCount, partyCount)) {
+        QSqlDatabase db = QSqlDatabase::database(data.connection);
+        return voters.ensureVotersPopulated(db, {});
+    };
+
+    BENCHMARK(benchmarkName("VoterModel::reassignAllVoterParties", voterCount, partyCount)) {
+        voters.reassignAllVoterParties();
+        return voters.rowCount();
+    };
+}
+
+TEST_CASE("Seeding an empty voter table", "[benchmark]") {
+    const int partyCount = GENERATE(5, 50, 500);
+    BenchmarkDatabase data(0, partyCount);
+
+    QMap<QString, int> partyMap;
+    for (const Party& p : data.partyModel->getAllParties())
+        partyMap.insert(p.name, p.id);
+
+    BENCHMARK_ADVANCED(benchmarkName("VoterModel::ensureVotersPopulated (empty)", 0, partyCount))(Catch::Benchmark::Chronometer meter) {
+        QSqlDatabase db = QSqlDatabase::database(data.connection);
+        QSqlQuery clear(db);
+        meter.measure([&]() {
+            // Every iteration must find the table empty; the DELETE is part of the measured time
+            clear.exec("DELETE FROM voters");
+            return data.voterModel->ensureVotersPopulated(db, partyMap);
+        });
+    };
+}
+
+TEST_CASE("Closest ideology lookup", "[benchmark]") {
+    BenchmarkDatabase data(0, 5);
+    const IdeologyModel& ideologies = *data.ideologyModel;
+
+    BENCHMARK("IdeologyModel::findClosestIdeologyId (whole compass)") {
+        long sum = 0;
+        for (int y = -100; y <= 100; ++y) {
+            for (int x = -100; x <= 100; ++x)
+                sum += ideologies.findClosestIdeologyId(x, y);
+        }
+        return sum;
+    };
+}
+
+TEST_CASE("Nearest point search on N axes", "[benchmark]") {
+    const int axes = GENERATE(2, 4, 8, 16);
+    const int candidateCount = GENERATE(5, 50, 500);
+    constexpr int kQueries = 10000;
+
+    // Same points in both layouts: packed columns for the kernel, one row of ints per candidate for the scalar scan
+    std::mt19937 rng(1234u);
+    std::uniform_int_distribution<int> coordinate(-100, 100);
+    IdeologyPoints packed(axes);
+    std::vector<int> rows(static_cast<size_t>(candidateCount) * axes);
+    for (int i = 0; i < candidateCount; ++i) {
+        for (int a = 0; a < axes; ++a)
+            rows[static_cast<size_t>(i) * axes + a] = coordinate(rng);
+        packed.append(&rows[static_cast<size_t>(i) * axes]);
+    }
+    std::vector<int> queries(static_cast<size_t>(kQueries) * axes);
+    for (int& c : queries) c = coordinate(rng);
+
+    const auto name = [&](const char* path) {
+        return QString("%1 [axes=%2 candidates=%3 queries=%4]").arg(path).arg(axes).arg(candidateCount).arg(kQueries).toStdString();
+    };
+
+    BENCHMARK(name("DistanceKernels::nearest")) {
+        long sum = 0;
+        for (int q = 0; q < kQueries; ++q)
+            sum += DistanceKernels::nearest(packed, &queries[static_cast<size_t>(q) * axes], axes).index;
+        return sum;
+    };
+
+    // The linear scan the models used before the packed kernels
+    BENCHMARK(name("Scalar nearest scan")) {
+        long sum = 0;
+        for (int q = 0; q < kQueries; ++q) {
+            const int* point = &queries[static_cast<size_t>(q) * axes];
+            int nearest = -1, best = std::numeric_limits<int>::max();
+            for (int i = 0; i < candidateCount; ++i) {
+                const int* candidate = &rows[static_cast<size_t>(i) * axes];
+                int distance = 0;
+                for (int a = 0; a < axes; ++a)
+                    distance += (candidate[a] - point[a]) * (candidate[a] - point[a]);
+                if (distance < best) {
+                    best = distance;
+                    nearest = i;
+                }
+            }
+            sum += nearest;
+        }
+        return sum;
+    };
+}
+
+int main(int argc, char* argv[]) {
+    qInstallMessageHandler(messageHandler);
+    Catch::Session session;
+
+    // Large combinations take seconds per iteration; keep the default run short
+    session.configData().benchmarkSamples = 10;
+    session.configData().benchmarkResamples = 1000;
+
+    const int status = session.applyCommandLine(argc, argv);
+    if (status != 0) return status;
+    return session.run();
+}
@@ -0,0 +1,190 @@
+#include "InteractionProfiler.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QEvent>
+#include <QFile>
+#include <QJsonDocument>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Nearest-rank percentile of sorted samples
+double percentile(const QVector<double>& sorted, double fraction) {
+    if (sorted.isEmpty()) return 0.0;
+    const int rank = static_cast<int>(std::ceil(fraction * sorted.size()));
+    return sorted[std::clamp(rank - 1, 0, static_cast<int>(sorted.size()) - 1)];
+}
+
+} // namespace
+
+InteractionProfiler& InteractionProfiler::instance() {
+    static InteractionProfiler profiler;
+    return profiler;
+}
+
+InteractionProfiler::InteractionProfiler(QObject* parent)
+    : QObject(parent)
+{
+    m_settle.setSingleShot(true);
+    m_settle.setInterval(kSettleMs);
+    connect(&m_settle, &QTimer::timeout, this, &InteractionProfiler::finishAction);
+}
+
+void InteractionProfiler::setEnabled(bool enabled) {
+    if (m_enabled == enabled) return;
+    if (!enabled && !m_action.isEmpty()) {
+        m_settle.stop();
+        finishAction();
+    }
+    m_enabled = enabled;
+    qDebug() << "[InteractionProfiler] Profiling" << (enabled ? "enabled" : "disabled");
+}
+
+bool InteractionProfiler::isEnabled() const {
+    return m_enabled;
+}
+
+void InteractionProfiler::record(const QString& series, double milliseconds) {
+    if (!m_enabled) return;
+
+    Samples& samples = m_series[series];
+    if (samples.values.size() < kMaxSamples) {
+        samples.values.append(milliseconds);
+    } else {
+        samples.values[samples.next] = milliseconds;
+        samples.next = (samples.next + 1) % kMaxSamples;
+    }
+
+    if (m_action.isEmpty()) return;
+    if (series.startsWith(QLatin1String("model/"))) m_actionModelMs += milliseconds;
+    else if (series.startsWith(QLatin1String("chart/"))) m_actionChartMs += milliseconds;
+    else if (series.startsWith(QLatin1String("frame/"))) m_actionFrameMs += milliseconds;
+    else return;
+    touchAction();
+}
+
+void InteractionProfiler::beginAction(const QString& name) {
+    if (!m_enabled) return;
+    if (!m_action.isEmpty()) {
+        m_settle.stop();
+        finishAction();
+    }
+
+    m_action = name;
+    m_actionModelMs = m_actionChartMs = m_actionFrameMs = 0.0;
+    m_actionLastNs = 0;
+    m_actionTimer.start();
+    m_settle.start();
+}
+
+void InteractionProfiler::watchFrames(QObject* target, const QString& name) {
+    if (!target) return;
+    if (!m_watched.contains(target)) {
+        target->installEventFilter(this);
+        connect(target, &QObject::destroyed, this, [this](QObject* object) { m_watched.remove(object); });
+    }
+    m_watched.insert(target, QStringLiteral("frame/") + name);
+}
+
+LatencySummary InteractionProfiler::summary(const QString& series) const {
+    LatencySummary result;
+    auto found = m_series.constFind(series);
+    if (found == m_series.cend() || found->values.isEmpty()) return result;
+
+    QVector<double> sorted = found->values;
+    std::sort(sorted.begin(), sorted.end());
+    result.count = sorted.size();
+    result.p50 = percentile(sorted, 0.50);
+    result.p95 = percentile(sorted, 0.95);
+    result.p99 = percentile(sorted, 0.99);
+    result.max = sorted.last();
+    return result;
+}
+
+QStringList InteractionProfiler::seriesNames() const {
+    QStringList names;
+    for (auto it = m_series.cbegin(); it != m_series.cend(); ++it) {
+        if (!it->values.isEmpty()) names.append(it.key());
+    }
+    names.sort();
+    return names;
+}
+
+QJsonObject InteractionProfiler::toJson() const {
+    QJsonObject root;
+    for (const QString& name : seriesNames()) {
+        const LatencySummary s = summary(name);
+        QJsonObject entry;
+        entry.insert("count", s.count);
+        entry.insert("p50_ms", s.p50);
+        entry.insert("p95_ms", s.p95);
+        entry.insert("p99_ms", s.p99);
+        entry.insert("max_ms", s.max);
+        root.insert(name, entry);
+    }
+    return root;
+}
+
+bool InteractionProfiler::exportJson(const QString& path) const {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "[InteractionProfiler] Cannot write" << path << ":" << file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(toJson()).toJson(QJsonDocument::Indented));
+    qDebug() << "[InteractionProfiler] Exported" << m_series.size() << "series to" << path;
+    return true;
+}
+
+void InteractionProfiler::clear() {
+    m_series.clear();
+}
+
+bool InteractionProfiler::eventFilter(QObject* watched, QEvent* event) {
+    if (event->type() != QEvent::Paint || !m_enabled || m_inPaint) return QObject::eventFilter(watched, event);
+    auto found = m_watched.constFind(watched);
+    if (found == m_watched.cend()) return QObject::eventFilter(watched, event);
+
+    // Deliver the paint ourselves so its full cost lands inside the measurement
+    const QString series = *found;
+    QElapsedTimer timer;
+    timer.start();
+    m_inPaint = true;
+    QCoreApplication::sendEvent(watched, event);
+    m_inPaint = false;
+    record(series, timer.nsecsElapsed() / 1e6);
+    return true;
+}
+
+void InteractionProfiler::touchAction() {
+    if (m_action.isEmpty()) return;
+    m_actionLastNs = m_actionTimer.nsecsElapsed();
+    m_settle.start();
+}
+
+void InteractionProfiler::finishAction() {
+    if (m_action.isEmpty()) return;
+
+    const QString action = m_action;
+    const double milliseconds = m_actionLastNs / 1e6;
+    m_action.clear();
+    record(QStringLiteral("action/") + action, milliseconds);
+
+    qDebug().nospace() << "[InteractionProfiler] " << action << ": " << milliseconds << " ms (models "
+                       << m_actionModelMs << " ms, charts " << m_actionChartMs << " ms, paint "
+                       << m_actionFrameMs << " ms)";
+    emit actionCompleted(action, milliseconds);
+}
+
+ProfileScope::ProfileScope(const char* series)
+    : m_series(InteractionProfiler::instance().isEnabled() ? series : nullptr)
+{
+    if (m_series) m_timer.start();
+}
+
+ProfileScope::~ProfileScope() {
+    if (m_series) InteractionProfiler::instance().record(QString::fromLatin1(m_series), m_timer.nsecsElapsed() / 1e6);
+}
@@ -0,0 +1,150 @@
+#ifndef INTERACTIONPROFILER_H
+#define INTERACTIONPROFILER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+
+/**
+ * @brief Percentile summary of one timing series, in milliseconds.
+ */
+struct LatencySummary {
+    int count = 0;              ///< Number of samples kept.
+    double p50 = 0.0;           ///< Median.
+    double p95 = 0.0;           ///< 95th percentile.
+    double p99 = 0.0;           ///< 99th percentile.
+    double max = 0.0;           ///< Slowest sample.
+};
+
+/**
+ * @brief Collects UI timings: per-action latency, model reloads, chart updates and view frame times.
+ *
+ * @details Timings are grouped into named series such as "action/Add Voter", "model/VoterModel::reloadData",
+ * "chart/PartyChartWidget::updateChart" or "frame/voterTableView". Each series keeps the latest kMaxSamples samples.
+ *
+ * An action starts with beginAction() in the button handler. Every profiled scope and every frame painted by a watched view
+ * while the action is open pushes its end time forward. Once nothing has happened for kSettleMs the action is closed and its
+ * latency, from the click to the last piece of work or paint, is recorded and logged.
+ *
+ * Profiling is off by default; while disabled, ProfileScope and the paint filter cost one flag check.
+ */
+class InteractionProfiler : public QObject {
+    Q_OBJECT
+
+signals:
+    /**
+     * @brief Emitted when an action has settled.
+     * @param action Name given to beginAction().
+     * @param milliseconds Time from beginAction() to the last work or paint it caused.
+     */
+    void actionCompleted(const QString& action, double milliseconds);
+
+public:
+    static constexpr int kMaxSamples = 4096;    ///< Samples kept per series.
+    static constexpr int kSettleMs = 50;        ///< Quiet time after which an action counts as settled.
+
+    /** @brief Returns the application-wide profiler. */
+    static InteractionProfiler& instance();
+
+    /** @brief Turns collection on or off; samples already taken are kept. */
+    void setEnabled(bool enabled);
+
+    /** @brief Returns true while timings are collected. */
+    bool isEnabled() const;
+
+    /**
+     * @brief Adds one sample to a series.
+     * @param series Series name, e.g. "model/VoterModel::reloadData".
+     * @param milliseconds Measured time.
+     */
+    void record(const QString& series, double milliseconds);
+
+    /**
+     * @brief Starts timing a user action; an action still open is closed first.
+     * @param name Action name, e.g. "Add Voter".
+     */
+    void beginAction(const QString& name);
+
+    /**
+     * @brief Records the paint time of a widget as the "frame/<name>" series.
+     * @param target Widget receiving the paint events (for scroll areas, their viewport).
+     * @param name Series suffix.
+     */
+    void watchFrames(QObject* target, const QString& name);
+
+    /** @brief Returns the percentile summary of a series (all zero if unknown). */
+    LatencySummary summary(const QString& series) const;
+
+    /** @brief Returns the names of every series with samples, sorted. */
+    QStringList seriesNames() const;
+
+    /** @brief Returns every series' summary as a JSON object keyed by series name. */
+    QJsonObject toJson() const;
+
+    /**
+     * @brief Writes toJson() to a file.
+     * @return True on success.
+     */
+    bool exportJson(const QString& path) const;
+
+    /** @brief Drops all samples. */
+    void clear();
+
+protected:
+    /** @brief Times paint events of watched widgets. */
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    explicit InteractionProfiler(QObject* parent = nullptr);
+
+    struct Samples {
+        QVector<double> values;                 ///< Ring buffer of samples.
+        int next = 0;                           ///< Slot the next sample overwrites once the buffer is full.
+    };
+
+    void touchAction();                         ///< Marks now as the latest activity of the open action.
+    void finishAction();                        ///< Records the open action once it has settled.
+
+    bool m_enabled = false;                     ///< True while timings are collected.
+    bool m_inPaint = false;                     ///< Guards against timing the re-sent paint event twice.
+    QHash<QString, Samples> m_series;           ///< Samples per series name.
+    QHash<QObject*, QString> m_watched;         ///< Frame series name per watched widget.
+
+    QString m_action;                           ///< Name of the open action (empty if none).
+    QElapsedTimer m_actionTimer;                ///< Started by beginAction().
+    qint64 m_actionLastNs = 0;                  ///< Latest activity of the open action, relative to its start.
+    double m_actionModelMs = 0.0;               ///< Model time spent during the open action.
+    double m_actionChartMs = 0.0;               ///< Chart time spent during the open action.
+    double m_actionFrameMs = 0.0;               ///< Paint time spent during the open action.
+    QTimer m_settle;                            ///< Fires once the open action has been quiet for kSettleMs.
+};
+
+/**
+ * @brief Records the lifetime of a scope into an InteractionProfiler series.
+ *
+ * @code
+ * ProfileScope scope("model/VoterModel::reloadData");
+ * @endcode
+ */
+class ProfileScope {
+public:
+    /** @brief Starts timing if profiling is enabled. @p series must outlive the scope. */
+    explicit ProfileScope(const char* series);
+
+    /** @brief Records the elapsed time. */
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* m_series;                       ///< Series to record into (nullptr while profiling is off).
+    QElapsedTimer m_timer;                      ///< Started on construction.
+};
+
+#endif // INTERACTIONPROFILER_H
@@ -0,0 +1,128 @@
+#include "MemoryReport.h"
+
+#include <QFile>
+#include <QLocale>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QStringList>
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+
+MemoryReport::MemoryReport()
+    : m_residentBytes(processResidentBytes())
+{
+}
+
+void MemoryReport::add(const QString& name, qint64 bytes, qint64 items) {
+    auto it = m_indexByName.constFind(name);
+    if (it != m_indexByName.constEnd()) {
+        m_entries[*it].bytes += bytes;
+        m_entries[*it].items += items;
+        return;
+    }
+    m_indexByName.insert(name, m_entries.size());
+    m_entries.append({ name, bytes, items });
+}
+
+qint64 MemoryReport::bytes(const QString& name) const {
+    auto it = m_indexByName.constFind(name);
+    if (it != m_indexByName.constEnd()) return m_entries[*it].bytes;
+
+    const QString prefix = name + '.';
+    qint64 sum = 0;
+    for (const Entry& e : m_entries) {
+        if (e.name.startsWith(prefix)) sum += e.bytes;
+    }
+    return sum;
+}
+
+qint64 MemoryReport::totalBytes() const {
+    qint64 sum = 0;
+    for (const Entry& e : m_entries)
+        sum += e.bytes;
+    return sum;
+}
+
+QJsonObject MemoryReport::toJson() const {
+    QJsonObject entries;
+    for (const Entry& e : m_entries)
+        entries.insert(e.name, QJsonObject{ { "bytes", double(e.bytes) }, { "items", double(e.items) } });
+
+    return QJsonObject{
+        { "total_bytes", double(totalBytes()) },
+        { "resident_bytes", double(m_residentBytes) },
+        { "entries", entries },
+    };
+}
+
+QString MemoryReport::toText() const {
+    QVector<Entry> sorted = m_entries;
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Entry& a, const Entry& b) {
+        return a.name.section('.', 0, 0) < b.name.section('.', 0, 0);
+    });
+
+    const QLocale locale = QLocale::c();
+    auto formatted = [&](qint64 bytes) { return locale.formattedDataSize(bytes, 1, QLocale::DataSizeTraditionalFormat); };
+
+    QStringList lines;
+    QString group;
+    for (const Entry& e : sorted) {
+        const QString entryGroup = e.name.section('.', 0, 0);
+        if (entryGroup != group) {
+            group = entryGroup;
+            lines << QString("%1: %2").arg(group, formatted(bytes(group)));
+        }
+        QString line = QString("  %1 %2").arg(e.name.section('.', 1), -32).arg(formatted(e.bytes), 10);
+        if (e.items > 0) line += QString("  (%1 items)").arg(e.items);
+        lines << line;
+    }
+    lines << QString("Total: %1").arg(formatted(totalBytes()));
+    if (m_residentBytes >= 0) lines << QString("Resident: %1").arg(formatted(m_residentBytes));
+    return lines.join('\n');
+}
+
+qint64 MemoryReport::stringBytes(const QString& text) {
+    // Literals and empty strings own no heap buffer
+    if (text.capacity() == 0) return 0;
+    const qint64 payload = kArrayHeaderBytes + (text.capacity() + 1) * qint64(sizeof(QChar));
+    if (text.isDetached()) return payload;
+
+    // Other holders share the buffer; whichever of them is reported first carries it
+    const void* buffer = text.constData();
+    if (m_sharedStrings.contains(buffer)) return 0;
+    m_sharedStrings.insert(buffer);
+    return payload;
+}
+
+qint64 MemoryReport::sqliteCacheBytes(const QSqlDatabase& db) {
+    if (!db.isOpen()) return 0;
+
+    auto pragma = [&db](const char* name) -> qint64 {
+        QSqlQuery query(db);
+        if (!query.exec(QStringLiteral("PRAGMA %1").arg(QLatin1String(name))) || !query.next()) return 0;
+        return query.value(0).toLongLong();
+    };
+
+    const qint64 pageSize = pragma("page_size");
+    const qint64 pageCount = pragma("page_count");
+    const qint64 cacheSize = pragma("cache_size");
+    // A negative cache_size is a limit in KiB rather than in pages
+    const qint64 cachePages = cacheSize < 0 ? (-cacheSize * 1024) / std::max<qint64>(1, pageSize) : cacheSize;
+    return pageSize * std::min(cachePages, pageCount);
+}
+
+qint64 MemoryReport::processResidentBytes() {
+#ifdef Q_OS_LINUX
+    QFile statm("/proc/self/statm");
+    if (!statm.open(QIODevice::ReadOnly)) return -1;
+    const QList<QByteArray> fields = statm.readAll().split(' ');
+    if (fields.size() < 2) return -1;
+    return fields[1].toLongLong() * sysconf(_SC_PAGESIZE);
+#else
+    return -1;
+#endif
+}
@@ -0,0 +1,106 @@
+#ifndef MEMORYREPORT_H
+#define MEMORYREPORT_H
+
+#include <QHash>
+#include <QJsonObject>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+class QSqlDatabase;
+
+/**
+ * @brief Estimated heap bytes held by each subsystem, e.g. the loaded voters, their strings or a chart's point buffer.
+ *
+ * @details Subsystems add their own entries through a reportMemory(MemoryReport&) method, naming them as dotted paths such as
+ * "voters.records" or "charts.voterChart.series". Sizes are estimates from container capacities and element sizes plus the
+ * allocation headers of Qt containers; they do not include allocator overhead beyond that.
+ *
+ * Implicitly shared QString payloads are counted once per report: stringBytes() returns the whole payload for a string that
+ * owns its buffer alone, and for a shared one only the first time the report sees that buffer, so a name shared by every
+ * voter of a party adds up to one payload. Only shared buffers are remembered, by address.
+ *
+ * Reports are cheap to build (one pass over each container) and can be taken on demand or by a MemorySampler.
+ */
+class MemoryReport {
+public:
+    static constexpr qint64 kArrayHeaderBytes = 16;     ///< Header in front of every QArrayData allocation on 64-bit builds.
+
+    /** @brief One line of the report. */
+    struct Entry {
+        QString name;               ///< Dotted name, e.g. "voters.strings".
+        qint64 bytes = 0;           ///< Estimated heap bytes.
+        qint64 items = 0;           ///< Number of elements behind the bytes (0 if not meaningful).
+    };
+
+    /** @brief Creates an empty report and records the current resident set size. */
+    MemoryReport();
+
+    /** @brief Adds an entry, or grows an existing entry of the same name. */
+    void add(const QString& name, qint64 bytes, qint64 items = 0);
+
+    /** @brief Returns all entries, in the order they were first added. */
+    const QVector<Entry>& entries() const { return m_entries; }
+
+    /** @brief Returns the bytes of one entry, or the sum of every entry below a prefix such as "voters" (0 if none). */
+    qint64 bytes(const QString& name) const;
+
+    /** @brief Returns the sum of all entries. */
+    qint64 totalBytes() const;
+
+    /** @brief Returns the resident set size of the process when the report was created (-1 where unsupported). */
+    qint64 residentBytes() const { return m_residentBytes; }
+
+    /** @brief Returns {"total_bytes", "resident_bytes", "entries": {name: {bytes, items}}}. */
+    QJsonObject toJson() const;
+
+    /** @brief Returns a human-readable table, grouped by the first name segment. */
+    QString toText() const;
+
+    /** @brief Returns the heap payload of a string not yet counted by this report (0 for empty strings and literals). */
+    qint64 stringBytes(const QString& text);
+
+    /** @brief Returns the heap bytes of a QVector or QList with the given capacity. */
+    template <typename T>
+    static qint64 vectorBytes(const QVector<T>& vector) {
+        return vector.capacity() > 0 ? kArrayHeaderBytes + vector.capacity() * qint64(sizeof(T)) : 0;
+    }
+
+    /** @brief Returns the heap bytes of a std::vector with the given capacity. */
+    template <typename Vector>
+    static qint64 stdVectorBytes(const Vector& vector) {
+        return qint64(vector.capacity()) * qint64(sizeof(typename Vector::value_type));
+    }
+
+    /** @brief Returns an estimate of the heap bytes of a QHash: one offset byte per bucket plus one node per entry. */
+    template <typename K, typename V>
+    static qint64 hashBytes(const QHash<K, V>& hash) {
+        return hash.capacity() > 0 ? qint64(hash.capacity()) + hash.size() * qint64(sizeof(K) + sizeof(V)) : 0;
+    }
+
+    /** @brief Returns an estimate of the heap bytes of a QSet (see hashBytes). */
+    template <typename T>
+    static qint64 setBytes(const QSet<T>& set) {
+        return set.capacity() > 0 ? qint64(set.capacity()) + set.size() * qint64(sizeof(T)) : 0;
+    }
+
+    /**
+     * @brief Returns the most the SQLite page cache of a connection can hold for its database.
+     *
+     * @details The Qt driver does not expose sqlite3_db_status(), so this is page_size times the smaller of the cache_size
+     * limit and the database's page count: an upper bound that the cache reaches once the database has been read.
+     */
+    static qint64 sqliteCacheBytes(const QSqlDatabase& db);
+
+    /** @brief Returns the resident set size of the process (-1 where unsupported). */
+    static qint64 processResidentBytes();
+
+
+private:
+    QVector<Entry> m_entries;               ///< Entries in insertion order.
+    QHash<QString, int> m_indexByName;      ///< Position of each entry in m_entries.
+    qint64 m_residentBytes = -1;            ///< Resident set size when the report was created.
+    QSet<const void*> m_sharedStrings;      ///< Shared string buffers already counted by stringBytes().
+};
+
+#endif // MEMORYREPORT_H
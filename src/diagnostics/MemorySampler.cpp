@@ -0,0 +1,71 @@
+#include "MemorySampler.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+MemorySampler::MemorySampler(QObject* parent)
+    : QObject(parent)
+{
+    connect(&m_timer, &QTimer::timeout, this, &MemorySampler::takeSample);
+}
+
+void MemorySampler::addSource(std::function<void(MemoryReport&)> source) {
+    m_sources.append(std::move(source));
+}
+
+MemoryReport MemorySampler::collect() const {
+    MemoryReport report;
+    for (const auto& source : m_sources)
+        source(report);
+    return report;
+}
+
+void MemorySampler::start(int intervalMs) {
+    m_timer.start(qMax(1, intervalMs));
+    takeSample();
+    qDebug() << "[MemorySampler] Sampling every" << m_timer.interval() << "ms";
+}
+
+void MemorySampler::stop() {
+    m_timer.stop();
+}
+
+bool MemorySampler::isSampling() const {
+    return m_timer.isActive();
+}
+
+QJsonObject MemorySampler::toJson() const {
+    QJsonArray samples;
+    for (const Sample& s : m_samples) {
+        QJsonObject sample = s.report.toJson();
+        sample.insert("timestamp_ms", double(s.timestampMs));
+        samples.append(sample);
+    }
+    return QJsonObject{
+        { "current", collect().toJson() },
+        { "samples", samples },
+    };
+}
+
+bool MemorySampler::exportJson(const QString& path) const {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "[MemorySampler] Cannot write" << path << ":" << file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(toJson()).toJson());
+    qDebug() << "[MemorySampler] Exported" << m_samples.size() << "samples to" << path;
+    return true;
+}
+
+void MemorySampler::takeSample() {
+    Sample sample;
+    sample.timestampMs = QDateTime::currentMSecsSinceEpoch();
+    sample.report = collect();
+    if (m_samples.size() >= kMaxSamples) m_samples.removeFirst();
+    m_samples.append(sample);
+    emit sampled(sample.report);
+}
@@ -0,0 +1,78 @@
+#ifndef MEMORYSAMPLER_H
+#define MEMORYSAMPLER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+
+#include <functional>
+
+#include "MemoryReport.h"
+
+/**
+ * @brief Builds MemoryReports from registered sources, on demand or periodically.
+ *
+ * @details Each source adds the entries of one subsystem, typically by calling its reportMemory() method. collect() runs
+ * every source into a fresh report. While started, the sampler also collects on a timer and keeps the last kMaxSamples
+ * reports with their time, so growth over a session can be exported with exportJson() and plotted.
+ *
+ * @code
+ * sampler->addSource([=](MemoryReport& r) { voterModel->reportMemory(r); });
+ * sampler->start(10000);
+ * @endcode
+ */
+class MemorySampler : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int kMaxSamples = 1440;        ///< Samples kept; older ones are dropped (four hours at 10 s).
+
+    /** @brief One periodic sample. */
+    struct Sample {
+        qint64 timestampMs = 0;     ///< Milliseconds since the epoch.
+        MemoryReport report;        ///< Report collected at that time.
+    };
+
+    /** @brief Constructs a stopped sampler without sources. */
+    explicit MemorySampler(QObject* parent = nullptr);
+
+    /** @brief Adds a source called by every collect(). */
+    void addSource(std::function<void(MemoryReport&)> source);
+
+    /** @brief Builds a report from every source. */
+    MemoryReport collect() const;
+
+    /** @brief Starts sampling every @p intervalMs milliseconds, taking the first sample immediately. */
+    void start(int intervalMs);
+
+    /** @brief Stops sampling; samples taken so far are kept. */
+    void stop();
+
+    /** @brief Returns true while sampling. */
+    bool isSampling() const;
+
+    /** @brief Returns the samples taken, oldest first. */
+    const QVector<Sample>& samples() const { return m_samples; }
+
+    /** @brief Returns {"current": report, "samples": [{"timestamp_ms", "total_bytes", "resident_bytes", "entries"}]}. */
+    QJsonObject toJson() const;
+
+    /**
+     * @brief Writes toJson() to a file.
+     * @return True on success.
+     */
+    bool exportJson(const QString& path) const;
+
+signals:
+    /** @brief Emitted after every periodic sample. */
+    void sampled(const MemoryReport& report);
+
+private:
+    void takeSample();                      ///< Collects a report and appends it to m_samples.
+
+    QVector<std::function<void(MemoryReport&)>> m_sources;  ///< Subsystems contributing to each report.
+    QVector<Sample> m_samples;              ///< Periodic samples, oldest first.
+    QTimer m_timer;                         ///< Drives periodic sampling.
+};
+
+#endif // MEMORYSAMPLER_H
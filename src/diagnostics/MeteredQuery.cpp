@@ -0,0 +1,68 @@
+#include "MeteredQuery.h"
+#include "MetricsRegistry.h"
+#include "SlowQueryLog.h"
+
+#include <QElapsedTimer>
+
+std::atomic<bool> MeteredQuery::s_enabled{false};
+
+MeteredQuery::MeteredQuery(const QSqlDatabase& db, const char* owner)
+    : QSqlQuery(db), m_db(db), m_owner(owner)
+{
+}
+
+MeteredQuery::~MeteredQuery() {
+    flushRowsRead();
+}
+
+void MeteredQuery::setEnabled(bool enabled) {
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool MeteredQuery::exec() {
+    return metered([this]() { return QSqlQuery::exec(); });
+}
+
+bool MeteredQuery::exec(const QString& query) {
+    return metered([this, &query]() { return QSqlQuery::exec(query); });
+}
+
+bool MeteredQuery::next() {
+    if (!QSqlQuery::next()) return false;
+    if (isEnabled()) ++m_rowsRead;
+    return true;
+}
+
+template <typename Run>
+bool MeteredQuery::metered(Run run) {
+    flushRowsRead();
+
+    QElapsedTimer timer;
+    timer.start();
+    const bool ok = run();
+    const double micros = timer.nsecsElapsed() / 1000.0;
+
+    if (isEnabled()) {
+        const QString prefix = QStringLiteral("sql.") + QLatin1String(m_owner);
+        MetricsRegistry& metrics = MetricsRegistry::instance();
+        metrics.increment(prefix + QStringLiteral(".statements"));
+        metrics.increment(QStringLiteral("sql.statements"));
+        metrics.observe(prefix + QStringLiteral(".statement_us"), micros);
+        if (!ok) {
+            metrics.increment(prefix + QStringLiteral(".errors"));
+        } else if (!isSelect() && numRowsAffected() > 0) {
+            metrics.increment(prefix + QStringLiteral(".rows_written"), numRowsAffected());
+        }
+    }
+
+    SlowQueryLog& slowLog = SlowQueryLog::instance();
+    if (micros / 1000.0 >= slowLog.thresholdMs())
+        slowLog.report(QLatin1String(m_owner), m_db, lastQuery(), boundValues(), micros / 1000.0);
+    return ok;
+}
+
+void MeteredQuery::flushRowsRead() {
+    if (m_rowsRead == 0) return;
+    MetricsRegistry::instance().increment(QStringLiteral("sql.") + QLatin1String(m_owner) + QStringLiteral(".rows_read"), m_rowsRead);
+    m_rowsRead = 0;
+}
@@ -0,0 +1,69 @@
+#ifndef METEREDQUERY_H
+#define METEREDQUERY_H
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+
+#include <atomic>
+
+/**
+ * @brief QSqlQuery that reports its statements to the MetricsRegistry.
+ *
+ * @details A drop-in replacement for a local QSqlQuery: exec() and next() hide the QSqlQuery versions, so code declaring a
+ * MeteredQuery records, under "sql.<owner>.":
+ * - statements: every exec() call, successful or not;
+ * - errors: failed exec() calls;
+ * - statement_us: the time each exec() took, as a histogram;
+ * - rows_written: rows affected by non-SELECT statements;
+ * - rows_read: rows fetched with next(), added up locally and reported when the query is re-executed or destroyed.
+ *
+ * The metrics are off by default: each costs a few string concatenations and the registry lock, which every statement of the
+ * app would pay. setEnabled(true) turns them on, e.g. while the Metrics dock is open. Statements at or above
+ * SlowQueryLog::thresholdMs() are handed to the SlowQueryLog with their bound values either way.
+ *
+ * Calls made through a QSqlQuery reference or pointer bypass the metering.
+ */
+class MeteredQuery : public QSqlQuery {
+public:
+    /**
+     * @brief Constructs a query on a database.
+     * @param db Connection to run on.
+     * @param owner Name the metrics are filed under, e.g. "VoterModel" (must be a string literal).
+     */
+    MeteredQuery(const QSqlDatabase& db, const char* owner);
+
+    /** @brief Reports the rows read since the last exec(). */
+    ~MeteredQuery();
+
+    /** @brief Returns true while statements are recorded in the MetricsRegistry. */
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    /** @brief Starts or stops recording metrics for every MeteredQuery. */
+    static void setEnabled(bool enabled);
+
+    MeteredQuery(const MeteredQuery&) = delete;
+    MeteredQuery& operator=(const MeteredQuery&) = delete;
+
+    /** @brief Executes the prepared statement. */
+    bool exec();
+
+    /** @brief Executes @p query. */
+    bool exec(const QString& query);
+
+    /** @brief Fetches the next row. */
+    bool next();
+
+private:
+    template <typename Run>
+    bool metered(Run run);                  ///< Times one execution and files its metrics.
+    void flushRowsRead();                   ///< Reports and resets m_rowsRead.
+
+    QSqlDatabase m_db;                      ///< Connection, for the slow-query plan.
+    const char* m_owner;                    ///< Metric name segment.
+    qint64 m_rowsRead = 0;                  ///< Rows fetched since the last report.
+
+    static std::atomic<bool> s_enabled;     ///< Metering flag, read once per statement and row.
+};
+
+#endif // METEREDQUERY_H
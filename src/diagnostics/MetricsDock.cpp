@@ -0,0 +1,80 @@
+#include "MetricsDock.h"
+#include "MetricsRegistry.h"
+
+#include <QHeaderView>
+#include <QPushButton>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+MetricsDock::MetricsDock(QWidget* parent)
+    : QDockWidget("Metrics", parent)
+{
+    setObjectName("metricsDock");
+
+    auto* content = new QWidget(this);
+    auto* layout = new QVBoxLayout(content);
+    layout->setContentsMargins(4, 4, 4, 4);
+
+    tree = new QTreeWidget(content);
+    tree->setColumnCount(2);
+    tree->setHeaderLabels({ "Metric", "Value" });
+    tree->header()->setSectionResizeMode(0, QHeaderView::ResizeToContents);
+    layout->addWidget(tree);
+
+    auto* resetButton = new QPushButton("Reset", content);
+    connect(resetButton, &QPushButton::clicked, this, [this]() {
+        MetricsRegistry::instance().reset();
+        refresh();
+    });
+    layout->addWidget(resetButton);
+    setWidget(content);
+
+    m_refresh.setInterval(1000);
+    connect(&m_refresh, &QTimer::timeout, this, &MetricsDock::refresh);
+}
+
+void MetricsDock::refresh() {
+    const MetricsRegistry& metrics = MetricsRegistry::instance();
+
+    // Group rows by the first name segment ("sql", "model", "signal", "chart")
+    QHash<QString, QTreeWidgetItem*> groups;
+    auto groupOf = [&](const QString& name) {
+        const QString key = name.section('.', 0, 0);
+        QTreeWidgetItem*& group = groups[key];
+        if (!group) group = new QTreeWidgetItem(QStringList{ key });
+        return group;
+    };
+
+    QList<QTreeWidgetItem*> items;
+    for (const QString& name : metrics.counterNames())
+        new QTreeWidgetItem(groupOf(name), QStringList{ name.section('.', 1), QString::number(metrics.counter(name)) });
+    for (const QString& name : metrics.histogramNames()) {
+        const HistogramSnapshot h = metrics.histogram(name);
+        const QString value = QString("n=%1 mean=%2 p95<=%3 max=%4")
+                                  .arg(h.count)
+                                  .arg(h.mean(), 0, 'f', 1)
+                                  .arg(h.percentile(0.95), 0, 'f', 0)
+                                  .arg(h.max, 0, 'f', 1);
+        new QTreeWidgetItem(groupOf(name), QStringList{ name.section('.', 1), value });
+    }
+
+    QStringList keys = groups.keys();
+    keys.sort();
+    for (const QString& key : keys)
+        items.append(groups.value(key));
+
+    tree->clear();
+    tree->addTopLevelItems(items);
+    tree->expandAll();
+}
+
+void MetricsDock::showEvent(QShowEvent* event) {
+    QDockWidget::showEvent(event);
+    refresh();
+    m_refresh.start();
+}
+
+void MetricsDock::hideEvent(QHideEvent* event) {
+    m_refresh.stop();
+    QDockWidget::hideEvent(event);
+}
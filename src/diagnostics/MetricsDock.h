@@ -0,0 +1,38 @@
+#ifndef METRICSDOCK_H
+#define METRICSDOCK_H
+
+#include <QDockWidget>
+#include <QTimer>
+
+class QTreeWidget;
+
+/**
+ * @brief Debug dock listing the MetricsRegistry counters and histograms.
+ *
+ * @details Refreshes once a second while visible. "Reset" clears the registry, so the next user action can be measured on
+ * its own, e.g. to see how many SQL statements one voter edit issues.
+ */
+class MetricsDock : public QDockWidget {
+    Q_OBJECT
+
+public:
+    /** @brief Constructs the dock with the metric tree and a reset button. */
+    explicit MetricsDock(QWidget* parent = nullptr);
+
+public slots:
+    /** @brief Rebuilds the metric tree from the registry. */
+    void refresh();
+
+protected:
+    /** @brief Starts refreshing. */
+    void showEvent(QShowEvent* event) override;
+
+    /** @brief Stops refreshing. */
+    void hideEvent(QHideEvent* event) override;
+
+private:
+    QTreeWidget* tree;              ///< Metric name / value rows, grouped by the first name segment.
+    QTimer m_refresh;               ///< Refresh timer, running while visible.
+};
+
+#endif // METRICSDOCK_H
@@ -0,0 +1,104 @@
+#include "MetricsRegistry.h"
+
+#include <QMutexLocker>
+
+#include <algorithm>
+#include <cmath>
+
+double HistogramSnapshot::percentile(double fraction) const {
+    if (count == 0) return 0.0;
+    const qint64 rank = std::max<qint64>(1, static_cast<qint64>(std::ceil(fraction * count)));
+    qint64 seen = 0;
+    for (int i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) return std::min(max, i == 0 ? 1.0 : std::ldexp(1.0, i));
+    }
+    return max;
+}
+
+MetricsRegistry& MetricsRegistry::instance() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+void MetricsRegistry::increment(const QString& name, qint64 delta) {
+    QMutexLocker lock(&m_mutex);
+    m_counters[name] += delta;
+}
+
+void MetricsRegistry::observe(const QString& name, double value) {
+    QMutexLocker lock(&m_mutex);
+    HistogramSnapshot& h = m_histograms[name];
+    if (h.buckets.isEmpty()) {
+        h.buckets.fill(0, kBuckets);
+        h.min = h.max = value;
+    }
+    ++h.count;
+    h.sum += value;
+    h.min = std::min(h.min, value);
+    h.max = std::max(h.max, value);
+    ++h.buckets[bucketOf(value)];
+}
+
+qint64 MetricsRegistry::counter(const QString& name) const {
+    QMutexLocker lock(&m_mutex);
+    return m_counters.value(name, 0);
+}
+
+HistogramSnapshot MetricsRegistry::histogram(const QString& name) const {
+    QMutexLocker lock(&m_mutex);
+    return m_histograms.value(name);
+}
+
+QStringList MetricsRegistry::counterNames() const {
+    QMutexLocker lock(&m_mutex);
+    QStringList names = m_counters.keys();
+    names.sort();
+    return names;
+}
+
+QStringList MetricsRegistry::histogramNames() const {
+    QMutexLocker lock(&m_mutex);
+    QStringList names = m_histograms.keys();
+    names.sort();
+    return names;
+}
+
+void MetricsRegistry::reset() {
+    QMutexLocker lock(&m_mutex);
+    m_counters.clear();
+    m_histograms.clear();
+}
+
+QJsonObject MetricsRegistry::toJson() const {
+    QJsonObject counters;
+    for (const QString& name : counterNames())
+        counters.insert(name, counter(name));
+
+    QJsonObject histograms;
+    for (const QString& name : histogramNames()) {
+        const HistogramSnapshot h = histogram(name);
+        QJsonObject entry;
+        entry.insert("count", h.count);
+        entry.insert("sum", h.sum);
+        entry.insert("min", h.min);
+        entry.insert("max", h.max);
+        entry.insert("mean", h.mean());
+        entry.insert("p50", h.percentile(0.50));
+        entry.insert("p95", h.percentile(0.95));
+        entry.insert("p99", h.percentile(0.99));
+        histograms.insert(name, entry);
+    }
+
+    QJsonObject root;
+    root.insert("counters", counters);
+    root.insert("histograms", histograms);
+    return root;
+}
+
+int MetricsRegistry::bucketOf(double value) {
+    if (!(value >= 1.0)) return 0;
+    int exponent = 0;
+    std::frexp(value, &exponent);       // value = m * 2^exponent with m in [0.5, 1)
+    return std::min(exponent, kBuckets - 1);
+}
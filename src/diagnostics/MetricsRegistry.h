@@ -0,0 +1,89 @@
+#ifndef METRICSREGISTRY_H
+#define METRICSREGISTRY_H
+
+#include <QHash>
+#include <QJsonObject>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * @brief Snapshot of one histogram in a MetricsRegistry.
+ */
+struct HistogramSnapshot {
+    qint64 count = 0;           ///< Number of observations.
+    double sum = 0.0;           ///< Sum of all observations.
+    double min = 0.0;           ///< Smallest observation.
+    double max = 0.0;           ///< Largest observation.
+    QVector<qint64> buckets;    ///< Observations per power-of-two bucket (see MetricsRegistry::bucketOf).
+
+    /** @brief Returns the mean observation (0 if empty). */
+    double mean() const { return count > 0 ? sum / count : 0.0; }
+
+    /** @brief Returns an upper bound of the given percentile (0..1), read from the buckets and capped at max. */
+    double percentile(double fraction) const;
+};
+
+/**
+ * @brief Process-wide counters and histograms describing what the application does, e.g. SQL statements per model.
+ *
+ * @details Metric names are dotted paths: "sql.VoterModel.statements", "sql.VoterModel.statement_us",
+ * "model.PartyModel.resets", "signal.VoterModel::voterAdded", "chart.PartyChartWidget::updateChart". Counters only grow until
+ * reset(). Histograms keep a count, sum, min, max and power-of-two buckets, so observing a value is O(1) and memory stays
+ * fixed. All methods are thread-safe.
+ */
+class MetricsRegistry {
+public:
+    static constexpr int kBuckets = 40;     ///< Bucket 0 holds values below 1, bucket i holds [2^(i-1), 2^i).
+
+    /** @brief Returns the process-wide registry. */
+    static MetricsRegistry& instance();
+
+    /** @brief Adds @p delta to a counter, creating it at 0 if needed. */
+    void increment(const QString& name, qint64 delta = 1);
+
+    /** @brief Adds one observation to a histogram. */
+    void observe(const QString& name, double value);
+
+    /** @brief Returns a counter (0 if unknown). */
+    qint64 counter(const QString& name) const;
+
+    /** @brief Returns a histogram (empty if unknown). */
+    HistogramSnapshot histogram(const QString& name) const;
+
+    /** @brief Returns the names of all counters, sorted. */
+    QStringList counterNames() const;
+
+    /** @brief Returns the names of all histograms, sorted. */
+    QStringList histogramNames() const;
+
+    /** @brief Drops every counter and histogram. */
+    void reset();
+
+    /** @brief Returns all metrics as {"counters": {...}, "histograms": {name: {count, sum, min, max, mean, p50, p95, p99}}}. */
+    QJsonObject toJson() const;
+
+    /** @brief Returns the bucket a value falls into. */
+    static int bucketOf(double value);
+
+    /**
+     * @brief Counts every emission of a signal in the counter @p name.
+     * @param sender Object emitting the signal; the counting connection lives as long as it does.
+     * @param signal Pointer to the signal, e.g. &VoterModel::voterAdded.
+     */
+    template <typename Sender, typename Signal>
+    void countEmissions(Sender* sender, Signal signal, const QString& name) {
+        QObject::connect(sender, signal, sender, [this, name]() { increment(name); });
+    }
+
+private:
+    MetricsRegistry() = default;
+
+    mutable QMutex m_mutex;                             ///< Guards both maps.
+    QHash<QString, qint64> m_counters;                  ///< Counter values by name.
+    QHash<QString, HistogramSnapshot> m_histograms;     ///< Histograms by name.
+};
+
+#endif // METRICSREGISTRY_H
@@ -0,0 +1,63 @@
+#include "ProfilerOverlay.h"
+#include "InteractionProfiler.h"
+
+#include <QEvent>
+
+ProfilerOverlay::ProfilerOverlay(QWidget* parent)
+    : QLabel(parent)
+{
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setTextFormat(Qt::PlainText);
+    setFont(QFont("monospace", 8));
+    setStyleSheet("background-color: rgba(0, 0, 0, 170); color: white; padding: 6px;");
+    setAlignment(Qt::AlignLeft | Qt::AlignTop);
+    hide();
+
+    m_refresh.setInterval(500);
+    connect(&m_refresh, &QTimer::timeout, this, &ProfilerOverlay::refresh);
+    parent->installEventFilter(this);
+}
+
+void ProfilerOverlay::refresh() {
+    const InteractionProfiler& profiler = InteractionProfiler::instance();
+
+    QStringList lines;
+    lines << QString("%1  %2 %3 %4 %5 %6")
+                 .arg("series", -48).arg("n", 5).arg("p50", 8).arg("p95", 8).arg("p99", 8).arg("max", 8);
+    for (const QString& name : profiler.seriesNames()) {
+        const LatencySummary s = profiler.summary(name);
+        lines << QString("%1  %2 %3 %4 %5 %6")
+                     .arg(name.left(48), -48)
+                     .arg(s.count, 5)
+                     .arg(s.p50, 8, 'f', 2)
+                     .arg(s.p95, 8, 'f', 2)
+                     .arg(s.p99, 8, 'f', 2)
+                     .arg(s.max, 8, 'f', 2);
+    }
+    if (!profiler.isEnabled()) lines << "(profiling paused)";
+
+    setText(lines.join('\n'));
+    adjustSize();
+    reposition();
+}
+
+bool ProfilerOverlay::eventFilter(QObject* watched, QEvent* event) {
+    if (watched == parentWidget() && event->type() == QEvent::Resize && isVisible()) reposition();
+    return QLabel::eventFilter(watched, event);
+}
+
+void ProfilerOverlay::showEvent(QShowEvent* event) {
+    QLabel::showEvent(event);
+    raise();
+    refresh();
+    m_refresh.start();
+}
+
+void ProfilerOverlay::hideEvent(QHideEvent* event) {
+    m_refresh.stop();
+    QLabel::hideEvent(event);
+}
+
+void ProfilerOverlay::reposition() {
+    move(parentWidget()->width() - width() - 8, 8);
+}
@@ -0,0 +1,43 @@
+#ifndef PROFILEROVERLAY_H
+#define PROFILEROVERLAY_H
+
+#include <QLabel>
+#include <QTimer>
+
+/**
+ * @brief Translucent panel listing the InteractionProfiler summaries on top of a widget.
+ *
+ * @details Shows p50/p95/p99 and the slowest sample of every action, model, chart and frame series. The text is refreshed
+ * twice a second while the overlay is visible and the panel follows the top-right corner of its parent.
+ */
+class ProfilerOverlay : public QLabel {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructs a hidden overlay.
+     * @param parent Widget to draw over.
+     */
+    explicit ProfilerOverlay(QWidget* parent);
+
+public slots:
+    /** @brief Rebuilds the text from the current summaries. */
+    void refresh();
+
+protected:
+    /** @brief Keeps the overlay in the parent's top-right corner. */
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+    /** @brief Starts refreshing. */
+    void showEvent(QShowEvent* event) override;
+
+    /** @brief Stops refreshing. */
+    void hideEvent(QHideEvent* event) override;
+
+private:
+    void reposition();          ///< Moves the overlay to the parent's top-right corner.
+
+    QTimer m_refresh;           ///< Refresh timer, running while visible.
+};
+
+#endif // PROFILEROVERLAY_H
@@ -0,0 +1,138 @@
+#include "SlowQueryLog.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutexLocker>
+#include <QRegularExpression>
+#include <QSqlQuery>
+#include <QTextStream>
+
+#include <algorithm>
+
+SlowQueryLog& SlowQueryLog::instance() {
+    static SlowQueryLog log;
+    return log;
+}
+
+SlowQueryLog::SlowQueryLog() {
+    bool ok = false;
+    const double threshold = qEnvironmentVariable("POLITICALSIM_SLOW_QUERY_MS").toDouble(&ok);
+    if (ok) m_thresholdMs = threshold;
+}
+
+void SlowQueryLog::setThresholdMs(double milliseconds) {
+    QMutexLocker lock(&m_mutex);
+    m_thresholdMs = milliseconds;
+}
+
+double SlowQueryLog::thresholdMs() const {
+    QMutexLocker lock(&m_mutex);
+    return m_thresholdMs;
+}
+
+void SlowQueryLog::setLogPath(const QString& path) {
+    QMutexLocker lock(&m_mutex);
+    m_path = path;
+}
+
+QString SlowQueryLog::logPath() const {
+    QMutexLocker lock(&m_mutex);
+    return m_path;
+}
+
+void SlowQueryLog::setRotation(qint64 maxBytes, int keptFiles) {
+    QMutexLocker lock(&m_mutex);
+    m_maxBytes = std::max<qint64>(1, maxBytes);
+    m_keptFiles = std::max(1, keptFiles);
+}
+
+qint64 SlowQueryLog::maxBytes() const {
+    QMutexLocker lock(&m_mutex);
+    return m_maxBytes;
+}
+
+int SlowQueryLog::keptFiles() const {
+    QMutexLocker lock(&m_mutex);
+    return m_keptFiles;
+}
+
+int SlowQueryLog::entryCount() const {
+    QMutexLocker lock(&m_mutex);
+    return m_entries;
+}
+
+void SlowQueryLog::report(const QString& owner, const QSqlDatabase& db, const QString& statement,
+                          const QVariantList& boundValues, double milliseconds) {
+    if (milliseconds < thresholdMs()) return;
+
+    // Capture the plan before taking the lock; EXPLAIN itself is not metered
+    const QStringList plan = queryPlan(db, statement, boundValues);
+
+    QStringList values;
+    for (const QVariant& value : boundValues) {
+        QString text = value.isNull() ? QStringLiteral("NULL") : value.toString();
+        if (text.size() > 200) text = text.left(200) + "...";
+        values << text;
+    }
+
+    QMutexLocker lock(&m_mutex);
+    rotateIfNeeded();
+
+    QFile file(m_path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        qWarning() << "[SlowQueryLog] Cannot write" << m_path << ":" << file.errorString();
+        return;
+    }
+    QTextStream out(&file);
+    out << QDateTime::currentDateTime().toString(Qt::ISODateWithMs) << " [" << owner << "] "
+        << QString::number(milliseconds, 'f', 1) << " ms\n";
+    out << "  SQL: " << statement.simplified() << '\n';
+    if (!values.isEmpty()) out << "  Bound: [" << values.join(", ") << "]\n";
+    if (!plan.isEmpty()) {
+        out << "  Plan:\n";
+        for (const QString& line : plan)
+            out << "    " << line << '\n';
+    }
+    out << '\n';
+    ++m_entries;
+
+    qWarning().nospace() << "[SlowQueryLog] " << owner << ": " << QString::number(milliseconds, 'f', 1) << " ms for "
+                         << statement.simplified().left(80);
+}
+
+QStringList SlowQueryLog::queryPlan(const QSqlDatabase& db, const QString& statement, const QVariantList& boundValues) {
+    static const QRegularExpression explainable("^\\s*(SELECT|INSERT|UPDATE|DELETE|REPLACE|WITH)\\b",
+                                                QRegularExpression::CaseInsensitiveOption);
+    QStringList lines;
+    if (!db.isOpen() || !statement.contains(explainable)) return lines;
+
+    QSqlQuery explain(db);
+    if (!explain.prepare("EXPLAIN QUERY PLAN " + statement)) return lines;
+    for (int i = 0; i < boundValues.size(); ++i)
+        explain.bindValue(i, boundValues[i]);
+    if (!explain.exec()) return lines;
+
+    // Columns: id, parent, notused, detail; indent each step below its parent
+    QHash<int, int> depth;
+    while (explain.next()) {
+        const int id = explain.value(0).toInt();
+        const int parent = explain.value(1).toInt();
+        const int level = depth.contains(parent) ? depth.value(parent) + 1 : 0;
+        depth.insert(id, level);
+        lines << QString(level * 2, ' ') + explain.value(3).toString();
+    }
+    return lines;
+}
+
+void SlowQueryLog::rotateIfNeeded() {
+    const QFileInfo info(m_path);
+    if (!info.exists() || info.size() < m_maxBytes) return;
+
+    QFile::remove(QString("%1.%2").arg(m_path).arg(m_keptFiles));
+    for (int i = m_keptFiles - 1; i >= 1; --i)
+        QFile::rename(QString("%1.%2").arg(m_path).arg(i), QString("%1.%2").arg(m_path).arg(i + 1));
+    QFile::rename(m_path, m_path + ".1");
+}
@@ -0,0 +1,79 @@
+#ifndef SLOWQUERYLOG_H
+#define SLOWQUERYLOG_H
+
+#include <QMutex>
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+/**
+ * @brief Rotating log of SQL statements slower than a threshold, with their SQLite query plans.
+ *
+ * @details MeteredQuery reports every statement that takes at least thresholdMs(). The entry holds the time, owner, duration,
+ * statement text, bound values and the output of `EXPLAIN QUERY PLAN` for the same statement, indented as a tree, so full
+ * scans ("SCAN voters") stand out. The plan is captured on the same connection right after the slow statement.
+ *
+ * When the file grows past maxBytes() it is renamed to "<path>.1" (older files shift to ".2", ... up to keptFiles()) and a
+ * new file is started.
+ *
+ * The threshold defaults to 100 ms and can be set with the POLITICALSIM_SLOW_QUERY_MS environment variable; 0 or less logs
+ * every statement.
+ */
+class SlowQueryLog {
+public:
+    /** @brief Returns the process-wide log. */
+    static SlowQueryLog& instance();
+
+    /** @brief Sets the duration from which a statement is logged. */
+    void setThresholdMs(double milliseconds);
+
+    /** @brief Returns the duration from which a statement is logged. */
+    double thresholdMs() const;
+
+    /** @brief Sets the log file (default "politicalsim-slow-queries.log"). */
+    void setLogPath(const QString& path);
+
+    /** @brief Returns the log file. */
+    QString logPath() const;
+
+    /** @brief Sets the size after which the file is rotated and how many rotated files are kept. */
+    void setRotation(qint64 maxBytes, int keptFiles);
+
+    /** @brief Returns the size after which the file is rotated. */
+    qint64 maxBytes() const;
+
+    /** @brief Returns how many rotated files are kept. */
+    int keptFiles() const;
+
+    /** @brief Returns the number of entries written since startup. */
+    int entryCount() const;
+
+    /**
+     * @brief Logs a statement if it was slow.
+     * @param owner Component that ran it, e.g. "VoterModel".
+     * @param db Connection it ran on, used for EXPLAIN QUERY PLAN.
+     * @param statement Statement text, with placeholders.
+     * @param boundValues Values bound to the placeholders, in order.
+     * @param milliseconds How long it took.
+     */
+    void report(const QString& owner, const QSqlDatabase& db, const QString& statement, const QVariantList& boundValues,
+                double milliseconds);
+
+    /** @brief Returns the `EXPLAIN QUERY PLAN` lines of a statement, indented by plan depth (empty if it cannot be explained). */
+    static QStringList queryPlan(const QSqlDatabase& db, const QString& statement, const QVariantList& boundValues);
+
+private:
+    SlowQueryLog();
+
+    void rotateIfNeeded();                  ///< Shifts the rotated files once the log is too large.
+
+    mutable QMutex m_mutex;                 ///< Guards the settings and the file.
+    double m_thresholdMs = 100.0;           ///< Duration from which statements are logged.
+    QString m_path = "politicalsim-slow-queries.log";  ///< Log file.
+    qint64 m_maxBytes = 1024 * 1024;        ///< Size after which the file is rotated.
+    int m_keptFiles = 3;                    ///< Rotated files kept.
+    int m_entries = 0;                      ///< Entries written since startup.
+};
+
+#endif // SLOWQUERYLOG_H
@@ -0,0 +1,179 @@
+#include "Tracer.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QIODevice>
+#include <QThread>
+
+#include <chrono>
+
+std::atomic<bool> Tracer::s_enabled{false};
+
+namespace {
+
+thread_local void* t_buffer = nullptr;      // Calling thread's Tracer::ThreadBuffer
+
+const std::chrono::steady_clock::time_point g_epoch = std::chrono::steady_clock::now();
+
+void appendEscaped(QByteArray& out, const char* text) {
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') out += '\\';
+        out += *c;
+    }
+}
+
+void appendEscaped(QByteArray& out, const QString& text) {
+    appendEscaped(out, text.toUtf8().constData());
+}
+
+} // namespace
+
+Tracer& Tracer::instance() {
+    static Tracer tracer;
+    return tracer;
+}
+
+void Tracer::setEnabled(bool enabled) {
+    s_enabled.store(enabled, std::memory_order_relaxed);
+    qDebug() << "[Tracer] Tracing" << (enabled ? "enabled" : "disabled");
+}
+
+qint64 Tracer::nowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - g_epoch).count();
+}
+
+void Tracer::complete(const char* category, const char* name, qint64 startUs, qint64 durationUs) {
+    Event event;
+    event.category = category;
+    event.name = name;
+    event.phase = 'X';
+    event.timestampUs = startUs;
+    event.durationUs = durationUs;
+    append(event);
+}
+
+void Tracer::counter(const char* category, const char* name, double value) {
+    Event event;
+    event.category = category;
+    event.name = name;
+    event.phase = 'C';
+    event.timestampUs = nowUs();
+    event.value = value;
+    append(event);
+}
+
+int Tracer::eventCount() const {
+    QMutexLocker registry(&m_registryMutex);
+    int count = 0;
+    for (const auto& buffer : m_buffers) {
+        QMutexLocker lock(&buffer->mutex);
+        count += static_cast<int>(buffer->events.size());
+    }
+    return count;
+}
+
+int Tracer::droppedCount() const {
+    QMutexLocker registry(&m_registryMutex);
+    int count = 0;
+    for (const auto& buffer : m_buffers) {
+        QMutexLocker lock(&buffer->mutex);
+        count += buffer->dropped;
+    }
+    return count;
+}
+
+void Tracer::clear() {
+    QMutexLocker registry(&m_registryMutex);
+    for (const auto& buffer : m_buffers) {
+        QMutexLocker lock(&buffer->mutex);
+        buffer->events.clear();
+        buffer->dropped = 0;
+    }
+}
+
+void Tracer::writeChromeTrace(QIODevice& out) const {
+    QMutexLocker registry(&m_registryMutex);
+
+    QByteArray chunk;
+    chunk.reserve(1 << 16);
+    bool first = true;
+    auto separator = [&]() {
+        if (!first) chunk += ",\n";
+        first = false;
+    };
+    auto flush = [&]() {
+        out.write(chunk);
+        chunk.clear();
+    };
+
+    chunk += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    for (const auto& buffer : m_buffers) {
+        QMutexLocker lock(&buffer->mutex);
+        const QByteArray tid = QByteArray::number(buffer->threadId);
+
+        separator();
+        chunk += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tid + ",\"args\":{\"name\":\"";
+        appendEscaped(chunk, buffer->threadName);
+        chunk += "\"}}";
+
+        for (const Event& e : buffer->events) {
+            separator();
+            chunk += "{\"name\":\"";
+            appendEscaped(chunk, e.name);
+            chunk += "\",\"cat\":\"";
+            appendEscaped(chunk, e.category);
+            chunk += "\",\"ph\":\"";
+            chunk += e.phase;
+            chunk += "\",\"pid\":1,\"tid\":" + tid + ",\"ts\":" + QByteArray::number(e.timestampUs);
+            if (e.phase == 'X') {
+                chunk += ",\"dur\":" + QByteArray::number(e.durationUs);
+            } else {
+                chunk += ",\"args\":{\"value\":" + QByteArray::number(e.value, 'g', 12) + '}';
+            }
+            chunk += '}';
+            if (chunk.size() >= (1 << 16)) flush();
+        }
+    }
+    chunk += "\n]}\n";
+    flush();
+}
+
+bool Tracer::exportChromeTrace(const QString& path) const {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "[Tracer] Cannot write" << path << ":" << file.errorString();
+        return false;
+    }
+    writeChromeTrace(file);
+    qDebug() << "[Tracer] Exported" << eventCount() << "events to" << path;
+    return true;
+}
+
+Tracer::ThreadBuffer& Tracer::localBuffer() {
+    if (t_buffer) return *static_cast<ThreadBuffer*>(t_buffer);
+
+    auto buffer = std::make_unique<ThreadBuffer>();
+    QThread* thread = QThread::currentThread();
+    const bool isMain = QCoreApplication::instance() && thread == QCoreApplication::instance()->thread();
+
+    QMutexLocker registry(&m_registryMutex);
+    buffer->threadId = static_cast<int>(m_buffers.size()) + 1;
+    buffer->threadName = isMain ? QStringLiteral("GUI")
+                       : !thread->objectName().isEmpty() ? thread->objectName()
+                       : QStringLiteral("Thread %1").arg(buffer->threadId);
+    buffer->events.reserve(4096);
+    t_buffer = buffer.get();
+    m_buffers.push_back(std::move(buffer));
+    return *static_cast<ThreadBuffer*>(t_buffer);
+}
+
+void Tracer::append(const Event& event) {
+    ThreadBuffer& buffer = localBuffer();
+    QMutexLocker lock(&buffer.mutex);
+    if (static_cast<int>(buffer.events.size()) >= kMaxEventsPerThread) {
+        ++buffer.dropped;
+        return;
+    }
+    buffer.events.push_back(event);
+}
@@ -0,0 +1,142 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <QMutex>
+#include <QString>
+#include <QtGlobal>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class QIODevice;
+
+/**
+ * @brief Low-overhead event tracer exporting the Chrome trace-event format.
+ *
+ * @details Instrumented code records complete events (a named span with a start and a duration) with TRACE_SCOPE and counter
+ * samples with TRACE_COUNTER. Each thread appends to its own buffer, so recording takes one uncontended lock and no allocation
+ * in the common case. Names and categories are stored as pointers and must be string literals.
+ *
+ * Tracing is off by default; while it is off each macro costs one relaxed atomic load. exportChromeTrace() writes every
+ * buffer as trace-event JSON that chrome://tracing or Perfetto can open, with one track per thread.
+ *
+ * @code
+ * void VoterModel::reloadData() {
+ *     TRACE_SCOPE("model", "VoterModel::reloadData");
+ *     ...
+ *     TRACE_COUNTER("model", "voters", m_voters.size());
+ * }
+ * @endcode
+ */
+class Tracer {
+public:
+    /** @brief One recorded event. */
+    struct Event {
+        const char* category = nullptr;     ///< Category literal, e.g. "db".
+        const char* name = nullptr;         ///< Event name literal.
+        char phase = 'X';                   ///< 'X' for a complete event, 'C' for a counter sample.
+        qint64 timestampUs = 0;             ///< Start time in microseconds since the tracer epoch.
+        qint64 durationUs = 0;              ///< Duration of a complete event.
+        double value = 0.0;                 ///< Value of a counter sample.
+    };
+
+    static constexpr int kMaxEventsPerThread = 1 << 20;    ///< Events kept per thread; later ones are dropped and counted.
+
+    /** @brief Returns the process-wide tracer. */
+    static Tracer& instance();
+
+    /** @brief Returns true while events are recorded. */
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    /** @brief Starts or stops recording; recorded events are kept. */
+    void setEnabled(bool enabled);
+
+    /** @brief Returns the current time in microseconds since the tracer epoch. */
+    static qint64 nowUs();
+
+    /**
+     * @brief Records a complete event on the calling thread.
+     * @param category Category literal.
+     * @param name Name literal.
+     * @param startUs Start time from nowUs().
+     * @param durationUs Duration in microseconds.
+     */
+    void complete(const char* category, const char* name, qint64 startUs, qint64 durationUs);
+
+    /** @brief Records a counter sample on the calling thread. */
+    void counter(const char* category, const char* name, double value);
+
+    /** @brief Returns the number of events recorded on all threads. */
+    int eventCount() const;
+
+    /** @brief Returns the number of events dropped because a thread buffer was full. */
+    int droppedCount() const;
+
+    /** @brief Drops every recorded event. */
+    void clear();
+
+    /** @brief Writes every recorded event as Chrome trace-event JSON. */
+    void writeChromeTrace(QIODevice& out) const;
+
+    /**
+     * @brief Writes every recorded event to a file as Chrome trace-event JSON.
+     * @return True on success.
+     */
+    bool exportChromeTrace(const QString& path) const;
+
+private:
+    Tracer() = default;
+
+    struct ThreadBuffer {
+        mutable QMutex mutex;               ///< Guards events against a concurrent export or clear.
+        std::vector<Event> events;          ///< Events recorded by the thread.
+        int threadId = 0;                   ///< Track number in the exported trace.
+        QString threadName;                 ///< Track name in the exported trace.
+        int dropped = 0;                    ///< Events lost because the buffer was full.
+    };
+
+    ThreadBuffer& localBuffer();            ///< Returns the calling thread's buffer, registering it on first use.
+    void append(const Event& event);        ///< Appends to the calling thread's buffer.
+
+    static std::atomic<bool> s_enabled;     ///< Recording flag, read without locking by the macros.
+
+    mutable QMutex m_registryMutex;                     ///< Guards m_buffers.
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;   ///< Buffers of every thread that recorded (kept after threads exit).
+};
+
+/**
+ * @brief Records the lifetime of a scope as a complete event; use through TRACE_SCOPE.
+ */
+class TraceScope {
+public:
+    /** @brief Starts timing if tracing is enabled. */
+    TraceScope(const char* category, const char* name)
+        : m_category(Tracer::isEnabled() ? category : nullptr), m_name(name),
+          m_startUs(m_category ? Tracer::nowUs() : 0) {}
+
+    /** @brief Records the event. */
+    ~TraceScope() {
+        if (m_category) Tracer::instance().complete(m_category, m_name, m_startUs, Tracer::nowUs() - m_startUs);
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_category;                 ///< Category (nullptr while tracing is off).
+    const char* m_name;                     ///< Event name.
+    qint64 m_startUs;                       ///< Start time.
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+/** @brief Records the enclosing scope as a complete event. */
+#define TRACE_SCOPE(category, name) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(category, name)
+
+/** @brief Records a counter sample. */
+#define TRACE_COUNTER(category, name, value) \
+    do { if (Tracer::isEnabled()) Tracer::instance().counter(category, name, static_cast<double>(value)); } while (0)
+
+#endif // TRACER_H
@@ -4,6 +4,8 @@
 
 #include <QDialog>
 #include "models/PartyModel.h"
+#include "simulation/PartyOptimizer.h"
+#include "simulation/SharePreview.h"
 
 AddPartyDialog::AddPartyDialog(QWidget *parent)
     : QDialog(parent), ui(new Ui::AddPartyDialog) {
@@ -25,6 +27,14 @@ AddPartyDialog::AddPartyDialog(QWidget *parent)
         if (idx != -1) ui->ideologyComboBox->setCurrentIndex(idx);
     });
     ui->ideologyComboBox->setEnabled(false); //ideology selection is read-only
+
+    // Live share preview; nothing is written until the dialog is accepted
+    connect(ui->ideologyXSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, &AddPartyDialog::updatePreview);
+    connect(ui->ideologyYSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, &AddPartyDialog::updatePreview);
+    connect(ui->nameEdit, &QLineEdit::textChanged, this, &AddPartyDialog::updatePreview);
+
+    ui->optimizeButton->setEnabled(false); // needs an electorate, see setElectorate()
+    connect(ui->optimizeButton, &QPushButton::clicked, this, &AddPartyDialog::optimizePosition);
 }
 
 AddPartyDialog::~AddPartyDialog() {
@@ -103,3 +113,65 @@ void AddPartyDialog::setIdeologyModel(const IdeologyModel* model) {
     int idx = ui->ideologyComboBox->findData(curId);
     if (idx != -1) ui->ideologyComboBox->setCurrentIndex(idx);
 }
+
+void AddPartyDialog::setElectorate(const VoterHistogram* histogram, const QVector<Party>& parties) {
+    m_histogram = histogram;
+    m_parties = parties;
+    ui->optimizeButton->setEnabled(histogram && histogram->total() > 0);
+
+    int index = -1;
+    for (int i = 0; i < parties.size(); ++i) {
+        if (m_partyId != -1 && parties[i].id == m_partyId) index = i;
+    }
+    m_preview.reset();
+    if (histogram) m_preview = std::make_unique<SharePreview>(*histogram, parties, index);
+    updatePreview();
+}
+
+void AddPartyDialog::updatePreview() {
+    if (!m_preview) {
+        ui->sharePreviewLabel->clear();
+        return;
+    }
+
+    const ShareProjection projection = m_preview->project(ui->ideologyXSpinBox->value(), ui->ideologyYSpinBox->value());
+    const ShareProjection& current = m_preview->current();
+
+    QStringList lines;
+    for (int i = 0; i < projection.votes.size(); ++i) {
+        QString name = i < m_parties.size() ? m_parties[i].name : QString();
+        if (i == m_preview->partyIndex()) name = ui->nameEdit->text().isEmpty() ? QString("New party") : ui->nameEdit->text();
+        lines << QString("%1: %2% (%3%4)")
+                     .arg(name)
+                     .arg(projection.share(i), 0, 'f', 1)
+                     .arg(projection.share(i) >= current.share(i) ? "+" : "")
+                     .arg(projection.share(i) - current.share(i), 0, 'f', 1);
+    }
+    lines << QString("%1 voters would switch party").arg(projection.switched);
+    ui->sharePreviewLabel->setText(lines.join('\n'));
+}
+
+void AddPartyDialog::optimizePosition() {
+    if (!m_histogram) return;
+
+    // Replace the edited party with the form's values; a new party joins at the end of the list
+    QVector<Party> parties = m_parties;
+    int index = -1;
+    for (int i = 0; i < parties.size(); ++i) {
+        if (m_partyId != -1 && parties[i].id == m_partyId) index = i;
+    }
+    if (index == -1) {
+        parties.append(getParty());
+        index = parties.size() - 1;
+    } else {
+        parties[index] = getParty();
+    }
+
+    PartyOptimizer optimizer(*m_histogram, parties);
+    const OptimizedPosition best = optimizer.optimize(index, OptimizerSettings());
+
+    ui->ideologyXSpinBox->setValue(best.x);
+    ui->ideologyYSpinBox->setValue(best.y);
+    ui->optimizeResultLabel->setText(QString("Best share: %1% (%2 positions tried)")
+                                         .arg(best.share, 0, 'f', 2).arg(best.evaluations));
+}
@@ -4,6 +4,10 @@
 #include <QDialog>
 #include "models/PartyModel.h"
 #include "models/IdeologyModel.h"
+#include "simulation/VoterHistogram.h"
+#include "simulation/SharePreview.h"
+
+#include <memory>
 
 namespace Ui {
 class AddPartyDialog;
@@ -79,10 +83,25 @@ public:
      */
     void setIdeologyModel(const IdeologyModel* model);
 
+    /**
+     * @brief Provides the electorate used by the "Optimize Position" button.
+     * @param histogram Voter density histogram to score positions against (must outlive the dialog).
+     * @param parties Current positions of all parties, including the one being edited.
+     *
+     * Also enables the live share preview, so call it after setParty() when editing.
+     */
+    void setElectorate(const VoterHistogram* histogram, const QVector<Party>& parties);
+
 private:
+    void optimizePosition();                                        ///< Moves the X/Y fields to the vote-maximising position.
+    void updatePreview();                                           ///< Shows the projected shares for the current X/Y values.
+
     Ui::AddPartyDialog* ui;                                         ///< Pointer to the UI form instance.
     int m_partyId = -1;                                             ///< ID of the party being edited; -1 if new.
     const IdeologyModel* m_ideologyModel = nullptr;                 ///< Pointer to the IdeologyModel used to calculate the nearest ideology.
+    const VoterHistogram* m_histogram = nullptr;                    ///< Voter density used to score candidate positions.
+    QVector<Party> m_parties;                                       ///< Positions of all parties at the time the dialog opened.
+    std::unique_ptr<SharePreview> m_preview;                        ///< Per-cell winners precomputed for the live preview.
 };
 
 #endif // ADDPARTYDIALOG_H
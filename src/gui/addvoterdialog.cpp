@@ -51,29 +51,9 @@ Voter AddVoterDialog::getVoter() const {
     }
     v.ideologyX = ideologyX();
     v.ideologyY = ideologyY();
-    if (m_partyModel) {
-        int closestPartyId = -1;
-        double minDistance = std::numeric_limits<double>::max();
-        for (const Party& p : m_partyModel->getAllParties()) {
-            double dx = p.ideologyX - v.ideologyX;
-            double dy = p.ideologyY - v.ideologyY;
-            double dist = dx * dx + dy * dy;
-            if (dist < minDistance) {
-                minDistance = dist;
-                closestPartyId = p.id;
-            }
-        }
-        v.partyId = closestPartyId;
-        v.partyName = (closestPartyId != -1
-                           ? m_partyModel->getPartyAt(m_partyModel->getAllParties().indexOf(
-                                                          *std::find_if(m_partyModel->getAllParties().begin(), m_partyModel->getAllParties().end(),
-                                                                        [closestPartyId](const Party& p){ return p.id == closestPartyId; })))
-                                 .name
-                           : QString());  // find party name for completeness
-    } else {
-        v.partyId = -1;
-        v.partyName.clear();
-    }
+    // VoterModel assigns the nearest party on every axis of the ideology space when it stores the voter
+    v.partyId = -1;
+    v.partyName.clear();
     return v;
 }
 
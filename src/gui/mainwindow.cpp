@@ -4,20 +4,38 @@
 #include "addvoterdialog.h"
 #include "models/PartyModel.h"
 #include "models/IdeologyModel.h"
+#include "models/IdeologySpace.h"
+#include "simulation/PartyOptimizer.h"
+#include "diagnostics/InteractionProfiler.h"
+#include "diagnostics/Tracer.h"
+#include "diagnostics/MeteredQuery.h"
+#include "diagnostics/MemoryReport.h"
 
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QMessageBox>
+#include <QInputDialog>
+#include <QFileDialog>
+#include <QFile>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QThreadPool>
+#include <QShortcut>
+#include <QAction>
+#include <QtCharts/QChartView>
+#include <QtCharts/QXYSeries>
 #include <QDebug>
 
-MainWindow::MainWindow(QWidget *parent)
+#include <algorithm>
+
+MainWindow::MainWindow(QWidget *parent, const QString &dbPath)
     : QMainWindow(parent), ui(new Ui::MainWindow)
 {
     ui->setupUi(this);
     setWindowTitle("PoliticalSim");
 
-    partyModel = new PartyModel("main_connection", this);
-    voterModel = new VoterModel("main_connection", this);
+    partyModel = new PartyModel("main_connection", this, true, dbPath);
+    voterModel = new VoterModel("main_connection", this, dbPath);
     ideologyModel = new IdeologyModel("main_connection", this);
 
     partyModel->setVoterModel(voterModel);
@@ -26,13 +44,11 @@ MainWindow::MainWindow(QWidget *parent)
     voterModel->setIdeologyModel(ideologyModel);
     partyModel->setIdeologyModel(ideologyModel);
 
-    voterProxyModel = new QSortFilterProxyModel(this);
+    voterProxyModel = new VoterFilterProxyModel(this);
 
     // Models → Views
     ui->partyTableView->setModel(partyModel);
-    voterProxyModel->setSourceModel(voterModel);
-    voterProxyModel->setFilterCaseSensitivity(Qt::CaseInsensitive);
-    voterProxyModel->setFilterKeyColumn(-1);
+    voterProxyModel->setVoterModel(voterModel);
     ui->voterTableView->setModel(voterProxyModel);
 
     //Signals to autorefresh UI
@@ -41,20 +57,7 @@ MainWindow::MainWindow(QWidget *parent)
     connect(partyModel, &PartyModel::partyDeleted, partyModel, &PartyModel::reloadData);
     connect(partyModel, &PartyModel::partyUpdated, voterModel, &VoterModel::reloadData);
 
-    connect(voterModel, &VoterModel::voterAdded, voterModel, &VoterModel::reloadData);
-    connect(voterModel, &VoterModel::voterUpdated, voterModel, &VoterModel::reloadData);
-    connect(voterModel, &VoterModel::voterDeleted, voterModel, &VoterModel::reloadData);
-
-    // Recalculate chart on data change
-    connect(voterModel, &VoterModel::voterAdded, partyModel, [&] {
-        emit partyModel->dataChangedExternally();
-    });
-    connect(voterModel, &VoterModel::voterUpdated, partyModel, [&] {
-        emit partyModel->dataChangedExternally();
-    });
-    connect(voterModel, &VoterModel::voterDeleted, partyModel, [&] {
-        emit partyModel->dataChangedExternally();
-    });
+    // Charts recalculate through PartyModel::recalculatePopularityFromVoters, wired up by setVoterModel
 
     //Tables allignment
     ui->partyTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
@@ -67,11 +70,19 @@ MainWindow::MainWindow(QWidget *parent)
     ui->partyTableView->setSelectionBehavior(QAbstractItemView::SelectRows);
     ui->voterTableView->setSelectionBehavior(QAbstractItemView::SelectRows);
     ui->partyTableView->setSelectionMode(QAbstractItemView::SingleSelection);
-    ui->voterTableView->setSelectionMode(QAbstractItemView::SingleSelection);
+    ui->voterTableView->setSelectionMode(QAbstractItemView::ExtendedSelection);
 
 
     // Database
     QSqlDatabase db = QSqlDatabase::database("main_connection");
+
+    // POLITICALSIM_DIMENSIONS=N switches to the standard space of N policy axes; new axes start at 0 for every row
+    const int dimensions = qEnvironmentVariableIntValue("POLITICALSIM_DIMENSIONS");
+    if (dimensions > 0 && dimensions != IdeologySpace::load(db).dimensions()) {
+        IdeologySpace::save(db, IdeologySpace::standard(dimensions));
+        ideologyModel->loadData();
+    }
+
     partyModel->ensurePartiesPopulated(db);
     partyModel->reloadData();
     //partyModel->recalculatePopularityFromVoters(voterModel);
@@ -91,10 +102,33 @@ MainWindow::MainWindow(QWidget *parent)
     voterModel->reloadData();
     //partyModel->recalculatePopularityFromVoters(voterModel);
 
-    // Connect search bar to proxy
-    connect(ui->voterSearchEdit, &QLineEdit::textChanged, this, [=](const QString &text) {
-        voterProxyModel->setFilterFixedString(text);
+    // Event log: start from a checkpoint of the current data, then record every change
+    eventLog = new EventLog(EventLog::pathForDatabase(dbPath));
+    if (eventLog->isEmpty())
+        eventLog->recordCheckpoint(partyModel->getAllParties(), voterModel->getAllVoters());
+    partyModel->setEventLog(eventLog);
+    voterModel->setEventLog(eventLog);
+
+    simulationEngine = new SimulationEngine(voterModel, partyModel, eventLog, this);
+    ui->tickLabel->setText(QString("Tick %1").arg(simulationEngine->currentTick()));
+    connect(simulationEngine, &SimulationEngine::tickCompleted, this, [=](int tick) {
+        ui->tickLabel->setText(QString("Tick %1").arg(tick));
+    });
+
+    // Search bar → indexed search on a worker thread → proxy
+    voterSearch = new VoterSearch(this);
+    if (voterModel->lazyNames()) {
+        // The index needs every voter's text, which is exactly what lazy names avoid loading
+        ui->voterSearchEdit->setEnabled(false);
+        ui->voterSearchEdit->setPlaceholderText("Search is off while names load on demand (POLITICALSIM_LAZY_NAMES)");
+    } else {
+        voterSearch->setVoterModel(voterModel);
+    }
+    connect(ui->voterSearchEdit, &QLineEdit::textChanged, voterSearch, &VoterSearch::setQuery);
+    connect(voterSearch, &VoterSearch::resultsReady, this, [=](const QString&, const QSet<int>& voterIds) {
+        voterProxyModel->setMatchingIds(voterIds);
     });
+    connect(voterSearch, &VoterSearch::searchCleared, voterProxyModel, &VoterFilterProxyModel::clearMatches);
 
     //Charts Setup
     partyChart = new PartyChartWidget(partyModel, this);
@@ -112,17 +146,23 @@ MainWindow::MainWindow(QWidget *parent)
     voterChart->setVoterModel(voterModel);
     ui->partyChartContainer->layout()->addWidget(voterChart);
 
+    popularityHistoryChart = new PopularityHistoryWidget(partyModel, this);
+    ui->partyChartContainer->layout()->addWidget(popularityHistoryChart);
+
     voterFocusChart = new SingleVoterIdeologyWidget(this);
+    voterFocusChart->setVoterModel(voterModel);
+    voterFocusChart->setPartyModel(partyModel);
     ui->voterFocusWidget->setLayout(new QVBoxLayout());
     ui->voterFocusWidget->layout()->addWidget(voterFocusChart);
 
-    connect(voterModel, &VoterModel::voterAdded, voterChart, &VoterIdeologyChartWidget::updateChart);
-    connect(voterModel, &VoterModel::voterUpdated, voterChart, &VoterIdeologyChartWidget::updateChart);
-    connect(voterModel, &VoterModel::voterDeleted, voterChart, &VoterIdeologyChartWidget::updateChart);
+    parliamentChart = new ParliamentChartWidget(partyModel, voterModel, this);
+    ui->voterChartContainer->layout()->addWidget(parliamentChart);
 
     connect(partyModel, &PartyModel::dataChangedExternally, partyChart, &PartyChartWidget::onDataChanged);
 
     setupButtonConnections();
+    setupProfiler();
+    setupMemoryReport();
 }
 
 void MainWindow::setupButtonConnections() {
@@ -130,7 +170,9 @@ void MainWindow::setupButtonConnections() {
         qDebug() << "[UI] Add Party clicked";
         AddPartyDialog dialog(this);
         dialog.setIdeologyModel(ideologyModel);
+        dialog.setElectorate(&voterModel->histogram(), partyModel->getAllParties());
         if (dialog.exec() == QDialog::Accepted) {
+            InteractionProfiler::instance().beginAction("Add Party");
             partyModel->addParty(dialog.getParty());
         }
     });
@@ -146,16 +188,28 @@ void MainWindow::setupButtonConnections() {
         dialog.setParty(party);
         dialog.setIdeologyModel(ideologyModel);
         dialog.setParty(party);
+        dialog.setElectorate(&voterModel->histogram(), partyModel->getAllParties());
         if (dialog.exec() == QDialog::Accepted) {
+            InteractionProfiler::instance().beginAction("Edit Party");
             partyModel->updateParty(id, dialog.getParty());
         }
     });
 
+    connect(ui->optimizePartiesButton, &QPushButton::clicked, this, [=]() {
+        qDebug() << "[UI] Optimize All clicked";
+        if (partyModel->getAllParties().isEmpty()) return;
+        InteractionProfiler::instance().beginAction("Optimize All");
+        PartyOptimizer optimizer(voterModel->histogram(), partyModel->getAllParties());
+        optimizer.bestResponse(OptimizerSettings());
+        partyModel->updatePartyPositions(optimizer.parties());
+    });
+
     connect(ui->deletePartyButton, &QPushButton::clicked, this, [=]() {
         qDebug() << "[UI] Delete Party clicked";
         QModelIndex index = ui->partyTableView->currentIndex();
         if (!index.isValid()) return;
         int id = partyModel->getPartyIdAt(index.row());
+        InteractionProfiler::instance().beginAction("Delete Party");
         partyModel->deletePartyById(id);
     });
 
@@ -164,6 +218,7 @@ void MainWindow::setupButtonConnections() {
         AddVoterDialog dialog(this, partyModel);
         dialog.setIdeologyModel(ideologyModel);
         if (dialog.exec() == QDialog::Accepted) {
+            InteractionProfiler::instance().beginAction("Add Voter");
             voterModel->addVoter(dialog.getVoter());
         }
         //partyModel->recalculatePopularityFromVoters(voterModel);
@@ -173,14 +228,16 @@ void MainWindow::setupButtonConnections() {
         qDebug() << "[UI] Edit Voter clicked";
         QModelIndex index = ui->voterTableView->currentIndex();
         if (!index.isValid()) return;
-        int id = voterModel->getVoterIdAt(index.row());
-        Voter voter = voterModel->getVoterAt(index.row());
+        int sourceRow = voterProxyModel->mapToSource(index).row();
+        int id = voterModel->getVoterIdAt(sourceRow);
+        Voter voter = voterModel->getVoterAt(sourceRow);
 
         AddVoterDialog dialog(this, partyModel);
         dialog.setIdeologyModel(ideologyModel);
         dialog.setVoter(voter);
         dialog.setVoter(voter);
         if (dialog.exec() == QDialog::Accepted) {
+            InteractionProfiler::instance().beginAction("Edit Voter");
             voterModel->updateVoter(id, dialog.getVoter());
         }
         //partyModel->recalculatePopularityFromVoters(voterModel);
@@ -188,24 +245,70 @@ void MainWindow::setupButtonConnections() {
 
     connect(ui->deleteVoterButton, &QPushButton::clicked, this, [=]() {
         qDebug() << "[UI] Delte Voter clicked";
-        QModelIndex index = ui->voterTableView->currentIndex();
-        if (!index.isValid()) return;
-        int id = voterModel->getVoterIdAt(index.row());
-        voterModel->deleteVoterById(id);
+        const QVector<int> ids = selectedVoterIds();
+        if (ids.isEmpty()) return;
+        if (ids.size() == 1) {
+            InteractionProfiler::instance().beginAction("Delete Voter");
+            voterModel->deleteVoterById(ids.first());
+            return;
+        }
+
+        auto reply = QMessageBox::question(this, "Delete Voters", QString("Delete %1 selected voters?").arg(ids.size()));
+        if (reply != QMessageBox::Yes) return;
+        InteractionProfiler::instance().beginAction("Delete Voters");
+        voterModel->deleteVoters(ids);
+        voterChart->clearSelection();
         //partyModel->recalculatePopularityFromVoters(voterModel);
     });
 
+    connect(ui->moveVotersButton, &QPushButton::clicked, this, [=]() {
+        qDebug() << "[UI] Move Selected clicked";
+        const QVector<int> ids = selectedVoterIds();
+        if (ids.isEmpty()) return;
+
+        bool ok = false;
+        const int dx = QInputDialog::getInt(this, "Move Voters", "Shift along Left <--> Right:", 0, -200, 200, 1, &ok);
+        if (!ok) return;
+        const int dy = QInputDialog::getInt(this, "Move Voters", "Shift along Libertarian <--> Authoritarian:", 0, -200, 200, 1, &ok);
+        if (!ok || (dx == 0 && dy == 0)) return;
+
+        QVector<VoterMove> moves;
+        moves.reserve(ids.size());
+        for (int id : ids) {
+            const Voter& v = voterModel->getAllVoters().at(voterModel->rowOfVoter(id));
+            moves.append(VoterMove{ id, std::clamp(v.ideologyX + dx, -100, 100), std::clamp(v.ideologyY + dy, -100, 100) });
+        }
+        InteractionProfiler::instance().beginAction("Move Voters");
+        voterModel->moveVoters(moves);
+        voterChart->clearSelection();
+    });
+
+    connect(ui->exportVotersButton, &QPushButton::clicked, this, [=]() {
+        qDebug() << "[UI] Export Selected clicked";
+        exportVoters(selectedVoterIds());
+    });
+
+    connect(voterChart, &VoterIdeologyChartWidget::votersSelected, this, &MainWindow::selectVoters);
+
     connect(ui->voterTableView->selectionModel(), &QItemSelectionModel::selectionChanged,
             this, [this](const QItemSelection &selected, const QItemSelection &) {
-        if (selected.indexes().isEmpty()) return;
+        if (selected.isEmpty()) return;
 
-        QModelIndex index = selected.indexes().first();
+        // Read the first range only; expanding a chart selection into indexes would touch every row
+        QModelIndex index = selected.first().topLeft();
         int sourceRow = voterProxyModel->mapToSource(index).row();
         const Voter& voter = voterModel->getVoterAt(sourceRow);
+        InteractionProfiler::instance().beginAction("Select Voter");
         voterFocusChart->showVoter(voter);
     });
 
     connect(ui->resetButton, &QPushButton::clicked, this, &MainWindow::resetDatabase);
+
+    connect(ui->simulateButton, &QPushButton::clicked, this, [=]() {
+        qDebug() << "[UI] Simulate clicked";
+        InteractionProfiler::instance().beginAction("Simulate");
+        simulationEngine->step(ui->tickCountSpinBox->value());
+    });
 }
 
 void MainWindow::resetDatabase() {
@@ -221,15 +324,19 @@ void MainWindow::resetDatabase() {
         qWarning() << "Reset failed: DB not open";
         return;
     }
+    InteractionProfiler::instance().beginAction("Reset");
 
-    QSqlQuery clear(db);
+    MeteredQuery clear(db, "MainWindow");
     if (!clear.exec("DELETE FROM voters"))
         qWarning() << "[Reset] Failed to clear voters:" << clear.lastError().text();
 
-    QSqlQuery resetVotersSeq(db);
+    if (!clear.exec("DELETE FROM districts"))
+        qWarning() << "[Reset] Failed to clear districts:" << clear.lastError().text();
+
+    MeteredQuery resetVotersSeq(db, "MainWindow");
     resetVotersSeq.exec("DELETE FROM sqlite_sequence WHERE name='voters'");
 
-    QSqlQuery resetPartiesSeq(db);
+    MeteredQuery resetPartiesSeq(db, "MainWindow");
     resetPartiesSeq.exec("DELETE FROM sqlite_sequence WHERE name='parties'");
 
     if (!clear.exec("DELETE FROM parties"))
@@ -250,16 +357,253 @@ void MainWindow::resetDatabase() {
     }
 
     voterModel->ensureVotersPopulated(db, partyMap);
-    voterModel->reloadData();
+    voterModel->reloadData();       // announces the cleared districts itself
+    eventLog->recordCheckpoint(partyModel->getAllParties(), voterModel->getAllVoters());
+    popularityHistoryChart->clearHistory();
     //partyModel->recalculatePopularityFromVoters(voterModel);
 }
 
+void MainWindow::setupProfiler() {
+    InteractionProfiler& profiler = InteractionProfiler::instance();
+    profiler.watchFrames(ui->partyTableView->viewport(), "partyTableView");
+    profiler.watchFrames(ui->voterTableView->viewport(), "voterTableView");
+
+    const QList<QPair<QWidget*, QString>> charts = {
+        { partyChart, "partyChart" },
+        { voterChart, "voterChart" },
+        { popularityHistoryChart, "popularityHistoryChart" },
+        { voterFocusChart, "voterFocusChart" },
+        { parliamentChart, "parliamentChart" },
+    };
+    for (const auto& [widget, name] : charts) {
+        if (auto* view = widget->findChild<QChartView*>())
+            profiler.watchFrames(view->viewport(), name);
+    }
+
+    profilerOverlay = new ProfilerOverlay(centralWidget());
+    if (qEnvironmentVariableIntValue("POLITICALSIM_PROFILE") > 0) {
+        profiler.setEnabled(true);
+        profilerOverlay->show();
+    }
+
+    auto* toggle = new QShortcut(QKeySequence("Ctrl+Shift+P"), this);
+    connect(toggle, &QShortcut::activated, this, [=]() {
+        InteractionProfiler& p = InteractionProfiler::instance();
+        p.setEnabled(!p.isEnabled());
+        profilerOverlay->setVisible(p.isEnabled());
+    });
+
+    auto* exportJson = new QShortcut(QKeySequence("Ctrl+Shift+J"), this);
+    connect(exportJson, &QShortcut::activated, this, [=]() {
+        const QString path = QFileDialog::getSaveFileName(this, "Export Profile", "politicalsim-profile.json", "JSON files (*.json)");
+        if (path.isEmpty()) return;
+        if (!InteractionProfiler::instance().exportJson(path))
+            QMessageBox::warning(this, "Export Failed", QString("Could not write %1").arg(path));
+    });
+
+    // Metrics dock, hidden until toggled
+    metricsDock = new MetricsDock(this);
+    addDockWidget(Qt::RightDockWidgetArea, metricsDock);
+    metricsDock->hide();
+    QAction* toggleMetrics = metricsDock->toggleViewAction();
+    toggleMetrics->setShortcut(QKeySequence("Ctrl+Shift+M"));
+    addAction(toggleMetrics);
+
+    // SQL metering costs every statement a registry update, so it runs only while the dock is open or POLITICALSIM_METRICS is set
+    const bool meterSession = qEnvironmentVariableIntValue("POLITICALSIM_METRICS") > 0;
+    if (meterSession)
+        MeteredQuery::setEnabled(true);
+    connect(toggleMetrics, &QAction::toggled, this, [meterSession](bool visible) {
+        MeteredQuery::setEnabled(meterSession || visible);
+    });
+
+    // Tracing: POLITICALSIM_TRACE=<file> records the whole session, Ctrl+Shift+T records on demand
+    if (!qEnvironmentVariableIsEmpty("POLITICALSIM_TRACE"))
+        Tracer::instance().setEnabled(true);
+
+    auto* trace = new QShortcut(QKeySequence("Ctrl+Shift+T"), this);
+    connect(trace, &QShortcut::activated, this, [=]() {
+        Tracer& tracer = Tracer::instance();
+        if (!tracer.isEnabled()) {
+            tracer.clear();
+            tracer.setEnabled(true);
+            qDebug() << "[UI] Tracing started; press Ctrl+Shift+T again to stop and export";
+            return;
+        }
+        tracer.setEnabled(false);
+        const QString path = QFileDialog::getSaveFileName(this, "Export Trace", "politicalsim-trace.json", "Trace files (*.json)");
+        if (path.isEmpty()) return;
+        if (!tracer.exportChromeTrace(path))
+            QMessageBox::warning(this, "Export Failed", QString("Could not write %1").arg(path));
+    });
+}
+
+void MainWindow::setupMemoryReport() {
+    memorySampler = new MemorySampler(this);
+    memorySampler->addSource([=](MemoryReport& r) { voterModel->reportMemory(r); });
+    memorySampler->addSource([=](MemoryReport& r) { partyModel->reportMemory(r); });
+    memorySampler->addSource([=](MemoryReport& r) { ideologyModel->reportMemory(r); });
+    memorySampler->addSource([=](MemoryReport& r) { voterProxyModel->reportMemory(r); });
+    memorySampler->addSource([=](MemoryReport& r) { voterChart->reportMemory(r, "charts.voterChart"); });
+
+    // The other charts hold a handful of points each; count what their XY series store
+    const QList<QPair<QWidget*, QString>> charts = {
+        { voterFocusChart, "charts.voterFocusChart" },
+        { popularityHistoryChart, "charts.popularityHistoryChart" },
+    };
+    for (const auto& [widget, name] : charts) {
+        memorySampler->addSource([widget, name](MemoryReport& r) {
+            auto* view = widget->findChild<QChartView*>();
+            if (!view) return;
+            for (QAbstractSeries* s : view->chart()->series()) {
+                if (auto* xy = qobject_cast<QXYSeries*>(s))
+                    r.add(name + ".series", MemoryReport::vectorBytes(xy->points()), xy->count());
+            }
+        });
+    }
+    memorySampler->addSource([](MemoryReport& r) {
+        r.add("sqlite.page_cache", MemoryReport::sqliteCacheBytes(QSqlDatabase::database("main_connection", false)));
+    });
+
+    // POLITICALSIM_MEMORY=<file> samples the whole session and exports on exit
+    if (!qEnvironmentVariableIsEmpty("POLITICALSIM_MEMORY")) {
+        const int interval = qEnvironmentVariableIntValue("POLITICALSIM_MEMORY_SAMPLE_MS");
+        memorySampler->start(interval > 0 ? interval : 10000);
+    }
+
+    auto* report = new QShortcut(QKeySequence("Ctrl+Shift+R"), this);
+    connect(report, &QShortcut::activated, this, [=]() {
+        qDebug().noquote() << "[UI] Memory report\n" + memorySampler->collect().toText();
+        const QString path = QFileDialog::getSaveFileName(this, "Export Memory Report", "politicalsim-memory.json", "JSON files (*.json)");
+        if (path.isEmpty()) return;
+        if (!memorySampler->exportJson(path))
+            QMessageBox::warning(this, "Export Failed", QString("Could not write %1").arg(path));
+    });
+}
+
+QVector<int> MainWindow::selectedVoterIds() const {
+    QVector<int> ids;
+    const QModelIndexList rows = ui->voterTableView->selectionModel()->selectedRows();
+    ids.reserve(rows.size());
+    for (const QModelIndex& index : rows)
+        ids.append(voterModel->getVoterIdAt(voterProxyModel->mapToSource(index).row()));
+    return ids;
+}
+
+void MainWindow::selectVoters(const QVector<int>& voterIds) {
+    // Merge consecutive table rows into ranges so large selections stay cheap
+    QVector<int> rows;
+    rows.reserve(voterIds.size());
+    for (int id : voterIds) {
+        const QModelIndex index = voterProxyModel->mapFromSource(voterModel->index(voterModel->rowOfVoter(id), 0));
+        if (index.isValid()) rows.append(index.row());
+    }
+    std::sort(rows.begin(), rows.end());
+
+    QItemSelection selection;
+    const int lastColumn = voterProxyModel->columnCount() - 1;
+    for (int i = 0; i < rows.size();) {
+        int j = i;
+        while (j + 1 < rows.size() && rows[j + 1] == rows[j] + 1) ++j;
+        selection.select(voterProxyModel->index(rows[i], 0), voterProxyModel->index(rows[j], lastColumn));
+        i = j + 1;
+    }
+    ui->voterTableView->selectionModel()->select(selection, QItemSelectionModel::ClearAndSelect);
+    if (!rows.isEmpty()) ui->voterTableView->scrollTo(voterProxyModel->index(rows.first(), 0));
+    qDebug() << "[UI] Selected" << rows.size() << "voters on the chart";
+}
+
+void MainWindow::exportVoters(const QVector<int>& voterIds) {
+    if (voterIds.isEmpty()) return;
+    const QString path = QFileDialog::getSaveFileName(this, "Export Voters", "voters.csv", "CSV files (*.csv)");
+    if (path.isEmpty()) return;
+
+    // Write from a snapshot of our own on a worker thread; the GUI keeps editing the live rows meanwhile
+    const PopulationSnapshot::Ptr snapshot = voterModel->captureSnapshot();
+
+    // Lazily loaded names are not in the snapshot: the worker reads voter names on its own connection, and the few party and
+    // ideology names are copied here
+    const bool lazyNames = voterModel->lazyNames();
+    QHash<int, QString> partyNames;
+    QHash<int, QString> ideologyNames;
+    if (lazyNames) {
+        for (const Party& p : partyModel->getAllParties())
+            partyNames.insert(p.id, p.name);
+        for (const Ideology& i : ideologyModel->getIdeologies())
+            ideologyNames.insert(i.id, i.name);
+    }
+    m_exporter.start([this, path, snapshot, voterIds, lazyNames, partyNames, ideologyNames]() {
+        const QHash<int, QString> names = lazyNames ? VoterModel::readNames("main_connection", voterIds) : QHash<int, QString>();
+        QHash<int, const Voter*> byId;
+        byId.reserve(voterIds.size());
+        for (int id : voterIds) byId.insert(id, nullptr);
+        for (const Voter& row : snapshot->voters) {
+            auto it = byId.find(row.id);
+            if (it != byId.end()) *it = &row;
+        }
+
+        auto quoted = [](QString text) { return QString("\"%1\"").arg(text.replace('"', "\"\"")); };
+        QSaveFile file(path);
+        int written = 0;
+        bool ok = false;
+        if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            QTextStream out(&file);
+            out << "id,name,ideology,party,x,y\n";
+            // Rows go out in the order they were asked for
+            for (int id : voterIds) {
+                const Voter* row = byId.value(id);
+                if (!row) continue;     // deleted since
+                Voter v = *row;
+                if (lazyNames) {
+                    v.name = names.value(id);
+                    v.ideology = ideologyNames.value(v.ideologyId);
+                    v.partyName = partyNames.value(v.partyId);
+                }
+                out << v.id << ',' << quoted(v.name) << ',' << quoted(v.ideology) << ',' << quoted(v.partyName) << ','
+                    << v.ideologyX << ',' << v.ideologyY << '\n';
+                ++written;
+            }
+            out.flush();
+            // A failed write cancels the save, so commit() leaves any previous file in place
+            if (out.status() != QTextStream::Ok) file.cancelWriting();
+            ok = file.commit();
+        }
+        const QString error = file.errorString();
+
+        QMetaObject::invokeMethod(this, [this, path, ok, error, written]() {
+            if (!ok) {
+                qWarning() << "[UI] Voter export to" << path << "failed:" << error;
+                QMessageBox::warning(this, "Export Failed", QString("Could not write %1: %2").arg(path, error));
+                return;
+            }
+            qDebug() << "[UI] Exported" << written << "voters to" << path;
+            QMessageBox::information(this, "Export Voters", QString("Exported %1 voters to %2").arg(written).arg(path));
+        }, Qt::QueuedConnection);
+    });
+}
+
 MainWindow::~MainWindow()
 {
+    // A running export reports back to this window
+    m_exporter.waitForDone();
+
     // Disconnect any remaining signals that might trigger DB usage
     disconnect(voterModel, nullptr, nullptr, nullptr);
     disconnect(partyModel, nullptr, nullptr, nullptr);
 
+    // Close any open action before the watched views go away
+    InteractionProfiler::instance().setEnabled(false);
+
+    if (!qEnvironmentVariableIsEmpty("POLITICALSIM_TRACE")) {
+        Tracer::instance().setEnabled(false);
+        Tracer::instance().exportChromeTrace(qEnvironmentVariable("POLITICALSIM_TRACE"));
+    }
+
+    if (!qEnvironmentVariableIsEmpty("POLITICALSIM_MEMORY")) {
+        memorySampler->stop();
+        memorySampler->exportJson(qEnvironmentVariable("POLITICALSIM_MEMORY"));
+    }
+
     // Delete UI first to ensure any widgets using models are gone
     delete ui;
 
@@ -267,10 +611,15 @@ MainWindow::~MainWindow()
     delete voterFocusChart;
     delete voterChart;
     delete partyChart;
+    delete popularityHistoryChart;
+    delete parliamentChart;
+    delete voterSearch;
     delete voterProxyModel;
 
+    delete simulationEngine;
     delete voterModel;
     delete partyModel;
+    delete eventLog;
 
     // Now safely close and remove the DB connection
     if (QSqlDatabase::contains("main_connection")) {
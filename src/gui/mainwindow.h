@@ -2,6 +2,7 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
+#include <QThreadPool>
 
 #include "models/PartyModel.h"
 #include "models/VoterModel.h"
@@ -9,8 +10,18 @@
 #include "widgets/VoterIdeologyChartWidget.h"
 #include "widgets/SingleVoterIdeologyWidget.h"
 #include "widgets/PartyChartWidget.h"
+#include "widgets/ParliamentChartWidget.h"
+#include "widgets/PopularityHistoryWidget.h"
 
-#include <QSortFilterProxyModel>
+#include "simulation/EventLog.h"
+#include "simulation/SimulationEngine.h"
+
+#include "search/VoterSearch.h"
+#include "search/VoterFilterProxyModel.h"
+
+#include "diagnostics/ProfilerOverlay.h"
+#include "diagnostics/MetricsDock.h"
+#include "diagnostics/MemorySampler.h"
 
 namespace Ui {
 class MainWindow;
@@ -29,10 +40,11 @@ public:
     /**
      * @brief Constructs the main application window.
      * @param parent Optional parent widget.
+     * @param dbPath SQLite database file to open (created if missing).
      *
      * Sets up the user interface, data models, proxy models, and chart widgets. Also connects signals to the UI components and populates initial data if the database is empty.
      */
-    explicit MainWindow(QWidget *parent = nullptr);
+    explicit MainWindow(QWidget *parent = nullptr, const QString &dbPath = "politicalsim.sqlite");
 
     /** @brief Destructor. Releases allocated resources. */
     ~MainWindow();
@@ -44,13 +56,30 @@ private:
     VoterModel* voterModel;                             ///< Pointer to the VoterModel.
     IdeologyModel* ideologyModel;                       ///< Pointer to the IdeologyModel.
 
-    QSortFilterProxyModel* voterProxyModel;             ///< Proxy for filtering/searching voters.
+    VoterFilterProxyModel* voterProxyModel;             ///< Proxy showing the voters found by voterSearch.
+    VoterSearch* voterSearch;                           ///< Indexed, debounced voter search running off the GUI thread.
     void setupButtonConnections();                      ///< Connects all toolbar and button signals.
+    void setupProfiler();                               ///< Sets up the profiler overlay, metrics dock and trace shortcuts.
+    void setupMemoryReport();                           ///< Registers the memory report sources and shortcut.
     void resetDatabase();                               ///< Resets all data to the built-in defaults.
+    QVector<int> selectedVoterIds() const;              ///< IDs of the voters selected in the voter table.
+    void selectVoters(const QVector<int>& voterIds);    ///< Selects the given voters in the voter table.
+    void exportVoters(const QVector<int>& voterIds);    ///< Writes the given voters to a CSV file chosen by the user.
 
     VoterIdeologyChartWidget* voterChart;               ///< Scatter-chart widget for voter ideology distribution.
     SingleVoterIdeologyWidget* voterFocusChart;         ///< Scatter-chart widget for the selected voter.
     PartyChartWidget* partyChart;                       ///< Pie-chart widget for party popularity.
+    ParliamentChartWidget* parliamentChart;             ///< Hemicycle widget for seats won across districts.
+    PopularityHistoryWidget* popularityHistoryChart;    ///< Line chart of party shares over time.
+
+    EventLog* eventLog;                                 ///< Append-only log of scenario changes and ticks.
+    SimulationEngine* simulationEngine;                 ///< Runs opinion drift ticks.
+
+    ProfilerOverlay* profilerOverlay;                   ///< Latency summaries shown over the window (Ctrl+Shift+P).
+    MetricsDock* metricsDock;                           ///< SQL, reset, signal and chart counters (Ctrl+Shift+M).
+    MemorySampler* memorySampler;                       ///< Memory held per subsystem, on demand (Ctrl+Shift+R) or sampled.
+
+    QThreadPool m_exporter;                             ///< Writes voter exports off the GUI thread; waited for on destruction.
 };
 
 #endif // MAINWINDOW_H
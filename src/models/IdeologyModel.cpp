@@ -1,9 +1,14 @@
 #include "IdeologyModel.h"
+#include "diagnostics/MeteredQuery.h"
+#include "diagnostics/MemoryReport.h"
+#include "simulation/DistanceKernels.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
 #include <QVariant>
 
+#include <algorithm>
+
 IdeologyModel::IdeologyModel(const QString& connectionName, QObject* parent)
     : QAbstractTableModel(parent), m_connectionName(connectionName)
 {
@@ -13,7 +18,7 @@ IdeologyModel::IdeologyModel(const QString& connectionName, QObject* parent)
         return;
     }
 
-    QSqlQuery query(db);
+    MeteredQuery query(db, "IdeologyModel");
     // 1. Create table if not exists
     if (!query.exec(R"(
         CREATE TABLE IF NOT EXISTS ideologies (
@@ -25,6 +30,7 @@ IdeologyModel::IdeologyModel(const QString& connectionName, QObject* parent)
     )")) {
         qWarning() << "[IdeologyModel] Table creation failed:" << query.lastError().text();
     }
+    IdeologySpace::ensureColumns(db, "ideologies", IdeologySpace::load(db).dimensions());
 
     // 2. Seed default data
     seedDefaults(db);
@@ -34,7 +40,7 @@ IdeologyModel::IdeologyModel(const QString& connectionName, QObject* parent)
 }
 
 void IdeologyModel::seedDefaults(QSqlDatabase& db) {
-    QSqlQuery count(db);
+    MeteredQuery count(db, "IdeologyModel");
     if (!count.exec("SELECT COUNT(*) FROM ideologies")) {
         qWarning() << "[IdeologyModel] Count failed:" << count.lastError().text();
         return;
@@ -47,7 +53,7 @@ void IdeologyModel::seedDefaults(QSqlDatabase& db) {
         };
 
         for (int i = 0; i < names.size(); ++i) {
-            QSqlQuery insert(db);
+            MeteredQuery insert(db, "IdeologyModel");
             insert.prepare("INSERT INTO ideologies (name, center_x, center_y) VALUES (:name, :x, :y)");
             insert.bindValue(":name", names[i]);
             insert.bindValue(":x", coords[i].first);
@@ -63,13 +69,19 @@ void IdeologyModel::loadData() {
     beginResetModel();
     m_ideologies.clear();
 
-    QSqlQuery query(QSqlDatabase::database(m_connectionName));
-    if (!query.exec("SELECT id, name, center_x, center_y FROM ideologies")) {
+    QSqlDatabase db = QSqlDatabase::database(m_connectionName);
+    m_space = IdeologySpace::load(db);
+    const int dimensions = m_space.dimensions();
+    m_centres = IdeologyPoints(dimensions);
+
+    MeteredQuery query(db, "IdeologyModel");
+    if (!query.exec("SELECT id, name, center_x, center_y" + IdeologySpace::extraColumnList(dimensions) + " FROM ideologies")) {
         qWarning() << "[IdeologyModel] Load failed:" << query.lastError();
         endResetModel();
         return;
     }
 
+    int position[IdeologySpace::kMaxDimensions];
     while (query.next()) {
         m_ideologies.append(Ideology{
             query.value(0).toInt(),
@@ -77,6 +89,9 @@ void IdeologyModel::loadData() {
             query.value(2).toInt(),
             query.value(3).toInt()
         });
+        for (int a = 0; a < dimensions; ++a)
+            position[a] = query.value(2 + a).toInt();
+        m_centres.append(position);
     }
 
     endResetModel();
@@ -115,20 +130,21 @@ QVariant IdeologyModel::headerData(int section, Qt::Orientation orientation, int
 }
 
 int IdeologyModel::findClosestIdeologyId(int x, int y) const {
-    int closestId = -1;
-    double minDist = std::numeric_limits<double>::max();
-
-    for (const Ideology& i : m_ideologies) {
-        double dx = x - i.centerX;
-        double dy = y - i.centerY;
-        double dist = dx * dx + dy * dy;
-        if (dist < minDist) {
-            minDist = dist;
-            closestId = i.id;
-        }
-    }
+    const int position[2] = { x, y };
+    return findClosestIdeologyId(position, 2);
+}
 
-    return closestId;
+int IdeologyModel::findClosestIdeologyId(const int* position, int dimensions) const {
+    const NearestPoint nearest = DistanceKernels::nearest(m_centres, position, std::min(dimensions, m_centres.dimensions()));
+    return nearest.index >= 0 ? m_ideologies[nearest.index].id : -1;
+}
+
+const IdeologySpace& IdeologyModel::space() const {
+    return m_space;
+}
+
+const IdeologyPoints& IdeologyModel::centres() const {
+    return m_centres;
 }
 
 QString IdeologyModel::getIdeologyNameById(int id) const {
@@ -141,3 +157,12 @@ const QVector<Ideology>& IdeologyModel::getIdeologies() const {
     return m_ideologies;
 }
 
+void IdeologyModel::reportMemory(MemoryReport& report) const {
+    qint64 strings = 0;
+    for (const Ideology& i : m_ideologies)
+        strings += report.stringBytes(i.name);
+    report.add("ideologies.records", MemoryReport::vectorBytes(m_ideologies), m_ideologies.size());
+    report.add("ideologies.strings", strings, m_ideologies.size());
+    report.add("ideologies.centres", m_centres.memoryBytes(), m_centres.size());
+}
+
@@ -4,6 +4,9 @@
 #include <QAbstractTableModel>
 #include <QVector>
 #include <QSqlDatabase>
+#include "IdeologySpace.h"
+#include "simulation/IdeologyPoints.h"
+class MemoryReport;
 
 /**
  * @brief Represents an ideology entry with an ID, name, and center coordinates.
@@ -83,6 +86,20 @@ public:
      */
     int findClosestIdeologyId(int x, int y) const;
 
+    /**
+     * @brief Finds the ID of the ideology closest to a point of the N-dimensional ideology space.
+     * @param position One coordinate per axis.
+     * @param dimensions Number of coordinates in @p position; axes beyond the loaded space are ignored.
+     * @return The ID of the nearest ideology, or -1 if no ideologies are loaded.
+     */
+    int findClosestIdeologyId(const int* position, int dimensions) const;
+
+    /** @brief Returns the axes of the ideology space, as read by the last loadData(). */
+    const IdeologySpace& space() const;
+
+    /** @brief Returns the centre of every loaded ideology on all axes, row-aligned with getIdeologies(). */
+    const IdeologyPoints& centres() const;
+
     /**
      * @brief Retrieves the name of an ideology by its ID.
      * @param id The ideology's database ID.
@@ -96,8 +113,13 @@ public:
      */
     const QVector<Ideology>& getIdeologies() const;
 
+    /** @brief Adds the memory held by the loaded ideologies to a report, under "ideologies.". */
+    void reportMemory(MemoryReport& report) const;
+
 private:
     QVector<Ideology> m_ideologies;             ///< Loaded ideology records.
+    IdeologySpace m_space;                      ///< Axes of the ideology space.
+    IdeologyPoints m_centres;                   ///< Centre of each ideology on every axis, one packed column per axis.
     QString m_connectionName;                   ///< SQLite connection name.
 };
 
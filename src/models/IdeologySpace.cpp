@@ -0,0 +1,123 @@
+#include "IdeologySpace.h"
+#include "diagnostics/MeteredQuery.h"
+
+#include <QSet>
+#include <QSqlError>
+#include <QVariant>
+#include <QDebug>
+
+#include <algorithm>
+
+IdeologySpace::IdeologySpace()
+    : m_axes({ "Economic", "Social" })
+{
+}
+
+IdeologySpace IdeologySpace::standard(int dimensions) {
+    static const QStringList names = { "Economic", "Social", "Foreign", "Environmental" };
+    dimensions = std::clamp(dimensions, kMinDimensions, kMaxDimensions);
+
+    IdeologySpace space;
+    space.m_axes.clear();
+    for (int a = 0; a < dimensions; ++a)
+        space.m_axes.append(a < names.size() ? names[a] : QString("Axis %1").arg(a + 1));
+    return space;
+}
+
+int IdeologySpace::dimensions() const {
+    return m_axes.size();
+}
+
+QString IdeologySpace::axisName(int axis) const {
+    return m_axes.value(axis);
+}
+
+const QStringList& IdeologySpace::axisNames() const {
+    return m_axes;
+}
+
+void IdeologySpace::setAxisName(int axis, const QString& name) {
+    if (axis >= 0 && axis < m_axes.size()) m_axes[axis] = name;
+}
+
+QString IdeologySpace::columnName(int axis) {
+    return QString("axis_%1").arg(axis);
+}
+
+QString IdeologySpace::extraColumnList(int dimensions, const QString& prefix) {
+    QString list;
+    for (int a = kMinDimensions; a < dimensions; ++a)
+        list += ", " + prefix + columnName(a);
+    return list;
+}
+
+IdeologySpace IdeologySpace::load(const QSqlDatabase& db) {
+    IdeologySpace space;
+    if (!db.isOpen() || !db.tables().contains("ideology_axes")) return space;
+
+    MeteredQuery query(db, "IdeologySpace");
+    if (!query.exec("SELECT name FROM ideology_axes ORDER BY position")) {
+        qWarning() << "[IdeologySpace] Load failed:" << query.lastError().text();
+        return space;
+    }
+    QStringList names;
+    while (query.next())
+        names.append(query.value(0).toString());
+    if (names.size() < kMinDimensions || names.size() > kMaxDimensions) {
+        qWarning() << "[IdeologySpace] Ignoring a space with" << names.size() << "axes";
+        return space;
+    }
+    space.m_axes = names;
+    return space;
+}
+
+bool IdeologySpace::save(QSqlDatabase& db, const IdeologySpace& space) {
+    if (!db.isOpen()) {
+        qWarning() << "[IdeologySpace] Save failed: DB not open";
+        return false;
+    }
+
+    db.transaction();
+    MeteredQuery query(db, "IdeologySpace");
+    query.exec("CREATE TABLE IF NOT EXISTS ideology_axes (position INTEGER PRIMARY KEY, name TEXT NOT NULL)");
+    query.exec("DELETE FROM ideology_axes");
+    query.prepare("INSERT INTO ideology_axes (position, name) VALUES (:position, :name)");
+    for (int a = 0; a < space.dimensions(); ++a) {
+        query.bindValue(":position", a);
+        query.bindValue(":name", space.axisName(a));
+        if (!query.exec()) {
+            qWarning() << "[IdeologySpace] Save failed:" << query.lastError().text();
+            db.rollback();
+            return false;
+        }
+    }
+    db.commit();
+
+    bool ok = true;
+    for (const QString& table : { QString("parties"), QString("ideologies"), QString("voters") })
+        ok = ensureColumns(db, table, space.dimensions()) && ok;
+    qDebug() << "[IdeologySpace] Saved" << space.dimensions() << "axes:" << space.axisNames();
+    return ok;
+}
+
+bool IdeologySpace::ensureColumns(QSqlDatabase& db, const QString& table, int dimensions) {
+    if (dimensions <= kMinDimensions || !db.tables().contains(table)) return true;
+
+    QSet<QString> existing;
+    MeteredQuery columns(db, "IdeologySpace");
+    if (columns.exec(QString("PRAGMA table_info(%1)").arg(table))) {
+        while (columns.next())
+            existing.insert(columns.value(1).toString());
+    }
+
+    bool ok = true;
+    MeteredQuery alter(db, "IdeologySpace");
+    for (int a = kMinDimensions; a < dimensions; ++a) {
+        if (existing.contains(columnName(a))) continue;
+        if (!alter.exec(QString("ALTER TABLE %1 ADD COLUMN %2 INTEGER NOT NULL DEFAULT 0").arg(table, columnName(a)))) {
+            qWarning() << "[IdeologySpace] Adding" << columnName(a) << "to" << table << "failed:" << alter.lastError().text();
+            ok = false;
+        }
+    }
+    return ok;
+}
@@ -0,0 +1,74 @@
+#ifndef IDEOLOGYSPACE_H
+#define IDEOLOGYSPACE_H
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief The policy axes of the ideology compass: how many there are and what they are called.
+ *
+ * @details The first two axes are the economic and social axes every table already stores (ideology_x/ideology_y for parties and
+ * voters, center_x/center_y for ideologies). Further axes live in one INTEGER column per axis, axis_2 … axis_15, added to
+ * the parties, ideologies and voters tables on demand and defaulting to 0. The axis names are kept in the `ideology_axes`
+ * table; a database without it is two-dimensional.
+ */
+class IdeologySpace {
+public:
+    static constexpr int kMinDimensions = 2;    ///< The economic and social axes.
+    static constexpr int kMaxDimensions = 16;   ///< Most axes a space may have.
+
+    /** @brief Constructs the two-dimensional space. */
+    IdeologySpace();
+
+    /**
+     * @brief Returns a space with the standard axes: economic, social, foreign, environmental, then numbered ones.
+     * @param dimensions Number of axes, clamped to [kMinDimensions, kMaxDimensions].
+     */
+    static IdeologySpace standard(int dimensions);
+
+    /** @brief Returns the number of axes. */
+    int dimensions() const;
+
+    /** @brief Returns the name of an axis. */
+    QString axisName(int axis) const;
+
+    /** @brief Returns the names of all axes, in order. */
+    const QStringList& axisNames() const;
+
+    /** @brief Renames an axis. */
+    void setAxisName(int axis, const QString& name);
+
+    /** @brief Returns the column holding an axis beyond the first two, e.g. "axis_2". */
+    static QString columnName(int axis);
+
+    /**
+     * @brief Returns ", <prefix>axis_2, <prefix>axis_3 …" for the axes beyond the first two, to append to a SELECT list.
+     * @param dimensions Number of axes of the space.
+     * @param prefix Table alias with its dot (e.g. "v."), or empty.
+     */
+    static QString extraColumnList(int dimensions, const QString& prefix = QString());
+
+    /** @brief Reads the space stored in a database; two-dimensional if none was saved. */
+    static IdeologySpace load(const QSqlDatabase& db);
+
+    /**
+     * @brief Stores a space and adds any missing axis columns to the parties, ideologies and voters tables.
+     * @return True on success.
+     */
+    static bool save(QSqlDatabase& db, const IdeologySpace& space);
+
+    /**
+     * @brief Adds the axis columns a table is missing for a space of the given size.
+     * @param db Open database.
+     * @param table Table to extend; nothing happens if it does not exist.
+     * @param dimensions Number of axes.
+     * @return True if every column exists afterwards.
+     */
+    static bool ensureColumns(QSqlDatabase& db, const QString& table, int dimensions);
+
+private:
+    QStringList m_axes;     ///< Axis names, in order.
+};
+
+#endif // IDEOLOGYSPACE_H
@@ -2,6 +2,12 @@
 #include "Voter.h"
 #include "VoterModel.h"
 #include "IdeologyModel.h"
+#include "simulation/EventLog.h"
+#include "diagnostics/InteractionProfiler.h"
+#include "diagnostics/Tracer.h"
+#include "diagnostics/MeteredQuery.h"
+#include "diagnostics/MetricsRegistry.h"
+#include "diagnostics/MemoryReport.h"
 
 #include <QSqlDatabase>
 #include <QSqlQuery>
@@ -9,12 +15,21 @@
 #include <QVariant>
 #include <QDebug>
 
+#include <algorithm>
+
 //  Custom constructor
 PartyModel::PartyModel(const QString &connectionName, QObject *parent, bool seedDefaults, const QString &dbPath)
     : QAbstractTableModel(parent), m_connectionName(connectionName)
 {
     Q_ASSERT(!connectionName.isEmpty());  // Prevent accidental usage
 
+    MetricsRegistry& metrics = MetricsRegistry::instance();
+    metrics.countEmissions(this, &QAbstractItemModel::modelAboutToBeReset, "model.PartyModel.resets");
+    metrics.countEmissions(this, &PartyModel::partyAdded, "signal.PartyModel::partyAdded");
+    metrics.countEmissions(this, &PartyModel::partyUpdated, "signal.PartyModel::partyUpdated");
+    metrics.countEmissions(this, &PartyModel::partyDeleted, "signal.PartyModel::partyDeleted");
+    metrics.countEmissions(this, &PartyModel::dataChangedExternally, "signal.PartyModel::dataChangedExternally");
+
     qDebug() << "[PartyModel] Connection name: " << m_connectionName;
 
     if (QSqlDatabase::contains(m_connectionName)) {
@@ -31,7 +46,7 @@ PartyModel::PartyModel(const QString &connectionName, QObject *parent, bool seed
         return;
     }
 
-    QSqlQuery query(db);
+    MeteredQuery query(db, "PartyModel");
     query.exec("CREATE TABLE IF NOT EXISTS parties ("
                "id INTEGER PRIMARY KEY AUTOINCREMENT, "
                "name TEXT, "
@@ -39,6 +54,7 @@ PartyModel::PartyModel(const QString &connectionName, QObject *parent, bool seed
                "ideology_x INTEGER, "
                "ideology_y INTEGER, "
                "FOREIGN KEY(ideology_id) REFERENCES ideologies(id) ON DELETE SET NULL)");
+    IdeologySpace::ensureColumns(db, "parties", IdeologySpace::load(db).dimensions());
 
     if (seedDefaults)
         ensurePartiesPopulated(db);
@@ -48,6 +64,23 @@ const QVector<Party>& PartyModel::getAllParties() const {
     return m_parties;
 }
 
+const IdeologySpace& PartyModel::space() const {
+    return m_space;
+}
+
+const IdeologyPoints& PartyModel::positions() const {
+    return m_positions;
+}
+
+void PartyModel::reportMemory(MemoryReport& report) const {
+    qint64 strings = 0;
+    for (const Party& p : m_parties)
+        strings += report.stringBytes(p.name) + report.stringBytes(p.ideology);
+    report.add("parties.records", MemoryReport::vectorBytes(m_parties), m_parties.size());
+    report.add("parties.strings", strings, m_parties.size());
+    report.add("parties.positions", m_positions.memoryBytes(), m_positions.size());
+}
+
 int PartyModel::rowCount(const QModelIndex &) const {
     return m_parties.size();
 }
@@ -91,17 +124,22 @@ QVariant PartyModel::headerData(int section, Qt::Orientation orientation, int ro
 }
 
 void PartyModel::addParty(const Party &party) {
+    TRACE_SCOPE("model", "PartyModel::addParty");
     QSqlDatabase db = QSqlDatabase::database(m_connectionName);
     if (!db.isOpen()) {
         qWarning() << "[PartyModel] addParty: DB not open";
         return;
     }
 
-    QSqlQuery query(db);
+    // A new party sits at 0 on every axis beyond the first two, like a new voter
+    Party added = party;
+    if (ideologyModel) added.ideologyId = closestIdeologyId(-1, party.ideologyX, party.ideologyY);
+
+    MeteredQuery query(db, "PartyModel");
     query.prepare("INSERT INTO parties (name, ideology_id, ideology_x, ideology_y) "
                   "VALUES (:name, :ideology_id, :ix, :iy)");
-    query.bindValue(":name", party.name);
-    query.bindValue(":ideology_id", party.ideologyId);
+    query.bindValue(":name", added.name);
+    query.bindValue(":ideology_id", added.ideologyId);
     query.bindValue(":ix", party.ideologyX);
     query.bindValue(":iy", party.ideologyY);
 
@@ -109,6 +147,10 @@ void PartyModel::addParty(const Party &party) {
         qWarning() << "[PartyModel] Insert failed:" << query.lastError().text();
         return;
     }
+    if (eventLog) {
+        added.id = query.lastInsertId().toInt();
+        eventLog->recordPartyChanged(added);
+    }
     emit partyAdded();
     if (voterModel) {
         voterModel->reassignAllVoterParties();
@@ -118,8 +160,11 @@ void PartyModel::addParty(const Party &party) {
 }
 
 void PartyModel::reloadData() {
+    ProfileScope profile("model/PartyModel::reloadData");
+    TRACE_SCOPE("model", "PartyModel::reloadData");
     beginResetModel();
     m_parties.clear();
+    m_positions.clear();
 
     QSqlDatabase db = QSqlDatabase::database(m_connectionName);
     if (!db.isOpen()) {
@@ -128,8 +173,18 @@ void PartyModel::reloadData() {
         return;
     }
 
-    QSqlQuery query(db);
-    if (!query.exec("SELECT id, name, ideology_id, ideology_x, ideology_y FROM parties")) {
+    m_space = IdeologySpace::load(db);
+    const int dimensions = m_space.dimensions();
+    m_positions = IdeologyPoints(dimensions);
+
+    MeteredQuery query(db, "PartyModel");
+    bool ok = false;
+    {
+        TRACE_SCOPE("db", "SELECT parties");
+        ok = query.exec("SELECT id, name, ideology_id, ideology_x, ideology_y"
+                        + IdeologySpace::extraColumnList(dimensions) + " FROM parties");
+    }
+    if (!ok) {
         qWarning() << "[PartyModel] reloadData failed:" << query.lastError().text();
         endResetModel();
         return;
@@ -143,20 +198,26 @@ void PartyModel::reloadData() {
         party.ideologyX = query.value(3).toInt();
         party.ideologyY = query.value(4).toInt();
         m_parties.append(party);
+
+        int position[IdeologySpace::kMaxDimensions];
+        for (int a = 0; a < dimensions; ++a)
+            position[a] = query.value(3 + a).toInt();
+        m_positions.append(position);
     }
     endResetModel();
     emit layoutChanged();
+    TRACE_COUNTER("model", "parties", m_parties.size());
 }
 
 bool PartyModel::ensurePartiesPopulated(QSqlDatabase& db) {
-    QSqlQuery countQuery(db);
+    MeteredQuery countQuery(db, "PartyModel");
     if (!countQuery.exec("SELECT COUNT(*) FROM parties")) {
         qWarning() << "[PartyModel] Count query failed:" << countQuery.lastError().text();
         return false;
     }
 
     if (countQuery.next() && countQuery.value(0).toInt() == 0) {
-        QSqlQuery insert(db);
+        MeteredQuery insert(db, "PartyModel");
         QStringList insertStmts = {
             "INSERT INTO parties (name, ideology_id, ideology_x, ideology_y) VALUES ('Unity Party', 1, 0, 0)",
             "INSERT INTO parties (name, ideology_id, ideology_x, ideology_y) VALUES ('Green Force', 2, -50, -50)",
@@ -183,12 +244,15 @@ int PartyModel::getPartyIdAt(int row) const {
 }
 
 void PartyModel::deletePartyById(int partyId) {
+    TRACE_SCOPE("model", "PartyModel::deletePartyById");
     QSqlDatabase db = QSqlDatabase::database(m_connectionName);
-    QSqlQuery query(db);
+    MeteredQuery query(db, "PartyModel");
     query.prepare("DELETE FROM parties WHERE id = :id");
     query.bindValue(":id", partyId);
     if (!query.exec()) {
         qWarning() << "[PartyModel] Delete failed:" << query.lastError().text();
+    } else if (eventLog) {
+        eventLog->recordPartyRemoved(partyId);
     }
     emit partyDeleted();
     if (voterModel) {
@@ -199,23 +263,34 @@ void PartyModel::deletePartyById(int partyId) {
 }
 
 void PartyModel::updateParty(int id, const Party &updatedParty) {
+    TRACE_SCOPE("model", "PartyModel::updateParty");
     QSqlDatabase db = QSqlDatabase::database(m_connectionName);
     if (!db.isOpen()) {
         qWarning() << "[PartyModel] Update failed: DB not open";
         return;
     }
 
-    QSqlQuery query(db);
+    Party updated = updatedParty;
+    updated.id = id;
+    if (ideologyModel) {
+        const auto it = std::find_if(m_parties.cbegin(), m_parties.cend(), [id](const Party& p) { return p.id == id; });
+        updated.ideologyId = closestIdeologyId(it != m_parties.cend() ? int(it - m_parties.cbegin()) : -1,
+                                               updated.ideologyX, updated.ideologyY);
+    }
+
+    MeteredQuery query(db, "PartyModel");
     query.prepare("UPDATE parties SET name = :name, ideology_id = :ideology_id, "
                   "ideology_x = :ix, ideology_y = :iy WHERE id = :id");
-    query.bindValue(":name", updatedParty.name);
-    query.bindValue(":ideology_id", updatedParty.ideologyId);
+    query.bindValue(":name", updated.name);
+    query.bindValue(":ideology_id", updated.ideologyId);
     query.bindValue(":ix", updatedParty.ideologyX);
     query.bindValue(":iy", updatedParty.ideologyY);
     query.bindValue(":id", id);
 
     if (!query.exec()) {
         qWarning() << "[PartyModel] Update failed:" << query.lastError().text();
+    } else if (eventLog) {
+        eventLog->recordPartyChanged(updated);
     }
     emit partyUpdated();
     if (voterModel) {
@@ -225,6 +300,107 @@ void PartyModel::updateParty(int id, const Party &updatedParty) {
     //reloadData();
 }
 
+void PartyModel::updatePartyPositions(const QVector<Party>& parties) {
+    TRACE_SCOPE("model", "PartyModel::updatePartyPositions");
+    QSqlDatabase db = QSqlDatabase::database(m_connectionName);
+    if (!db.isOpen()) {
+        qWarning() << "[PartyModel] Update failed: DB not open";
+        return;
+    }
+
+    db.transaction();
+    MeteredQuery query(db, "PartyModel");
+    query.prepare("UPDATE parties SET ideology_id = COALESCE(:ideology_id, ideology_id), "
+                  "ideology_x = :ix, ideology_y = :iy WHERE id = :id");
+    QVector<Party> logged;
+    for (const Party& party : parties) {
+        // Only the first two axes move; the nearest ideology is searched with the party's stored extra axes
+        const auto it = std::find_if(m_parties.cbegin(), m_parties.cend(), [&party](const Party& p) { return p.id == party.id; });
+        const int row = it != m_parties.cend() ? int(it - m_parties.cbegin()) : -1;
+        const int ideologyId = closestIdeologyId(row, party.ideologyX, party.ideologyY);
+        if (eventLog) {
+            logged.append(party);
+            if (ideologyId != -1) logged.last().ideologyId = ideologyId;
+        }
+        query.bindValue(":ideology_id", ideologyId != -1 ? QVariant(ideologyId) : QVariant());
+        query.bindValue(":ix", party.ideologyX);
+        query.bindValue(":iy", party.ideologyY);
+        query.bindValue(":id", party.id);
+        if (!query.exec()) {
+            qWarning() << "[PartyModel] Update failed:" << query.lastError().text();
+            db.rollback();
+            return;
+        }
+    }
+    db.commit();
+
+    for (const Party& party : logged)
+        eventLog->recordPartyChanged(party);
+
+    emit partyUpdated();
+    if (voterModel) {
+        voterModel->reassignAllVoterParties();
+    }
+    emit dataChangedExternally();
+}
+
+int PartyModel::closestIdeologyId(int row, int x, int y) const {
+    if (!ideologyModel) return -1;
+    const int dimensions = std::max(m_positions.dimensions(), IdeologySpace::kMinDimensions);
+    int position[IdeologySpace::kMaxDimensions];
+    for (int a = IdeologySpace::kMinDimensions; a < dimensions; ++a)
+        position[a] = row >= 0 && row < m_positions.size() ? m_positions.coordinate(row, a) : 0;
+    position[0] = x;
+    position[1] = y;
+    return ideologyModel->findClosestIdeologyId(position, dimensions);
+}
+
+void PartyModel::setPartyPosition(int id, const QVector<int>& position) {
+    TRACE_SCOPE("model", "PartyModel::setPartyPosition");
+    QSqlDatabase db = QSqlDatabase::database(m_connectionName);
+    if (!db.isOpen()) {
+        qWarning() << "[PartyModel] Update failed: DB not open";
+        return;
+    }
+    const int axes = std::min<int>(position.size(), IdeologySpace::load(db).dimensions());
+    if (axes < IdeologySpace::kMinDimensions) {
+        qWarning() << "[PartyModel] setPartyPosition needs at least" << IdeologySpace::kMinDimensions << "coordinates";
+        return;
+    }
+
+    const int ideologyId = ideologyModel ? ideologyModel->findClosestIdeologyId(position.constData(), axes) : -1;
+    QString assignments = "ideology_id = COALESCE(:ideology_id, ideology_id), ideology_x = :a0, ideology_y = :a1";
+    for (int a = IdeologySpace::kMinDimensions; a < axes; ++a)
+        assignments += QString(", %1 = :a%2").arg(IdeologySpace::columnName(a)).arg(a);
+
+    MeteredQuery query(db, "PartyModel");
+    query.prepare("UPDATE parties SET " + assignments + " WHERE id = :id");
+    query.bindValue(":ideology_id", ideologyId != -1 ? QVariant(ideologyId) : QVariant());
+    for (int a = 0; a < axes; ++a)
+        query.bindValue(QString(":a%1").arg(a), position[a]);
+    query.bindValue(":id", id);
+
+    if (!query.exec()) {
+        qWarning() << "[PartyModel] Update failed:" << query.lastError().text();
+        return;
+    }
+    if (eventLog) {
+        auto it = std::find_if(m_parties.cbegin(), m_parties.cend(), [id](const Party& p) { return p.id == id; });
+        if (it != m_parties.cend()) {
+            Party logged = *it;
+            logged.ideologyX = position[0];
+            logged.ideologyY = position[1];
+            if (ideologyId != -1) logged.ideologyId = ideologyId;
+            eventLog->recordPartyChanged(logged);
+        }
+    }
+    emit partyUpdated();
+    if (voterModel) {
+        voterModel->reassignAllVoterParties();
+    }
+    emit dataChangedExternally();
+}
+
 Party PartyModel::getPartyAt(int row) const {
     if (row < 0 || row >= m_parties.size()) return {};
     return m_parties[row];
@@ -233,10 +409,29 @@ Party PartyModel::getPartyAt(int row) const {
 double PartyModel::calculatePopularity(int partyId) const {
     int total = voterModel->totalVoters();
     if (total == 0) return 0.0;
-    int countForThis = voterModel->countVotersPerParty().value(partyId, 0);
+    int countForThis = voterModel->votersForParty(partyId);
     return (countForThis * 100.0) / total;
 }
 
+QMap<int, double> PartyModel::popularitySnapshot() const {
+    QMap<int, double> popularity;
+    if (!voterModel) return popularity;
+    const int total = voterModel->totalVoters();
+    if (total == 0) return popularity;
+
+    const QMap<int, int> counts = voterModel->countVotersPerParty();
+    for (auto it = counts.cbegin(); it != counts.cend(); ++it)
+        popularity.insert(it.key(), it.value() * 100.0 / total);
+    return popularity;
+}
+
+void PartyModel::popularityShares(QVector<double>& shares) const {
+    shares.resize(m_parties.size());
+    const int total = voterModel ? voterModel->totalVoters() : 0;
+    for (int row = 0; row < m_parties.size(); ++row)
+        shares[row] = total > 0 ? voterModel->votersForParty(m_parties[row].id) * 100.0 / total : 0.0;
+}
+
 void PartyModel::setVoterModel(VoterModel* model) {
     voterModel = model;
     connect(model, &VoterModel::voterAdded,    this, &PartyModel::recalculatePopularityFromVoters);
@@ -245,6 +440,8 @@ void PartyModel::setVoterModel(VoterModel* model) {
 }
 
 void PartyModel::recalculatePopularityFromVoters() {
+    ProfileScope profile("model/PartyModel::recalculatePopularityFromVoters");
+    TRACE_SCOPE("model", "PartyModel::recalculatePopularityFromVoters");
     if (!voterModel) return;
     if (m_parties.isEmpty()) return;
     // Notify that all parties' popularity data has changed (column 2 in the model)
@@ -256,3 +453,7 @@ void PartyModel::recalculatePopularityFromVoters() {
 void PartyModel::setIdeologyModel(const IdeologyModel* model) {
     ideologyModel = model;
 }
+
+void PartyModel::setEventLog(EventLog* log) {
+    eventLog = log;
+}
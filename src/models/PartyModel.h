@@ -2,6 +2,8 @@
 #define PARTYMODEL_H
 
 #include "Voter.h"
+#include "IdeologySpace.h"
+#include "simulation/IdeologyPoints.h"
 
 #include <QAbstractTableModel>
 #include <QString>
@@ -9,6 +11,8 @@
 #include <QSqlDatabase>
 class VoterModel;
 class IdeologyModel;
+class EventLog;
+class MemoryReport;
 
 /**
  * @brief Data structure representing a political party.
@@ -77,7 +81,8 @@ public:
      * @brief Adds a new party to the database and model.
      * @param party The Party struct containing the party's name and ideology.
      *
-     * Inserts a new party into the database and emits a signal to update the model view.
+     * Inserts a new party into the database and emits a signal to update the model view. With an IdeologyModel linked, the
+     * party's ideology is the one nearest its position on every axis (0 on the axes beyond the first two), not the one in @p party.
      */
     void addParty(const Party& party);
 
@@ -87,9 +92,27 @@ public:
      * @param updatedParty A Party struct with the new details for the party.
      *
      * Applies the changes to the database for the given party ID and refreshes the model. Emits `partyUpdated` on success.
+     * With an IdeologyModel linked, the ideology is matched on every axis, keeping the party's stored extra coordinates.
      */
     void updateParty(int id, const Party &updatedParty);
 
+    /**
+     * @brief Moves several parties at once.
+     * @param parties Parties whose coordinates should be stored; only the ID and X/Y coordinates are used.
+     *
+     * Writes all positions in one transaction, re-derives each party's nearest ideology and reassigns voters once. Emits `partyUpdated` on success.
+     */
+    void updatePartyPositions(const QVector<Party>& parties);
+
+    /**
+     * @brief Moves a party to a point of the N-dimensional ideology space.
+     * @param id The ID of the party to move.
+     * @param position One coordinate per axis; axes beyond the stored space are ignored, missing ones keep their value.
+     *
+     * Re-derives the party's nearest ideology on all axes and reassigns voters. Emits `partyUpdated` on success.
+     */
+    void setPartyPosition(int id, const QVector<int>& position);
+
     /**
      * @brief Removes a party from the database and model by its ID.
      * @param partyId The ID of the party to remove.
@@ -116,6 +139,15 @@ public:
      */
     const QVector<Party>& getAllParties() const;
 
+    /** @brief Returns the axes of the ideology space, as read by the last reloadData(). */
+    const IdeologySpace& space() const;
+
+    /** @brief Returns the position of every loaded party on all axes, row-aligned with getAllParties(). */
+    const IdeologyPoints& positions() const;
+
+    /** @brief Adds the memory held by the loaded parties to a report, under "parties.". */
+    void reportMemory(MemoryReport& report) const;
+
     /**
      * @brief Retrieves the Party at the specified row.
      * @param row The index of the row.
@@ -137,6 +169,21 @@ public:
      */
     double calculatePopularity(const int partyId) const;
 
+    /**
+     * @brief Calculates the popularity of every party from one tally of the voters.
+     * @return A map of party ID to popularity percentage; parties without voters are absent.
+     */
+    QMap<int, double> popularitySnapshot() const;
+
+    /**
+     * @brief Writes the popularity percentage of every party, in row order, into a buffer kept by the caller.
+     * @param shares Resized to rowCount(); a buffer reused across calls stops allocating once it has grown to the party count.
+     *
+     * Reads the voter model's running per-party counts, so unlike popularitySnapshot() it builds no map. Meant for callers
+     * that refresh on every tick, such as the popularity charts.
+     */
+    void popularityShares(QVector<double>& shares) const;
+
     /**
      * @brief Sets the associated VoterModel for this PartyModel.
      * @param model Pointer to the VoterModel providing voter data.
@@ -149,6 +196,12 @@ public:
      */
     void setIdeologyModel(const IdeologyModel* model);
 
+    /**
+     * @brief Sets the event log that party additions, edits and deletions are appended to.
+     * @param log Pointer to the EventLog, or nullptr to stop logging.
+     */
+    void setEventLog(EventLog* log);
+
 public slots:
     /**
      * @brief Recalculate party popularity based on current voters and refresh views.
@@ -158,12 +211,22 @@ public slots:
     void recalculatePopularityFromVoters();
 
 private:
+    /**
+     * @brief Finds the ideology nearest a party placed at (x, y) on the first two axes.
+     * @param row Row of the party whose stored extra axes are kept, or -1 for a new party (0 on every extra axis).
+     * @return The ideology ID, or -1 if no IdeologyModel is linked.
+     */
+    int closestIdeologyId(int row, int x, int y) const;
+
     QVector<Party> m_parties;             ///< List of Party records currently loaded.
+    IdeologySpace m_space;                ///< Axes of the ideology space.
+    IdeologyPoints m_positions;           ///< Position of each party on every axis, one packed column per axis.
     QString m_connectionName;             ///< Database connection name.
     QString m_dbPath;                     ///< File path of the SQLite database.
 
     const IdeologyModel* ideologyModel = nullptr;    ///< Pointer to the IdeologyModel (for ideology data).
     VoterModel* voterModel = nullptr;          ///< Pointer to the VoterModel (for voter data).
+    EventLog* eventLog = nullptr;              ///< Pointer to the EventLog recording party changes (optional).
 };
 
 #endif // PARTYMODEL_H
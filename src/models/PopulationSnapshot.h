@@ -0,0 +1,47 @@
+#ifndef POPULATIONSNAPSHOT_H
+#define POPULATIONSNAPSHOT_H
+
+#include <QHash>
+#include <QVector>
+
+#include <memory>
+
+#include "Voter.h"
+#include "IdeologySpace.h"
+#include "simulation/IdeologyPoints.h"
+
+/**
+ * @brief Immutable copy of the voter population, taken by VoterModel::captureSnapshot() for readers on any thread.
+ *
+ * @details A snapshot never changes after it is taken, so any number of threads can read it without locking while the model
+ * goes on editing its live rows. The voter list is implicitly shared with the model's own list: taking a snapshot copies only
+ * the packed extra-axis columns (one byte per voter and axis), and the model pays for one copy of its rows on its next in-place
+ * edit while the snapshot is held, which it makes on its own thread.
+ *
+ * Readers hold a snapshot through a shared pointer; it stays valid until the last holder drops it.
+ */
+struct PopulationSnapshot {
+    using Ptr = std::shared_ptr<const PopulationSnapshot>;   ///< How snapshots are handed out.
+
+    QVector<Voter> voters;              ///< Every voter, in model row order.
+    IdeologyPoints extraAxes;           ///< Coordinates on the axes beyond the first two, row-aligned with voters.
+    QHash<int, int> partyCounts;        ///< Number of voters per party ID (parties without voters are absent).
+    int districtCount = 0;              ///< Number of electoral districts voters are spread across.
+
+    /** @brief Returns the number of voters. */
+    int size() const { return voters.size(); }
+
+    /** @brief Returns one coordinate of the voter at a row, like VoterModel::coordinate(). */
+    int coordinate(int row, int axis) const {
+        if (row < 0 || row >= voters.size()) return 0;
+        if (axis == 0) return voters[row].ideologyX;
+        if (axis == 1) return voters[row].ideologyY;
+        const int extra = axis - IdeologySpace::kMinDimensions;
+        return extra >= 0 && extra < extraAxes.dimensions() ? extraAxes.coordinate(row, extra) : 0;
+    }
+
+    /** @brief Returns the number of voters affiliated with a party. */
+    int votersForParty(int partyId) const { return partyCounts.value(partyId); }
+};
+
+#endif // POPULATIONSNAPSHOT_H
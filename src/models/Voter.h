@@ -15,6 +15,7 @@ struct Voter {
     QString partyName;          ///< Name of the party the voter is affiliated with.
     int ideologyX = 0;          ///< X (economic) axis coordinate of the voter's ideology.
     int ideologyY = 0;          ///< Y (social) axis coordinate of the voter's ideology.
+    int districtId = -1;        ///< Index of the electoral district the voter belongs to (-1 if unassigned).
 
     /** @brief Default constructor. Initializes a Voter with default values. */
     Voter() = default;
@@ -2,18 +2,39 @@
 #include "VoterModel.h"
 #include "PartyModel.h"
 #include "IdeologyModel.h"
+#include "simulation/DistanceKernels.h"
+#include "simulation/EventLog.h"
+#include "simulation/TaskScheduler.h"
+#include "simulation/TickArena.h"
+#include "diagnostics/InteractionProfiler.h"
+#include "diagnostics/Tracer.h"
+#include "diagnostics/MeteredQuery.h"
+#include "diagnostics/MetricsRegistry.h"
+#include "diagnostics/MemoryReport.h"
 
 #include <QSqlDatabase>
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QVariant>
+#include <QSet>
 #include <QDebug>
 
+#include <algorithm>
+#include <atomic>
+
 VoterModel::VoterModel(const QString &connectionName, QObject *parent, const QString &dbPath)
-    : QAbstractTableModel(parent), m_connectionName(connectionName)
+    : QAbstractTableModel(parent), m_connectionName(connectionName),
+      m_lazyNames(qEnvironmentVariableIntValue("POLITICALSIM_LAZY_NAMES") > 0), m_nameCache(kNameCacheRows)
 {
     Q_ASSERT(!m_connectionName.isEmpty());
 
+    MetricsRegistry& metrics = MetricsRegistry::instance();
+    metrics.countEmissions(this, &QAbstractItemModel::modelAboutToBeReset, "model.VoterModel.resets");
+    metrics.countEmissions(this, &VoterModel::voterAdded, "signal.VoterModel::voterAdded");
+    metrics.countEmissions(this, &VoterModel::voterUpdated, "signal.VoterModel::voterUpdated");
+    metrics.countEmissions(this, &VoterModel::voterDeleted, "signal.VoterModel::voterDeleted");
+    metrics.countEmissions(this, &VoterModel::votersReset, "signal.VoterModel::votersReset");
+
     if (QSqlDatabase::contains(m_connectionName)) {
         QSqlDatabase db = QSqlDatabase::database(m_connectionName, false);
         if (db.isValid()) db.close();
@@ -28,10 +49,14 @@ VoterModel::VoterModel(const QString &connectionName, QObject *parent, const QSt
         return;
     }
 
-    QSqlQuery pragma(db);
+    MeteredQuery pragma(db, "VoterModel");
     pragma.exec("PRAGMA foreign_keys = ON");
 
-    QSqlQuery query(db);
+    MeteredQuery query(db, "VoterModel");
+    query.exec("CREATE TABLE IF NOT EXISTS districts ("
+               "id INTEGER PRIMARY KEY, "
+               "name TEXT)");
+
     query.exec("CREATE TABLE IF NOT EXISTS voters ("
                "id INTEGER PRIMARY KEY AUTOINCREMENT, "
                "name TEXT, "
@@ -39,28 +64,25 @@ VoterModel::VoterModel(const QString &connectionName, QObject *parent, const QSt
                "ideology_x INTEGER, "
                "ideology_y INTEGER, "
                "party_id INTEGER, "
+               "district_id INTEGER, "
                "FOREIGN KEY(party_id) REFERENCES parties(id) ON DELETE SET NULL,"
                "FOREIGN KEY(ideologyId) REFERENCES ideologies(id) ON DELETE SET NULL)");
 
-    query.exec(R"(
-        SELECT v.id, v.name, i.name, v.ideologyId, v.ideology_x, v.ideology_y, v.party_id, p.name
-        FROM voters v
-        LEFT JOIN ideologies i ON v.ideologyId = i.id
-        LEFT JOIN parties p ON v.party_id = p.id
-    )");
-
-    while (query.next()) {
-        Voter v;
-        v.id = query.value(0).toInt();
-        v.name = query.value(1).toString();
-        v.ideology = query.value(2).toString();
-        v.ideologyId = query.value(3).toInt();
-        v.ideologyX = query.value(4).toInt();
-        v.ideologyY = query.value(5).toInt();
-        v.partyId = query.value(6).isNull() ? -1 : query.value(6).toInt();
-        v.partyName = query.value(7).toString();
-        m_voters.append(v);
+    // Databases created before electoral districts existed lack the district column
+    bool hasDistrictColumn = false;
+    MeteredQuery columns(db, "VoterModel");
+    if (columns.exec("PRAGMA table_info(voters)")) {
+        while (columns.next()) {
+            if (columns.value(1).toString() == "district_id") hasDistrictColumn = true;
+        }
+    }
+    if (!hasDistrictColumn && !query.exec("ALTER TABLE voters ADD COLUMN district_id INTEGER")) {
+        qWarning() << "[VoterModel] Adding district column failed:" << query.lastError().text();
     }
+    IdeologySpace::ensureColumns(db, "voters", IdeologySpace::load(db).dimensions());
+
+    fetchRows(db);
+    rebuildIndexes();
 }
 
 int VoterModel::rowCount(const QModelIndex &) const {
@@ -76,7 +98,16 @@ QVariant VoterModel::data(const QModelIndex &index, int role) const {
 
     const Voter& voter = m_voters.at(index.row());
 
-    if (role == Qt::DisplayRole) {
+    if (role == Qt::DisplayRole && m_lazyNames) {
+        switch (index.column()) {
+        case 0: return voterName(index.row());
+        case 1: return ideologyModel ? ideologyModel->getIdeologyNameById(voter.ideologyId) : QString();
+        case 2: {
+            const QString party = partyNameOf(voter.partyId);
+            return party.isEmpty() ? "N/A" : party;
+        }
+        }
+    } else if (role == Qt::DisplayRole) {
         switch (index.column()) {
         case 0: return voter.name;
         case 1: return voter.ideology;                           // ideology name
@@ -98,76 +129,102 @@ QVariant VoterModel::headerData(int section, Qt::Orientation orientation, int ro
 }
 
 void VoterModel::addVoter(const Voter &voter) {
+    TRACE_SCOPE("model", "VoterModel::addVoter");
     QSqlDatabase db = QSqlDatabase::database(m_connectionName);
     if (!db.isOpen()) {
         qWarning() << "[VoterModel] Add failed: DB not open";
         return;
     }
 
-    QSqlQuery query(db);
+    // A new voter starts at 0 on the extra axes, like the column default; party and ideology follow all of them
+    Voter added = voter;
+    assignNearest(added, -1);
+
+    MeteredQuery query(db, "VoterModel");
     query.prepare(R"(
-    INSERT INTO voters (name, ideologyId, ideology_x, ideology_y, party_id)
-    VALUES (:name, :ideologyId, :ix, :iy, :partyId)
+    INSERT INTO voters (name, ideologyId, ideology_x, ideology_y, party_id, district_id)
+    VALUES (:name, :ideologyId, :ix, :iy, :partyId, :districtId)
     )");
-    query.bindValue(":name", voter.name);
-    query.bindValue(":ideologyId", voter.ideologyId);
-    query.bindValue(":ix", voter.ideologyX);
-    query.bindValue(":iy", voter.ideologyY);
-    query.bindValue(":partyId", voter.partyId);
-    if (voter.partyId != -1) {
-        query.bindValue(":party_id", voter.partyId);
+    query.bindValue(":name", added.name);
+    query.bindValue(":ideologyId", added.ideologyId);
+    query.bindValue(":ix", added.ideologyX);
+    query.bindValue(":iy", added.ideologyY);
+    if (added.partyId != -1) {
+        query.bindValue(":partyId", added.partyId);
     } else {
-        query.bindValue(":party_id", QVariant(QVariant::Int)); // NULL
+        query.bindValue(":partyId", QVariant(QVariant::Int)); // NULL
     }
+    query.bindValue(":districtId", added.districtId >= 0 ? QVariant(added.districtId) : QVariant());
 
     if (!query.exec()) {
         qWarning() << "[VoterModel] Insert failed:" << query.lastError().text();
         return;
     }
 
+    added.id = query.lastInsertId().toInt();
+
+    // New voters join the district their ID hashes to once districts have been drawn
+    if (added.districtId < 0 && m_districtCount > 0) {
+        added.districtId = districtForVoter(added.id, m_districtCount);
+        MeteredQuery district(db, "VoterModel");
+        district.prepare("UPDATE voters SET district_id = :district WHERE id = :id");
+        district.bindValue(":district", added.districtId);
+        district.bindValue(":id", added.id);
+        if (!district.exec())
+            qWarning() << "[VoterModel] District update failed:" << district.lastError().text();
+    }
+
+    // Patch the loaded rows instead of reloading the whole table
+    resolveNames(added);
+    const int row = m_voters.size();
+    beginInsertRows(QModelIndex(), row, row);
+    if (m_lazyNames) {
+        Voter stored = added;
+        stored.name.clear();
+        stored.ideology.clear();
+        stored.partyName.clear();
+        m_voters.append(stored);
+        invalidateNamesAt(row);
+    } else {
+        m_voters.append(added);
+    }
+    m_extraAxes.append(nullptr);       // new voters start at 0 on the extra axes, like the column default
+    m_rowById.insert(added.id, row);
+    m_histogram.add(added.ideologyX, added.ideologyY);
+    m_spatialIndex.insert(added.id, added.ideologyX, added.ideologyY);
+    countParty(added.partyId, 1);
+    endInsertRows();
+
+    if (eventLog) eventLog->recordVoterChanged(added);
+    emit voterInserted(added);
     emit voterAdded();
-    //reloadData();
 }
 
 void VoterModel::reloadData() {
+    ProfileScope profile("model/VoterModel::reloadData");
+    TRACE_SCOPE("model", "VoterModel::reloadData");
     beginResetModel();
     m_voters.clear();
+    const int districtsBefore = m_districtCount;
 
-    QSqlQuery query(QSqlDatabase::database(m_connectionName));
-    if (!query.exec(R"(
-    SELECT v.id, v.name, i.name AS ideologyName, v.ideologyId, v.ideology_x, v.ideology_y,
-           v.party_id, p.name AS partyName
-    FROM voters v
-    LEFT JOIN ideologies i ON v.ideologyId = i.id
-    LEFT JOIN parties p ON v.party_id = p.id
-    )"))
-     {
-        qWarning() << "[VoterModel] reloadData failed:" << query.lastError().text();
+    if (!fetchRows(QSqlDatabase::database(m_connectionName))) {
+        rebuildIndexes();
         endResetModel();
+        emit votersReset();
         return;
     }
 
-    while (query.next()) {
-        Voter v;
-        v.id = query.value(0).toInt();
-        v.name = query.value(1).toString();
-        v.ideologyId = query.value(3).toInt();
-        v.ideology = query.value(2).toString();
-        v.ideologyX = query.value(4).toInt();
-        v.ideologyY = query.value(5).toInt();
-        v.partyId = query.value(6).isNull() ? -1 : query.value(6).toInt();
-        v.partyName = query.value(7).toString();
-
-        m_voters.append(v);
-    }
-
+    rebuildIndexes();
     endResetModel();
     emit layoutChanged();
-    qDebug() << "[VoterModel] reloadData completed. Rows:" << m_voters.size();
+    emit votersReset();
+    if (m_districtCount != districtsBefore) emit districtsChanged();    // e.g. the districts table was cleared
+    TRACE_COUNTER("model", "voters", m_voters.size());
 }
 
 bool VoterModel::ensureVotersPopulated(QSqlDatabase& db, const QMap<QString, int>& partyNameToId) {
-    QSqlQuery countQuery(db);
+    TRACE_SCOPE("model", "VoterModel::ensureVotersPopulated");
+    MeteredQuery countQuery(db, "VoterModel");
     if (!countQuery.exec("SELECT COUNT(*) FROM voters")) {
         qWarning() << "[ensureVotersPopulated] Count query failed:"
                    << countQuery.lastError().text();
@@ -237,17 +294,19 @@ bool VoterModel::ensureVotersPopulated(QSqlDatabase& db, const QMap<QString, int
             { -1, "Leah Coleman", "", -1, -1, "", 74, 62 }
         };
 
-        // Assign correct partyId based on ideology
+        // Assign correct partyId based on ideology; the seeded voters sit at 0 on any further axes
+        int position[IdeologySpace::kMaxDimensions] = {};
+        const int dimensions = IdeologySpace::load(db).dimensions();
         for (Voter& v : defaults) {
-            v.partyId = findClosestPartyId(v.ideologyX, v.ideologyY);
-            qDebug() << "Assigning voter to party ID:" << v.partyId;
-
-            v.ideologyId = ideologyModel->findClosestIdeologyId(v.ideologyX, v.ideologyY);
-            qDebug() << "Assigning voter to ideology ID:" << v.ideologyId;
+            position[0] = v.ideologyX;
+            position[1] = v.ideologyY;
+            v.partyId = findClosestPartyId(position, dimensions);
+            v.ideologyId = ideologyModel->findClosestIdeologyId(position, dimensions);
         }
 
+        TRACE_SCOPE("db", "INSERT default voters");
         for (const Voter& voter : defaults) {
-            QSqlQuery insert(db);
+            MeteredQuery insert(db, "VoterModel");
             insert.prepare(R"(
             INSERT INTO voters (name, ideologyId, ideology_x, ideology_y, party_id)
             VALUES (:name, :ideologyId, :x, :y, :party_id)
@@ -265,7 +324,7 @@ bool VoterModel::ensureVotersPopulated(QSqlDatabase& db, const QMap<QString, int
                 return false;
             }
         }
-        qDebug() << "[VoterModel] Seeded default voters.";
+        qDebug() << "[VoterModel] Seeded" << defaults.size() << "default voters.";
         return true;
     }
     return false;
@@ -277,87 +336,635 @@ int VoterModel::getVoterIdAt(int row) const {
     return -1;
 }
 
+int VoterModel::rowOfVoter(int voterId) const {
+    return m_rowById.value(voterId, -1);
+}
+
 void VoterModel::deleteVoterById(int voterId) {
+    TRACE_SCOPE("model", "VoterModel::deleteVoterById");
     QSqlDatabase db = QSqlDatabase::database(m_connectionName);
-    QSqlQuery query(db);
+    MeteredQuery query(db, "VoterModel");
     query.prepare("DELETE FROM voters WHERE id = :id");
     query.bindValue(":id", voterId);
     if (!query.exec()) {
         qWarning() << "[VoterModel] Delete failed:" << query.lastError().text();
         return;
     }
+    if (eventLog) eventLog->recordVoterRemoved(voterId);
+
+    const int row = m_rowById.value(voterId, -1);
+    if (row != -1) {
+        const Voter removed = m_voters[row];
+        m_histogram.remove(removed.ideologyX, removed.ideologyY);
+        m_spatialIndex.remove(voterId);
+        countParty(removed.partyId, -1);
+        m_rowById.remove(voterId);
+
+        // Move the last row into the gap so deleting stays O(1)
+        const int last = m_voters.size() - 1;
+        invalidateNamesAt(row);
+        invalidateNamesAt(last);
+        if (row != last) {
+            m_voters[row] = m_voters[last];
+            m_rowById.insert(m_voters[row].id, row);
+            emit dataChanged(index(row, 0), index(row, columnCount() - 1));
+        }
+        m_extraAxes.swapRemove(row);
+        beginRemoveRows(QModelIndex(), last, last);
+        m_voters.removeLast();
+        endRemoveRows();
+        emit voterRemoved(removed);
+    }
+
+    emit voterDeleted();
+}
+
+void VoterModel::deleteVoters(const QVector<int>& voterIds) {
+    TRACE_SCOPE("model", "VoterModel::deleteVoters");
+    if (voterIds.isEmpty()) return;
+
+    QSqlDatabase db = QSqlDatabase::database(m_connectionName);
+    if (!db.isOpen()) {
+        qWarning() << "[VoterModel] deleteVoters failed: DB not open";
+        return;
+    }
+
+    db.transaction();
+    MeteredQuery query(db, "VoterModel");
+    query.prepare("DELETE FROM voters WHERE id = :id");
+    QSet<int> removed;
+    removed.reserve(voterIds.size());
+    for (int id : voterIds) {
+        query.bindValue(":id", id);
+        if (!query.exec()) {
+            qWarning() << "[VoterModel] Delete failed:" << query.lastError().text();
+            continue;
+        }
+        if (query.numRowsAffected() <= 0) continue;    // unknown ID: nothing to log
+        removed.insert(id);
+        if (eventLog) eventLog->recordVoterRemoved(id);
+    }
+    db.commit();
+    if (removed.isEmpty()) return;      // no row matched: nothing to reset or announce
+
+    // One reset instead of a row removal per voter
+    beginResetModel();
+    std::vector<bool> keep(m_voters.size());
+    for (int row = 0; row < m_voters.size(); ++row)
+        keep[row] = !removed.contains(m_voters[row].id);
+    m_extraAxes.keepRows(keep);
+    m_voters.erase(std::remove_if(m_voters.begin(), m_voters.end(),
+                                  [&removed](const Voter& v) { return removed.contains(v.id); }),
+                   m_voters.end());
+    rebuildIndexes();
+    endResetModel();
 
+    emit votersReset();
     emit voterDeleted();
-    //reloadData();
 }
 
 void VoterModel::updateVoter(int id, const Voter &updatedVoter) {
+    TRACE_SCOPE("model", "VoterModel::updateVoter");
     QSqlDatabase db = QSqlDatabase::database(m_connectionName);
     if (!db.isOpen()) {
         qWarning() << "[VoterModel] Update failed: DB not open";
         return;
     }
 
-    QSqlQuery query(db);
-    query.prepare("UPDATE voters SET name = :name, ideologyId = :ideologyId, ideology_x = :ix, ideology_y = :iy, party_id = :party_id WHERE id = :id");
-    query.bindValue(":name", updatedVoter.name);
-    query.bindValue(":ideologyId", updatedVoter.ideologyId);
-    query.bindValue(":ix", updatedVoter.ideologyX);
-    query.bindValue(":iy", updatedVoter.ideologyY); // [MODIFIED]
-    if (updatedVoter.partyId != -1) {
-        query.bindValue(":party_id", updatedVoter.partyId);
+    // Party and ideology follow the new position on every axis; the extra axes keep their stored values
+    const int row = m_rowById.value(id, -1);
+    Voter updated = updatedVoter;
+    if (row != -1) assignNearest(updated, row);
+
+    MeteredQuery query(db, "VoterModel");
+    query.prepare("UPDATE voters SET name = :name, ideologyId = :ideologyId, ideology_x = :ix, ideology_y = :iy, party_id = :party_id, "
+                  "district_id = COALESCE(:district_id, district_id) WHERE id = :id");
+    query.bindValue(":name", updated.name);
+    query.bindValue(":ideologyId", updated.ideologyId);
+    query.bindValue(":ix", updated.ideologyX);
+    query.bindValue(":iy", updated.ideologyY); // [MODIFIED]
+    if (updated.partyId != -1) {
+        query.bindValue(":party_id", updated.partyId);
     } else {
         query.bindValue(":party_id", QVariant(QVariant::Int)); // NULL if no party
     }
+    query.bindValue(":district_id", updated.districtId >= 0 ? QVariant(updated.districtId) : QVariant()); // keep current if unset
     query.bindValue(":id", id);
 
     if (!query.exec()) {
         qWarning() << "[VoterModel] Update failed:" << query.lastError().text();
+        return;
+    }
+
+    if (row != -1) {
+        Voter& voter = m_voters[row];
+        const Voter before = voter;
+        m_histogram.remove(voter.ideologyX, voter.ideologyY);
+
+        const int districtId = updated.districtId >= 0 ? updated.districtId : voter.districtId;
+        voter = updated;
+        voter.id = id;
+        voter.districtId = districtId;
+        resolveNames(voter);
+        invalidateNamesAt(row);
+
+        m_histogram.add(voter.ideologyX, voter.ideologyY);
+        m_spatialIndex.move(id, voter.ideologyX, voter.ideologyY);
+        countParty(before.partyId, -1);
+        countParty(voter.partyId, 1);
+        emit dataChanged(index(row, 0), index(row, columnCount() - 1));
+        if (eventLog) eventLog->recordVoterChanged(voter);
+        emit voterChanged(before, voter);
+        if (m_lazyNames) {
+            voter.name.clear();
+            voter.ideology.clear();
+            voter.partyName.clear();
+        }
+    } else if (eventLog) {
+        Voter logged = updated;
+        logged.id = id;
+        eventLog->recordVoterChanged(logged);
     }
 
     emit voterUpdated();
-    //reloadData();
 }
 
 
 Voter VoterModel::getVoterAt(int row) const {
     if (row < 0 || row >= m_voters.size()) return {};
-    return m_voters[row];
+    if (!m_lazyNames) return m_voters[row];
+
+    Voter voter = m_voters[row];
+    voter.name = voterName(row);
+    resolveNames(voter);
+    return voter;
 }
 
 QMap<int, int> VoterModel::countVotersPerParty() const {
     QMap<int, int> counts;
-    for (const auto& voter : m_voters) {
-        counts[voter.partyId]++;
-    }
+    for (auto it = m_partyCounts.cbegin(); it != m_partyCounts.cend(); ++it)
+        counts.insert(it.key(), it.value());
     return counts;
 }
 
+int VoterModel::votersForParty(int partyId) const {
+    return m_partyCounts.value(partyId, 0);
+}
+
+void VoterModel::countParty(int partyId, int delta) {
+    auto it = m_partyCounts.find(partyId);
+    if (it == m_partyCounts.end()) {
+        if (delta != 0) m_partyCounts.insert(partyId, delta);
+        return;
+    }
+    it.value() += delta;
+    if (it.value() == 0) m_partyCounts.erase(it);
+}
+
+const QVector<Voter>& VoterModel::getAllVoters() const {
+    return m_voters;
+}
+
+void VoterModel::reportMemory(MemoryReport& report) const {
+    qint64 names = 0, ideologies = 0, parties = 0;
+    for (const Voter& v : m_voters) {
+        names += report.stringBytes(v.name);
+        ideologies += report.stringBytes(v.ideology);
+        parties += report.stringBytes(v.partyName);
+    }
+    report.add("voters.records", MemoryReport::vectorBytes(m_voters), m_voters.size());
+    report.add("voters.names", names, m_voters.size());
+    report.add("voters.ideology_names", ideologies, m_voters.size());
+    report.add("voters.party_names", parties, m_voters.size());
+    if (m_lazyNames) {
+        qint64 cached = 0;
+        for (int page : m_nameCache.keys()) {
+            const QVector<QString>* names = m_nameCache.object(page);
+            cached += MemoryReport::vectorBytes(*names);
+            for (const QString& name : *names)
+                cached += report.stringBytes(name);
+        }
+        report.add("voters.name_cache", cached, m_nameCache.totalCost());
+    }
+    report.add("voters.extra_axes", m_extraAxes.memoryBytes(), m_extraAxes.size());
+    report.add("voters.row_index", MemoryReport::hashBytes(m_rowById), m_rowById.size());
+    report.add("voters.histogram", m_histogram.memoryBytes());
+    report.add("voters.spatial_index", m_spatialIndex.memoryBytes(), m_spatialIndex.size());
+    report.add("voters.party_counts", MemoryReport::hashBytes(m_partyCounts), m_partyCounts.size());
+}
+
 int VoterModel::totalVoters() const {
     return m_voters.size();
 }
 
 int VoterModel::findClosestPartyId(int x, int y) const {
+    const int position[2] = { x, y };
+    return findClosestPartyId(position, 2);
+}
+
+int VoterModel::findClosestPartyId(const int* position, int dimensions) const {
     if (!partyModel) {
         qWarning() << "[findClosestPartyId] partyModel not set!";
         return -1;
     }
 
-    int closestId = -1;
-    double minDistance = std::numeric_limits<double>::max();
+    const IdeologyPoints& parties = partyModel->positions();
+    const NearestPoint nearest = DistanceKernels::nearest(parties, position, std::min(dimensions, parties.dimensions()));
+    return nearest.index >= 0 ? partyModel->getAllParties()[nearest.index].id : -1;
+}
+
+const IdeologySpace& VoterModel::space() const {
+    return m_space;
+}
+
+int VoterModel::coordinate(int row, int axis) const {
+    if (row < 0 || row >= m_voters.size()) return 0;
+    if (axis == 0) return m_voters[row].ideologyX;
+    if (axis == 1) return m_voters[row].ideologyY;
+    const int extra = axis - IdeologySpace::kMinDimensions;
+    return extra >= 0 && extra < m_extraAxes.dimensions() ? m_extraAxes.coordinate(row, extra) : 0;
+}
+
+int VoterModel::positionAt(int row, int* position) const {
+    const int dimensions = m_space.dimensions();
+    for (int a = 0; a < dimensions; ++a)
+        position[a] = coordinate(row, a);
+    return dimensions;
+}
+
+void VoterModel::setVoterPosition(int voterId, const QVector<int>& position) {
+    TRACE_SCOPE("model", "VoterModel::setVoterPosition");
+    const int row = m_rowById.value(voterId, -1);
+    if (row == -1 || position.size() < IdeologySpace::kMinDimensions) return;
+
+    const int axes = std::min<int>(position.size(), m_space.dimensions());
+    if (axes > IdeologySpace::kMinDimensions) {
+        QString assignments;
+        for (int a = IdeologySpace::kMinDimensions; a < axes; ++a) {
+            if (!assignments.isEmpty()) assignments += ", ";
+            assignments += QString("%1 = :a%2").arg(IdeologySpace::columnName(a)).arg(a);
+        }
+        MeteredQuery update(QSqlDatabase::database(m_connectionName), "VoterModel");
+        update.prepare("UPDATE voters SET " + assignments + " WHERE id = :id");
+        for (int a = IdeologySpace::kMinDimensions; a < axes; ++a)
+            update.bindValue(QString(":a%1").arg(a), IdeologyPoints::clamp(position[a]));
+        update.bindValue(":id", voterId);
+        if (!update.exec()) {
+            qWarning() << "[VoterModel] Position update failed:" << update.lastError().text();
+            return;
+        }
+        for (int a = IdeologySpace::kMinDimensions; a < axes; ++a)
+            m_extraAxes.setCoordinate(row, a - IdeologySpace::kMinDimensions, position[a]);
+    }
+
+    // The first two axes, the party and the ideology follow the usual move path
+    moveVoters({ VoterMove{ voterId, position[0], position[1] } });
+}
+
+int VoterModel::districtCount() const {
+    return m_districtCount;
+}
+
+int VoterModel::districtForVoter(int voterId, int districtCount) {
+    if (districtCount <= 0) return -1;
+    // Multiplicative hash spreads consecutive IDs (seeded in party blocks) across districts
+    return static_cast<int>((static_cast<quint32>(voterId) * 2654435761u) % static_cast<quint32>(districtCount));
+}
+
+void VoterModel::assignDistricts(int districtCount) {
+    TRACE_SCOPE("model", "VoterModel::assignDistricts");
+    QSqlDatabase db = QSqlDatabase::database(m_connectionName);
+    if (!db.isOpen()) {
+        qWarning() << "[VoterModel] assignDistricts failed: DB not open";
+        return;
+    }
+    if (districtCount < 0) districtCount = 0;
+
+    db.transaction();
+    MeteredQuery districts(db, "VoterModel");
+    districts.exec("DELETE FROM districts");
+    districts.prepare("INSERT INTO districts (id, name) VALUES (:id, :name)");
+    for (int d = 0; d < districtCount; ++d) {
+        districts.bindValue(":id", d);
+        districts.bindValue(":name", QString("District %1").arg(d + 1));
+        if (!districts.exec()) {
+            qWarning() << "[VoterModel] District insert failed:" << districts.lastError().text();
+            db.rollback();
+            return;
+        }
+    }
+
+    MeteredQuery update(db, "VoterModel");
+    update.prepare("UPDATE voters SET district_id = :district WHERE id = :id");
+    for (Voter& v : m_voters) {
+        v.districtId = districtForVoter(v.id, districtCount);
+        update.bindValue(":district", v.districtId >= 0 ? QVariant(v.districtId) : QVariant());
+        update.bindValue(":id", v.id);
+        if (!update.exec()) {
+            qWarning() << "[VoterModel] District update failed:" << update.lastError().text();
+            db.rollback();
+            reloadData();
+            return;
+        }
+    }
+    db.commit();
+
+    m_districtCount = districtCount;
+    emit districtsChanged();
+}
+
+const VoterHistogram& VoterModel::histogram() const {
+    return m_histogram;
+}
+
+const VoterSpatialIndex& VoterModel::spatialIndex() const {
+    return m_spatialIndex;
+}
+
+void VoterModel::moveVoters(const QVector<VoterMove>& moves) {
+    TRACE_SCOPE("model", "VoterModel::moveVoters");
+    if (moves.isEmpty()) return;
+
+    QSqlDatabase db = QSqlDatabase::database(m_connectionName);
+    if (!db.isOpen()) {
+        qWarning() << "[VoterModel] moveVoters failed: DB not open";
+        return;
+    }
+
+    db.transaction();
+    MeteredQuery update(db, "VoterModel");
+    update.prepare("UPDATE voters SET ideology_x = :ix, ideology_y = :iy, ideologyId = :ideologyId, party_id = :partyId WHERE id = :id");
+
+    int firstRow = m_voters.size();
+    int lastRow = -1;
+    QVector<Voter> before;
+    QVector<Voter> moved;
+    before.reserve(moves.size());
+    moved.reserve(moves.size());
+    for (const VoterMove& move : moves) {
+        const int row = m_rowById.value(move.voterId, -1);
+        if (row == -1) continue;
+
+        Voter& v = m_voters[row];
+        before.append(v);
+        m_histogram.move(v.ideologyX, v.ideologyY, move.x, move.y);
+        m_spatialIndex.move(v.id, move.x, move.y);
+        v.ideologyX = move.x;
+        v.ideologyY = move.y;
+
+        int position[IdeologySpace::kMaxDimensions];
+        const int dimensions = positionAt(row, position);
+        v.partyId = findClosestPartyId(position, dimensions);
+        if (ideologyModel) v.ideologyId = ideologyModel->findClosestIdeologyId(position, dimensions);
+        if (!m_lazyNames) resolveNames(v);
+        if (v.partyId != before.last().partyId) {
+            countParty(before.last().partyId, -1);
+            countParty(v.partyId, 1);
+        }
+
+        update.bindValue(":ix", v.ideologyX);
+        update.bindValue(":iy", v.ideologyY);
+        update.bindValue(":ideologyId", v.ideologyId);
+        update.bindValue(":partyId", v.partyId != -1 ? QVariant(v.partyId) : QVariant(QVariant::Int));
+        update.bindValue(":id", v.id);
+        if (!update.exec())
+            qWarning() << "[VoterModel] Move failed:" << update.lastError().text();
+        moved.append(v);
+
+        firstRow = std::min(firstRow, row);
+        lastRow = std::max(lastRow, row);
+    }
+    db.commit();
+
+    if (eventLog) eventLog->recordVotersMoved(moved);
+    if (lastRow >= 0) {
+        emit dataChanged(index(firstRow, 0), index(lastRow, columnCount() - 1));
+        emit votersChanged(before, moved);
+    }
+    emit voterUpdated();
+}
+
+PopulationSnapshot::Ptr VoterModel::captureSnapshot() const {
+    auto next = std::make_shared<PopulationSnapshot>();
+    next->voters = m_voters;            // shared until the next in-place edit
+    next->extraAxes = m_extraAxes;
+    next->partyCounts = m_partyCounts;
+    next->districtCount = m_districtCount;
+    return next;
+}
+
+void VoterModel::assignNearest(Voter& voter, int row) const {
+    int position[IdeologySpace::kMaxDimensions];
+    const int dimensions = positionAt(row, position);
+    position[0] = voter.ideologyX;
+    position[1] = voter.ideologyY;
+    // Without linked models the caller's IDs are kept
+    if (partyModel) voter.partyId = findClosestPartyId(position, dimensions);
+    if (ideologyModel) voter.ideologyId = ideologyModel->findClosestIdeologyId(position, dimensions);
+}
+
+void VoterModel::resolveNames(Voter& voter) const {
+    voter.ideology = ideologyModel ? ideologyModel->getIdeologyNameById(voter.ideologyId) : QString();
+    voter.partyName = partyNameOf(voter.partyId);
+}
+
+QString VoterModel::partyNameOf(int partyId) const {
+    if (partyModel) {
+        for (const Party& p : partyModel->getAllParties()) {
+            if (p.id == partyId) return p.name;
+        }
+    }
+    return QString();
+}
+
+bool VoterModel::fetchRows(QSqlDatabase db) {
+    m_space = IdeologySpace::load(db);
+    const int extraAxes = m_space.dimensions() - IdeologySpace::kMinDimensions;
+    m_extraAxes = IdeologyPoints(extraAxes);
+    const QString extraColumns = IdeologySpace::extraColumnList(m_space.dimensions(), "v.");
+
+    MeteredQuery query(db, "VoterModel");
+    bool ok = false;
+    {
+        TRACE_SCOPE("db", "SELECT voters");
+        if (m_lazyNames) {
+            ok = query.exec("SELECT v.id, v.ideologyId, v.ideology_x, v.ideology_y, v.party_id, v.district_id" + extraColumns
+                            + " FROM voters v");
+        } else {
+            ok = query.exec(R"(
+            SELECT v.id, v.ideologyId, v.ideology_x, v.ideology_y, v.party_id, v.district_id,
+                   v.name, i.name AS ideologyName, p.name AS partyName)" + extraColumns + R"(
+            FROM voters v
+            LEFT JOIN ideologies i ON v.ideologyId = i.id
+            LEFT JOIN parties p ON v.party_id = p.id
+            )");
+        }
+    }
+    if (!ok) {
+        qWarning() << "[VoterModel] Loading voters failed:" << query.lastError().text();
+        return false;
+    }
+
+    {
+        TRACE_SCOPE("db", "Fetch voter rows");
+        // The extra axes follow the names, which lazy mode leaves out
+        const int firstExtra = m_lazyNames ? 6 : 9;
+        int extra[IdeologySpace::kMaxDimensions];
+        while (query.next()) {
+            Voter v;
+            v.id = query.value(0).toInt();
+            v.ideologyId = query.value(1).toInt();
+            v.ideologyX = query.value(2).toInt();
+            v.ideologyY = query.value(3).toInt();
+            v.partyId = query.value(4).isNull() ? -1 : query.value(4).toInt();
+            v.districtId = query.value(5).isNull() ? -1 : query.value(5).toInt();
+            if (!m_lazyNames) {
+                v.name = query.value(6).toString();
+                v.ideology = query.value(7).toString();
+                v.partyName = query.value(8).toString();
+            }
+            m_voters.append(v);
+            for (int a = 0; a < extraAxes; ++a)
+                extra[a] = query.value(firstExtra + a).toInt();
+            m_extraAxes.append(extra);
+        }
+    }
+
+    if (query.exec("SELECT COUNT(*) FROM districts") && query.next())
+        m_districtCount = query.value(0).toInt();
+    return true;
+}
 
-    for (const Party& p : partyModel->getAllParties()) {
-        double dx = p.ideologyX - x;
-        double dy = p.ideologyY - y;
-        double distance = std::sqrt(dx * dx + dy * dy);
+QHash<int, QString> VoterModel::queryNames(const QSqlDatabase& db, const QVector<int>& voterIds) {
+    QHash<int, QString> names;
+    if (voterIds.isEmpty()) return names;
+    names.reserve(voterIds.size());
 
-        if (distance < minDistance) {
-            minDistance = distance;
-            closestId = p.id;
+    MeteredQuery query(db, "VoterModel");
+    const bool few = voterIds.size() <= kNamePageRows * 8;
+    bool ok = false;
+    if (few) {
+        // IDs are integers, so they can be spelled into the statement
+        QString list;
+        list.reserve(voterIds.size() * 8);
+        for (int id : voterIds) {
+            if (!list.isEmpty()) list += ',';
+            list += QString::number(id);
         }
+        ok = query.exec(QString("SELECT id, name FROM voters WHERE id IN (%1)").arg(list));
+    } else {
+        // Many IDs: one scan of the table is cheaper than a huge IN list
+        ok = query.exec("SELECT id, name FROM voters");
+    }
+    if (!ok) {
+        qWarning() << "[VoterModel] Loading names failed:" << query.lastError().text();
+        return names;
+    }
+
+    const QSet<int> wanted = few ? QSet<int>() : QSet<int>(voterIds.cbegin(), voterIds.cend());
+    while (query.next()) {
+        const int id = query.value(0).toInt();
+        if (few || wanted.contains(id)) names.insert(id, query.value(1).toString());
     }
+    return names;
+}
+
+QString VoterModel::voterName(int row) const {
+    if (row < 0 || row >= m_voters.size()) return QString();
+    if (!m_lazyNames) return m_voters[row].name;
+
+    const int page = row / kNamePageRows;
+    if (const QVector<QString>* names = m_nameCache.object(page))
+        return names->at(row - page * kNamePageRows);
+
+    // Miss: fetch the whole page, so scrolling through the table costs one query per kNamePageRows rows
+    const int first = page * kNamePageRows;
+    const int last = std::min<int>(m_voters.size(), first + kNamePageRows);
+    QVector<int> ids;
+    ids.reserve(last - first);
+    for (int r = first; r < last; ++r)
+        ids.append(m_voters[r].id);
+    const QHash<int, QString> byId = queryNames(QSqlDatabase::database(m_connectionName), ids);
+    MetricsRegistry::instance().increment("model.VoterModel.name_pages_loaded");
+
+    auto* names = new QVector<QString>();
+    names->reserve(ids.size());
+    for (int id : ids)
+        names->append(byId.value(id));
+    const QString name = names->at(row - first);
+    m_nameCache.insert(page, names, names->size());
+    return name;
+}
 
-    return closestId;
+void VoterModel::invalidateNamesAt(int row) {
+    if (m_lazyNames) m_nameCache.remove(row / kNamePageRows);
+}
+
+void VoterModel::setLazyNames(bool lazy) {
+    if (lazy == m_lazyNames) return;
+    m_lazyNames = lazy;
+    qDebug() << "[VoterModel] Names" << (lazy ? "load on demand" : "load with the rows");
+    reloadData();
+}
+
+bool VoterModel::lazyNames() const {
+    return m_lazyNames;
+}
+
+QHash<int, Voter> VoterModel::votersWithNames(const QVector<int>& voterIds) const {
+    QHash<int, Voter> voters;
+    voters.reserve(voterIds.size());
+    QVector<int> loaded;
+    loaded.reserve(voterIds.size());
+    for (int id : voterIds) {
+        const int row = m_rowById.value(id, -1);
+        if (row == -1) continue;
+        voters.insert(id, m_voters[row]);
+        loaded.append(id);
+    }
+    if (!m_lazyNames) return voters;
+
+    const QHash<int, QString> names = queryNames(QSqlDatabase::database(m_connectionName), loaded);
+    for (auto it = voters.begin(); it != voters.end(); ++it) {
+        it->name = names.value(it.key());
+        resolveNames(*it);
+    }
+    return voters;
+}
+
+QHash<int, QString> VoterModel::readNames(const QString& connectionName, const QVector<int>& voterIds) {
+    static std::atomic<int> clones{0};
+    const QString cloneName = QString("%1_names_%2").arg(connectionName).arg(++clones);
+    const int pageIds = kNamePageRows * 8;
+
+    QHash<int, QString> names;
+    {
+        QSqlDatabase db = QSqlDatabase::cloneDatabase(connectionName, cloneName);
+        if (!db.open()) {
+            qWarning() << "[VoterModel] Opening" << cloneName << "failed:" << db.lastError().text();
+        } else {
+            names.reserve(voterIds.size());
+            for (int first = 0; first < voterIds.size(); first += pageIds)
+                names.insert(queryNames(db, voterIds.mid(first, pageIds)));
+            db.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(cloneName);
+    return names;
+}
+
+void VoterModel::rebuildIndexes() {
+    TRACE_SCOPE("model", "VoterModel::rebuildIndexes");
+    m_nameCache.clear();
+    m_rowById.clear();
+    m_rowById.reserve(m_voters.size());
+    for (int row = 0; row < m_voters.size(); ++row)
+        m_rowById.insert(m_voters[row].id, row);
+    m_histogram = VoterHistogram(m_voters);
+    m_spatialIndex.rebuild(m_voters);
+    m_partyCounts.clear();
+    for (const Voter& v : m_voters)
+        ++m_partyCounts[v.partyId];
 }
 
 void VoterModel::setPartyModel(const PartyModel* model) {
@@ -368,20 +975,49 @@ void VoterModel::setIdeologyModel(const IdeologyModel* model) {
     ideologyModel = model;
 }
 
+void VoterModel::setEventLog(EventLog* log) {
+    eventLog = log;
+}
+
 void VoterModel::reassignAllVoterParties() {
+    TRACE_SCOPE("model", "VoterModel::reassignAllVoterParties");
     QSqlDatabase db = QSqlDatabase::database(m_connectionName);
     if (!db.isOpen()) return;
 
-    QSqlQuery updateQuery(db);
-    updateQuery.prepare("UPDATE voters SET party_id = :partyId WHERE id = :id");
+    {
+        // The nearest-party search only reads, so it runs in parallel; the writes stay on this thread
+        TickArena::Scope arenaScope;
+        const QVector<Voter>& voters = m_voters;
+        TickArena::Vector<int> nearest(static_cast<size_t>(voters.size()), -1, TickArena::resource());
+        TaskScheduler::instance().parallelFor(0, voters.size(), 4096, [&](int begin, int end) {
+            int position[IdeologySpace::kMaxDimensions];
+            for (int i = begin; i < end; ++i)
+                nearest[i] = findClosestPartyId(position, positionAt(i, position));
+        });
 
-    for (Voter& v : m_voters) {
-        int newPartyId = findClosestPartyId(v.ideologyX, v.ideologyY);
-        v.partyId = newPartyId;
+        MeteredQuery updateQuery(db, "VoterModel");
+        updateQuery.prepare("UPDATE voters SET party_id = :partyId WHERE id = :id");
+
+        // One transaction for the whole pass; on failure nothing is written and reloadData() restores the stored parties
+        TRACE_SCOPE("db", "UPDATE voters party_id");
+        db.transaction();
+        bool failed = false;
+        for (int i = 0; i < m_voters.size() && !failed; ++i) {
+            Voter& v = m_voters[i];
+            const int newPartyId = nearest[i];
+            v.partyId = newPartyId;
 
-        updateQuery.bindValue(":partyId", (newPartyId != -1 ? newPartyId : QVariant(QVariant::Int)));
-        updateQuery.bindValue(":id", v.id);
-        updateQuery.exec();  // silent fail tolerated
+            updateQuery.bindValue(":partyId", (newPartyId != -1 ? newPartyId : QVariant(QVariant::Int)));
+            updateQuery.bindValue(":id", v.id);
+            if (!updateQuery.exec()) {
+                qWarning() << "[VoterModel] Party update failed:" << updateQuery.lastError().text();
+                failed = true;
+            }
+        }
+        if (failed)
+            db.rollback();
+        else if (!db.commit())
+            qWarning() << "[VoterModel] Party update commit failed:" << db.lastError().text();
     }
 
     reloadData();       // refresh local model + UI
@@ -2,16 +2,45 @@
 #define VOTERMODEL_H
 
 #include <QAbstractTableModel>
+#include <QCache>
+#include <QHash>
 #include <QVector>
 #include <QSqlDatabase>
 #include "Voter.h"
+#include "IdeologySpace.h"
+#include "PopulationSnapshot.h"
+#include "simulation/IdeologyPoints.h"
+#include "simulation/VoterHistogram.h"
+#include "simulation/VoterSpatialIndex.h"
 class PartyModel;
 class IdeologyModel;
+class EventLog;
+class MemoryReport;
+
+/**
+ * @brief A new ideological position for one voter, applied in bulk by VoterModel::moveVoters.
+ */
+struct VoterMove {
+    int voterId = -1;           ///< ID of the voter to move.
+    int x = 0;                  ///< New X (economic) coordinate.
+    int y = 0;                  ///< New Y (social) coordinate.
+};
 
 /**
  * @brief Manages the list of voters (citizens) and their affiliations.
  *
  * @details VoterModel provides an interface to add voters, remove or update them, and query voter data. It uses an SQLite table "voters" and links each voter to a party by ID.
+ *
+ * In lazy-name mode only the numeric columns are loaded up front; the table fetches voter names a page of rows at a time as
+ * data() asks for them and keeps the most recently used pages in a small cache, while ideology and party names are looked up
+ * in the linked models. Analysis that only needs IDs, coordinates, parties and districts then never pays for the strings.
+ *
+ * Voter records carry the first two axes of the ideology space. When the space has more (see IdeologySpace), the remaining
+ * coordinates are kept row-aligned in packed per-axis columns and read with coordinate() or positionAt(); nearest-party and
+ * nearest-ideology searches then use every axis.
+ *
+ * The live rows belong to the GUI thread. Other threads read the population through an immutable PopulationSnapshot taken
+ * on the GUI thread with captureSnapshot().
  */
 class VoterModel : public QAbstractTableModel {
     Q_OBJECT
@@ -23,8 +52,24 @@ signals:
     void voterUpdated();
     /** @brief Emitted after a voter is removed from the database. */
     void voterDeleted();
+    /** @brief Emitted after voters have been redistributed across electoral districts. */
+    void districtsChanged();
+
+    /** @brief Emitted after a voter was inserted, with the stored record (including its new ID). */
+    void voterInserted(const Voter& voter);
+    /** @brief Emitted after a voter was edited, with the record before and after the change. */
+    void voterChanged(const Voter& before, const Voter& after);
+    /** @brief Emitted after a voter was removed, with the record as it was. */
+    void voterRemoved(const Voter& voter);
+    /** @brief Emitted after a batch move, with the moved records before and after (same order, same length). */
+    void votersChanged(const QVector<Voter>& before, const QVector<Voter>& after);
+    /** @brief Emitted after the whole voter list was reloaded; listeners should rebuild from getAllVoters(). */
+    void votersReset();
 
 public:
+    static constexpr int kNamePageRows = 64;        ///< Rows whose names are fetched together in lazy-name mode.
+    static constexpr int kNameCacheRows = 4096;     ///< Rows whose names are kept in lazy-name mode.
+
     /**
      * @brief Constructor for VoterModel.
      * @param connectionName Database connection name (should match PartyModel's connection).
@@ -49,10 +94,16 @@ public:
      * @param voter A Voter struct containing the new voter's details (name, ideology, party).
      *
      * Inserts the voter into the voters table. On success, emits `voterAdded` so the model can refresh.
+     * The voter starts at 0 on the axes beyond the first two. With a linked PartyModel or IdeologyModel, the party or ideology
+     * is the nearest one on every axis, whatever the record says.
      */
     void addVoter(const Voter& voter);
 
-    /** @brief Reloads all voter data from the database into the model (e.g., after external changes). */
+    /**
+     * @brief Reloads all voter data from the database into the model (e.g., after external changes).
+     *
+     * Emits `votersReset`, and `districtsChanged` as well if the stored number of districts differs from the loaded one.
+     */
     void reloadData();
 
     /**
@@ -71,6 +122,7 @@ public:
      * @param updatedVoter A Voter struct with the new details for the voter.
      *
      * Saves the changes to the database for the given voter ID and updates the model. Emits `voterUpdated` on success.
+     * The axes beyond the first two keep their values. As in addVoter(), the linked models decide the party and ideology.
      */
     void updateVoter(int id, const Voter &updatedVoter);
 
@@ -82,10 +134,18 @@ public:
      */
     void deleteVoterById(int voterId);
 
+    /**
+     * @brief Removes many voters at once, e.g. a selection made on the ideology chart.
+     * @param voterIds IDs of the voters to remove; unknown IDs are ignored.
+     *
+     * Deletes all records in one transaction and rebuilds the loaded rows and indexes once. Emits `votersReset` and `voterDeleted` once.
+     */
+    void deleteVoters(const QVector<int>& voterIds);
+
     /**
      * @brief Retrieves the Voter at the specified row.
      * @param row The index of the row.
-     * @return A copy of the Voter at that row.
+     * @return A copy of the Voter at that row, with its names filled in lazy-name mode too.
      */
     Voter getVoterAt(int row) const;
 
@@ -96,6 +156,19 @@ public:
      */
     int getVoterIdAt(int row) const;
 
+    /**
+     * @brief Returns the row of a voter in O(1).
+     * @param voterId The voter's database ID.
+     * @return The row index, or -1 if the voter is not loaded.
+     */
+    int rowOfVoter(int voterId) const;
+
+    /**
+     * @brief Provides read-only access to all voters in the model.
+     * @return A const reference to the internal list of Voter records.
+     */
+    const QVector<Voter>& getAllVoters() const;
+
     /**
      * @brief Returns the total number of voters.
      */
@@ -104,9 +177,49 @@ public:
     /**
      * @brief Counts how many voters are affiliated with each party.
      * @return A map of party ID to the count of voters in that party.
+     *
+     * Built from per-party counters that every edit keeps current, so the cost depends on the number of parties, not voters.
      */
     QMap<int, int> countVotersPerParty() const;
 
+    /**
+     * @brief Switches between loading every voter's name up front and fetching names on demand.
+     * @param lazy True to load only the numeric columns and fetch names for the rows data() is asked about.
+     *
+     * Reloads the rows when the mode changes. In lazy mode the records from getAllVoters(), votersChanged and the snapshots
+     * carry empty name, ideology and party strings; getVoterAt(), voterName() and votersWithNames() fill them in.
+     * The initial mode is taken from POLITICALSIM_LAZY_NAMES (off unless set to 1).
+     */
+    void setLazyNames(bool lazy);
+
+    /** @brief Returns true while names are fetched on demand. */
+    bool lazyNames() const;
+
+    /** @brief Returns the name of the voter at a row, from the page cache in lazy-name mode. */
+    QString voterName(int row) const;
+
+    /**
+     * @brief Returns copies of some loaded voters with every name filled in, keyed by voter ID.
+     * @param voterIds Voters to return; IDs that are not loaded are skipped.
+     *
+     * Reads the names with a single query in lazy-name mode, bypassing the page cache. Runs on the model's connection, so
+     * only on its thread; readNames() reads names from any thread.
+     */
+    QHash<int, Voter> votersWithNames(const QVector<int>& voterIds) const;
+
+    /**
+     * @brief Reads the names of some voters on a connection of its own, so it can run on any thread (e.g. an export worker).
+     * @param connectionName Connection whose database to read; it is cloned, never used directly.
+     * @param voterIds Voters whose names to read.
+     * @return Name per voter ID; IDs that are not stored are absent.
+     *
+     * Reads kNamePageRows * 8 IDs per statement, so no statement scans the whole table. The clone is removed before returning.
+     */
+    static QHash<int, QString> readNames(const QString& connectionName, const QVector<int>& voterIds);
+
+    /** @brief Returns the number of voters affiliated with a party in O(1). */
+    int votersForParty(int partyId) const;
+
     /**
      * @brief Finds the ID of the party whose ideology is closest to the given coordinates.
      * @param x The ideology X-coordinate.
@@ -115,6 +228,42 @@ public:
      */
     int findClosestPartyId(int x, int y) const;
 
+    /**
+     * @brief Finds the ID of the party closest to a point of the N-dimensional ideology space.
+     * @param position One coordinate per axis.
+     * @param dimensions Number of coordinates in @p position; axes the parties were not loaded with are ignored.
+     * @return The ID of the nearest party, or -1 if no parties are available.
+     */
+    int findClosestPartyId(const int* position, int dimensions) const;
+
+    /** @brief Returns the axes of the ideology space, as read by the last load. */
+    const IdeologySpace& space() const;
+
+    /**
+     * @brief Returns one coordinate of the voter at a row.
+     * @param row The row index in the model.
+     * @param axis Axis of the ideology space; 0 and 1 are the voter's X and Y.
+     * @return The coordinate, or 0 for an axis the space does not have.
+     */
+    int coordinate(int row, int axis) const;
+
+    /**
+     * @brief Copies every coordinate of the voter at a row.
+     * @param row The row index in the model.
+     * @param position Receives space().dimensions() coordinates (at most IdeologySpace::kMaxDimensions).
+     * @return The number of coordinates written.
+     */
+    int positionAt(int row, int* position) const;
+
+    /**
+     * @brief Moves a voter to a point of the N-dimensional ideology space.
+     * @param voterId The voter's database ID; unknown IDs are ignored.
+     * @param position One coordinate per axis; axes beyond the space are ignored, missing ones keep their value.
+     *
+     * Stores the extra axes, then moves the voter like moveVoters() does, reassigning its party and ideology on all axes.
+     */
+    void setVoterPosition(int voterId, const QVector<int>& position);
+
     /**
      * @brief Sets the PartyModel used by this VoterModel.
      * @param model Pointer to the PartyModel providing party data.
@@ -127,15 +276,97 @@ public:
      */
     void setIdeologyModel(const IdeologyModel* model);
 
+    /**
+     * @brief Sets the event log that voter additions, edits, deletions and moves are appended to.
+     * @param log Pointer to the EventLog, or nullptr to stop logging.
+     */
+    void setEventLog(EventLog* log);
+
     /** @brief Recompute each voter’s preferred party. */
     void reassignAllVoterParties();
 
+    /**
+     * @brief Provides the voter density histogram over the 201 x 201 compass grid.
+     *
+     * Kept up to date incrementally by every add, update, delete and move, so whole-population queries can iterate grid cells instead of voters.
+     */
+    const VoterHistogram& histogram() const;
+
+    /**
+     * @brief Provides the voters bucketed by compass cell, for nearest-neighbour queries.
+     *
+     * Kept up to date incrementally alongside the histogram.
+     */
+    const VoterSpatialIndex& spatialIndex() const;
+
+    /**
+     * @brief Moves many voters at once, e.g. for an opinion drift step.
+     * @param moves New coordinates per voter ID; unknown IDs are ignored.
+     *
+     * Reassigns the nearest party and ideology of each moved voter on every axis, writes all changes in one transaction and updates the histogram per voter. Emits `votersChanged` and `voterUpdated` once.
+     */
+    void moveVoters(const QVector<VoterMove>& moves);
+
+    /**
+     * @brief Distributes all voters across a number of electoral districts.
+     * @param districtCount Number of districts; 0 removes every voter from its district.
+     *
+     * Recreates the districts table, derives each voter's district from their ID (see districtForVoter) and stores it in the `district_id` column, all in one transaction. Emits `districtsChanged`.
+     */
+    void assignDistricts(int districtCount);
+
+    /** @brief Returns the number of electoral districts voters are currently spread across (0 if none). */
+    int districtCount() const;
+
+    /**
+     * @brief Returns a snapshot of the current rows for readers on other threads.
+     *
+     * Call it on the GUI thread. The rows stay shared only while a holder keeps the snapshot, so a one-off reader such as an
+     * export costs at most one copy of the voter list, and none if no row is edited before it finishes.
+     */
+    PopulationSnapshot::Ptr captureSnapshot() const;
+
+    /**
+     * @brief Adds the memory held by the loaded voters and their indexes to a report, under "voters.".
+     * @param report Report to add to.
+     *
+     * Separates the Voter records from the heap payloads of their name, ideology and party strings.
+     */
+    void reportMemory(MemoryReport& report) const;
+
+    /**
+     * @brief Computes the district a voter belongs to.
+     * @param voterId The voter's database ID.
+     * @param districtCount Total number of districts.
+     * @return District index in [0, districtCount), or -1 if there are no districts.
+     */
+    static int districtForVoter(int voterId, int districtCount);
+
 private:
+    void resolveNames(Voter& voter) const;  ///< Fills the ideology and party names of a voter from the linked models.
+    void assignNearest(Voter& voter, int row) const;   ///< Sets party and ideology from voter's x/y and the extra axes of a row (-1: all 0).
+    QString partyNameOf(int partyId) const; ///< Name of a party from the linked PartyModel (empty if unknown).
+    bool fetchRows(QSqlDatabase db);        ///< Appends every stored voter to m_voters, with names unless they load lazily.
+    static QHash<int, QString> queryNames(const QSqlDatabase& db, const QVector<int>& voterIds); ///< Reads the names of some voters.
+    void invalidateNamesAt(int row);        ///< Drops the cached name page holding a row.
+    void rebuildIndexes();                  ///< Rebuilds the ID lookup, histogram, spatial index and party counters after a full load.
+    void countParty(int partyId, int delta); ///< Adjusts the voter counter of one party.
+
     QString m_connectionName;               ///< Database connection name.
     QVector<Voter> m_voters;                ///< List of Voter records currently loaded.
+    IdeologySpace m_space;                  ///< Axes of the ideology space.
+    IdeologyPoints m_extraAxes;             ///< Coordinates of each voter on the axes beyond the first two, row-aligned with m_voters.
+    QHash<int, int> m_rowById;              ///< Row of each loaded voter, keyed by voter ID.
+    VoterHistogram m_histogram;             ///< Voter count per compass cell.
+    VoterSpatialIndex m_spatialIndex;       ///< Voter IDs per compass cell.
+    QHash<int, int> m_partyCounts;          ///< Number of voters per party ID (parties without voters are absent).
+    int m_districtCount = 0;                ///< Number of electoral districts voters are spread across.
+    bool m_lazyNames = false;               ///< True while names are fetched on demand.
+    mutable QCache<int, QVector<QString>> m_nameCache;  ///< Voter names per page of kNamePageRows rows (lazy-name mode only).
 
     const PartyModel* partyModel = nullptr;             ///< Pointer to the associated PartyModel (for party data).
     const IdeologyModel* ideologyModel = nullptr;       ///< Pointer to the associated IdeologyModel (for ideology data).
+    EventLog* eventLog = nullptr;                       ///< Pointer to the EventLog recording voter changes (optional).
 };
 
 #endif // VOTERMODEL_H
@@ -0,0 +1,43 @@
+#include "VoterFilterProxyModel.h"
+
+#include "models/VoterModel.h"
+#include "diagnostics/MemoryReport.h"
+
+VoterFilterProxyModel::VoterFilterProxyModel(QObject* parent)
+    : QSortFilterProxyModel(parent)
+{
+}
+
+void VoterFilterProxyModel::setVoterModel(VoterModel* model) {
+    voterModel = model;
+    setSourceModel(model);
+}
+
+void VoterFilterProxyModel::setMatchingIds(const QSet<int>& voterIds) {
+    m_matchingIds = voterIds;
+    m_filtering = true;
+    invalidateFilter();
+}
+
+void VoterFilterProxyModel::clearMatches() {
+    if (!m_filtering) return;
+    m_matchingIds.clear();
+    m_filtering = false;
+    invalidateFilter();
+}
+
+bool VoterFilterProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex&) const {
+    if (!m_filtering || !voterModel) return true;
+    return m_matchingIds.contains(voterModel->getVoterIdAt(sourceRow));
+}
+
+void VoterFilterProxyModel::reportMemory(MemoryReport& report) const {
+    if (sourceModel()) {
+        const qint64 sourceRows = sourceModel()->rowCount();
+        const qint64 proxyRows = rowCount();
+        const qint64 columns = columnCount();
+        const qint64 ints = sourceRows + proxyRows + 2 * columns;
+        report.add("proxy.mapping", 4 * MemoryReport::kArrayHeaderBytes + ints * qint64(sizeof(int)), sourceRows + proxyRows);
+    }
+    report.add("proxy.matches", MemoryReport::setBytes(m_matchingIds), m_matchingIds.size());
+}
@@ -0,0 +1,58 @@
+#ifndef VOTERFILTERPROXYMODEL_H
+#define VOTERFILTERPROXYMODEL_H
+
+#include <QSet>
+#include <QSortFilterProxyModel>
+
+class VoterModel;
+class MemoryReport;
+
+/**
+ * @brief Proxy over VoterModel that shows only the voters found by a VoterSearch.
+ *
+ * @details Rows are accepted by a hash lookup of their voter ID instead of matching text through data(), so refiltering
+ * costs one lookup per row.
+ */
+class VoterFilterProxyModel : public QSortFilterProxyModel {
+    Q_OBJECT
+
+public:
+    /** @brief Constructs a proxy that shows every row. */
+    explicit VoterFilterProxyModel(QObject* parent = nullptr);
+
+    /**
+     * @brief Sets the VoterModel to filter.
+     * @param model Pointer to the VoterModel; also becomes the source model.
+     */
+    void setVoterModel(VoterModel* model);
+
+    /**
+     * @brief Shows only the given voters.
+     * @param voterIds IDs of the voters to keep.
+     */
+    void setMatchingIds(const QSet<int>& voterIds);
+
+    /** @brief Removes the filter so every voter is shown. */
+    void clearMatches();
+
+    /**
+     * @brief Adds the memory held by the proxy to a report, under "proxy.".
+     * @param report Report to add to.
+     *
+     * The row mapping tables are private to QSortFilterProxyModel; they are estimated as one int per source row and one per
+     * proxy row (and the same per column), which is what the flat table needs.
+     */
+    void reportMemory(MemoryReport& report) const;
+
+protected:
+    /** @brief Accepts a row if no filter is set or its voter ID is among the matches. */
+    bool filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const override;
+
+private:
+    QSet<int> m_matchingIds;                ///< Voters to show while filtering.
+    bool m_filtering = false;               ///< True while only m_matchingIds are shown.
+
+    VoterModel* voterModel = nullptr;       ///< VoterModel providing the voter IDs of source rows.
+};
+
+#endif // VOTERFILTERPROXYMODEL_H
@@ -0,0 +1,112 @@
+#include "VoterSearch.h"
+
+#include "models/VoterModel.h"
+#include "diagnostics/Tracer.h"
+
+VoterSearch::VoterSearch(QObject* parent)
+    : QObject(parent)
+{
+    m_worker.setObjectName("VoterSearch");
+    m_worker.setMaxThreadCount(1);
+    m_worker.setExpiryTimeout(-1);
+
+    m_debounce.setSingleShot(true);
+    m_debounce.setInterval(150);
+    connect(&m_debounce, &QTimer::timeout, this, &VoterSearch::startSearch);
+}
+
+VoterSearch::~VoterSearch() {
+    ++m_generation;
+    m_worker.clear();
+    m_worker.waitForDone();
+}
+
+void VoterSearch::setVoterModel(VoterModel* model) {
+    if (voterModel) disconnect(voterModel, nullptr, this, nullptr);
+    voterModel = model;
+
+    if (!voterModel) {
+        enqueueUpdate([this]() { m_index.clear(); return true; });
+        return;
+    }
+
+    auto reset = [this]() {
+        const QVector<Voter> voters = voterModel->getAllVoters();
+        enqueueUpdate([this, voters]() { m_index.rebuild(voters); return true; });
+    };
+    connect(voterModel, &VoterModel::votersReset, this, reset);
+    connect(voterModel, &VoterModel::voterInserted, this, [this](const Voter& voter) {
+        enqueueUpdate([this, voter]() { return m_index.insert(voter); });
+    });
+    connect(voterModel, &VoterModel::voterChanged, this, [this](const Voter&, const Voter& after) {
+        enqueueUpdate([this, after]() { return m_index.insert(after); });
+    });
+    connect(voterModel, &VoterModel::voterRemoved, this, [this](const Voter& voter) {
+        const int id = voter.id;
+        enqueueUpdate([this, id]() { return m_index.remove(id); });
+    });
+    connect(voterModel, &VoterModel::votersChanged, this, [this](const QVector<Voter>&, const QVector<Voter>& after) {
+        enqueueUpdate([this, after]() {
+            // Moves only change the searchable text when the nearest party changes
+            bool changed = false;
+            for (const Voter& v : after)
+                changed |= m_index.insert(v);
+            return changed;
+        });
+    });
+    reset();
+}
+
+void VoterSearch::setQuery(const QString& text) {
+    if (text == m_query) return;
+    m_query = text;
+    ++m_generation;
+
+    if (m_query.isEmpty()) {
+        m_debounce.stop();
+        emit searchCleared();
+        return;
+    }
+    m_debounce.start();
+}
+
+QString VoterSearch::query() const {
+    return m_query;
+}
+
+void VoterSearch::setDebounceInterval(int msec) {
+    m_debounce.setInterval(msec);
+}
+
+int VoterSearch::debounceInterval() const {
+    return m_debounce.interval();
+}
+
+void VoterSearch::startSearch() {
+    if (m_query.isEmpty()) return;
+
+    const quint64 generation = ++m_generation;
+    const QString query = m_query;
+    m_worker.start([this, generation, query]() {
+        if (m_generation.load() != generation) return;
+        TRACE_SCOPE("search", "VoterSearch query");
+        const QVector<int> ids = m_index.matches(query, [this, generation]() { return m_generation.load() != generation; });
+        if (m_generation.load() != generation) return;
+
+        const QSet<int> idSet(ids.cbegin(), ids.cend());
+        QMetaObject::invokeMethod(this, [this, generation, query, idSet]() {
+            if (m_generation.load() == generation) emit resultsReady(query, idSet);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void VoterSearch::enqueueUpdate(std::function<bool()> update) {
+    m_worker.start([this, update = std::move(update)]() {
+        TRACE_SCOPE("search", "VoterSearch index update");
+        if (!update()) return;
+        // Refresh the visible results once the model settles
+        QMetaObject::invokeMethod(this, [this]() {
+            if (!m_query.isEmpty()) m_debounce.start();
+        }, Qt::QueuedConnection);
+    });
+}
@@ -0,0 +1,80 @@
+#ifndef VOTERSEARCH_H
+#define VOTERSEARCH_H
+
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+#include <QTimer>
+
+#include <atomic>
+
+#include "VoterSearchIndex.h"
+
+class VoterModel;
+
+/**
+ * @brief Runs voter searches off the GUI thread.
+ *
+ * @details Owns a VoterSearchIndex that lives on a single worker thread: index updates from VoterModel's typed change signals
+ * and queries are queued to that thread in order, so the GUI thread never scans voters or waits on a lock.
+ *
+ * setQuery() restarts a debounce timer, so a burst of keystrokes runs one search. Every new query bumps a generation counter;
+ * a running search polls it and stops early once it is outdated, and outdated results are never delivered.
+ */
+class VoterSearch : public QObject {
+    Q_OBJECT
+
+signals:
+    /**
+     * @brief Emitted on the GUI thread with the voters matching the current query.
+     * @param query The query the results belong to.
+     * @param voterIds IDs of every matching voter.
+     */
+    void resultsReady(const QString& query, const QSet<int>& voterIds);
+
+    /** @brief Emitted when the query becomes empty, i.e. every voter should be shown again. */
+    void searchCleared();
+
+public:
+    /** @brief Constructs an idle search with an empty index. */
+    explicit VoterSearch(QObject* parent = nullptr);
+
+    /** @brief Cancels any running search and waits for the worker thread to finish. */
+    ~VoterSearch() override;
+
+    /**
+     * @brief Indexes a VoterModel and keeps the index in sync with its typed change signals.
+     * @param model Pointer to the VoterModel to search.
+     */
+    void setVoterModel(VoterModel* model);
+
+    /**
+     * @brief Sets the search text.
+     * @param text Query; an empty query clears the search immediately, anything else runs after the debounce interval.
+     */
+    void setQuery(const QString& text);
+
+    /** @brief Returns the current search text. */
+    QString query() const;
+
+    /** @brief Sets how long typing must pause before a search runs (default 150 ms). */
+    void setDebounceInterval(int msec);
+
+    /** @brief Returns the debounce interval in milliseconds. */
+    int debounceInterval() const;
+
+private:
+    void startSearch();                                 ///< Queues a search for the current query on the worker thread.
+    void enqueueUpdate(std::function<bool()> update);   ///< Queues an index change; refreshes the results if it changed any text.
+
+    VoterSearchIndex m_index;                   ///< Search index (touched only by tasks on m_worker).
+    QThreadPool m_worker;                       ///< Single-thread pool running index updates and queries in order.
+    QTimer m_debounce;                          ///< Delays the search until typing pauses.
+    QString m_query;                            ///< Current search text.
+    std::atomic<quint64> m_generation{0};       ///< Bumped for every new query; outdated searches stop early.
+
+    VoterModel* voterModel = nullptr;           ///< VoterModel being searched.
+};
+
+#endif // VOTERSEARCH_H
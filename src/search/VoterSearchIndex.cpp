@@ -0,0 +1,137 @@
+#include "VoterSearchIndex.h"
+
+#include <algorithm>
+
+namespace {
+
+constexpr int kCancelCheckInterval = 4096;         // Matches verified between two polls of the cancel callback
+constexpr qsizetype kMinStaleForCompaction = 4096;
+
+quint64 trigramKey(const QChar* c) {
+    return (quint64(c[0].unicode()) << 32) | (quint64(c[1].unicode()) << 16) | quint64(c[2].unicode());
+}
+
+}
+
+QString VoterSearchIndex::searchText(const Voter& voter) {
+    const QString party = voter.partyName.isEmpty() ? QStringLiteral("N/A") : voter.partyName;
+    return (voter.name + QLatin1Char('\n') + voter.ideology + QLatin1Char('\n') + party).toCaseFolded();
+}
+
+void VoterSearchIndex::clear() {
+    m_texts.clear();
+    m_postings.clear();
+    m_livePostings = 0;
+    m_stalePostings = 0;
+}
+
+void VoterSearchIndex::rebuild(const QVector<Voter>& voters) {
+    clear();
+    m_texts.reserve(voters.size());
+    for (const Voter& v : voters) {
+        const QString text = searchText(v);
+        m_texts.insert(v.id, text);
+        addPostings(v.id, text);
+    }
+}
+
+bool VoterSearchIndex::insert(const Voter& voter) {
+    const QString text = searchText(voter);
+    auto it = m_texts.find(voter.id);
+    if (it != m_texts.end()) {
+        if (*it == text) return false;
+        const qsizetype old = trigrams(*it).size();
+        m_livePostings -= old;
+        m_stalePostings += old;
+        *it = text;
+    } else {
+        m_texts.insert(voter.id, text);
+    }
+    addPostings(voter.id, text);
+    compactIfStale();
+    return true;
+}
+
+bool VoterSearchIndex::remove(int voterId) {
+    auto it = m_texts.find(voterId);
+    if (it == m_texts.end()) return false;
+
+    const qsizetype old = trigrams(*it).size();
+    m_livePostings -= old;
+    m_stalePostings += old;
+    m_texts.erase(it);
+    compactIfStale();
+    return true;
+}
+
+int VoterSearchIndex::size() const {
+    return static_cast<int>(m_texts.size());
+}
+
+QVector<int> VoterSearchIndex::matches(const QString& text, const std::function<bool()>& cancelled) const {
+    const QString query = text.toCaseFolded();
+    QVector<int> result;
+    int sinceCheck = 0;
+    auto shouldStop = [&]() {
+        if (!cancelled || ++sinceCheck < kCancelCheckInterval) return false;
+        sinceCheck = 0;
+        return cancelled();
+    };
+
+    if (query.size() < 3) {
+        // Too short for a trigram; scan the stored texts
+        for (auto it = m_texts.cbegin(); it != m_texts.cend(); ++it) {
+            if (shouldStop()) break;
+            if (it->contains(query)) result.append(it.key());
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    // Only voters on the rarest trigram's list can match
+    const QVector<int>* rarest = nullptr;
+    for (quint64 key : trigrams(query)) {
+        auto it = m_postings.constFind(key);
+        if (it == m_postings.cend()) return result;
+        if (!rarest || it->size() < rarest->size()) rarest = &*it;
+    }
+
+    QVector<int> candidates = *rarest;
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    for (int id : candidates) {
+        if (shouldStop()) break;
+        auto it = m_texts.constFind(id);
+        if (it != m_texts.cend() && it->contains(query)) result.append(id);
+    }
+    return result;
+}
+
+QVector<quint64> VoterSearchIndex::trigrams(const QString& text) {
+    QVector<quint64> keys;
+    if (text.size() < 3) return keys;
+    keys.reserve(text.size() - 2);
+    for (qsizetype i = 0; i + 3 <= text.size(); ++i)
+        keys.append(trigramKey(text.constData() + i));
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    return keys;
+}
+
+void VoterSearchIndex::addPostings(int voterId, const QString& text) {
+    const QVector<quint64> keys = trigrams(text);
+    for (quint64 key : keys)
+        m_postings[key].append(voterId);
+    m_livePostings += keys.size();
+}
+
+void VoterSearchIndex::compactIfStale() {
+    if (m_stalePostings < kMinStaleForCompaction || m_stalePostings < m_livePostings) return;
+
+    m_postings.clear();
+    m_livePostings = 0;
+    m_stalePostings = 0;
+    for (auto it = m_texts.cbegin(); it != m_texts.cend(); ++it)
+        addPostings(it.key(), *it);
+}
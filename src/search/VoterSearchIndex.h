@@ -0,0 +1,69 @@
+#ifndef VOTERSEARCHINDEX_H
+#define VOTERSEARCHINDEX_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include <functional>
+
+#include "models/Voter.h"
+
+/**
+ * @brief Trigram index over the text shown in the voter table (name, ideology and party).
+ *
+ * @details Every voter's searchable text is case-folded and split into overlapping three-character keys, and each key keeps a
+ * posting list of voter IDs. A query of three or more characters only verifies the voters on the shortest posting list among
+ * its own trigrams; shorter queries fall back to a scan of the stored texts.
+ *
+ * Removals and edits leave stale entries in the posting lists (queries skip them while verifying) and the lists are compacted
+ * once stale entries outnumber live ones, so every change costs O(text length).
+ *
+ * The index does no locking; VoterSearch confines it to one worker thread.
+ */
+class VoterSearchIndex {
+public:
+    /** @brief Returns the case-folded text a voter is matched against (table columns separated by newlines). */
+    static QString searchText(const Voter& voter);
+
+    /** @brief Removes every voter from the index. */
+    void clear();
+
+    /** @brief Replaces the index contents with @p voters. */
+    void rebuild(const QVector<Voter>& voters);
+
+    /**
+     * @brief Adds a voter, or refreshes its text if the ID is already indexed.
+     * @return True if the voter's searchable text changed.
+     */
+    bool insert(const Voter& voter);
+
+    /**
+     * @brief Removes a voter.
+     * @return True if the voter was indexed.
+     */
+    bool remove(int voterId);
+
+    /** @brief Returns the number of indexed voters. */
+    int size() const;
+
+    /**
+     * @brief Finds every voter whose name, ideology or party contains @p text, ignoring case.
+     * @param text Query; an empty query matches every voter.
+     * @param cancelled Optional callback polled while matching; the search stops early once it returns true.
+     * @return Matching voter IDs in ascending order (incomplete if cancelled).
+     */
+    QVector<int> matches(const QString& text, const std::function<bool()>& cancelled = {}) const;
+
+private:
+    static QVector<quint64> trigrams(const QString& text); ///< Distinct trigram keys of a folded text.
+    void addPostings(int voterId, const QString& text);     ///< Appends a voter to the posting list of each of its trigrams.
+    void compactIfStale();                                  ///< Drops stale postings once they outnumber live ones.
+
+    QHash<int, QString> m_texts;                    ///< Folded searchable text per voter ID.
+    QHash<quint64, QVector<int>> m_postings;        ///< Voter IDs per trigram, in insertion order (may hold stale IDs).
+    qsizetype m_livePostings = 0;                   ///< Posting entries belonging to current texts.
+    qsizetype m_stalePostings = 0;                  ///< Posting entries left behind by removals and edits.
+};
+
+#endif // VOTERSEARCHINDEX_H
@@ -0,0 +1,77 @@
+#include "DensityQuadtree.h"
+
+#include <algorithm>
+#include <cmath>
+
+DensityQuadtree::DensityQuadtree() {
+    for (int level = 0; level < kLevels; ++level)
+        m_levels[level].assign(levelSide(level) * levelSide(level), 0);
+}
+
+DensityQuadtree::DensityQuadtree(const VoterHistogram& histogram)
+    : DensityQuadtree()
+{
+    rebuild(histogram);
+}
+
+void DensityQuadtree::rebuild(const VoterHistogram& histogram) {
+    std::vector<int>& base = m_levels[0];
+    std::fill(base.begin(), base.end(), 0);
+    const std::vector<int>& cells = histogram.cells();
+    for (int y = 0; y < VoterHistogram::kSide; ++y)
+        std::copy_n(cells.begin() + y * VoterHistogram::kSide, VoterHistogram::kSide, base.begin() + y * kSide);
+
+    // Each parent is the sum of its four children
+    for (int level = 1; level < kLevels; ++level) {
+        const int side = levelSide(level);
+        const int childSide = side * 2;
+        const std::vector<int>& child = m_levels[level - 1];
+        std::vector<int>& parent = m_levels[level];
+        for (int y = 0; y < side; ++y) {
+            for (int x = 0; x < side; ++x) {
+                const int c = (2 * y) * childSide + 2 * x;
+                parent[y * side + x] = child[c] + child[c + 1] + child[c + childSide] + child[c + childSide + 1];
+            }
+        }
+    }
+}
+
+void DensityQuadtree::add(int x, int y, int n) {
+    const int gx = std::clamp(x, VoterHistogram::kMinCoordinate, VoterHistogram::kMaxCoordinate) - VoterHistogram::kMinCoordinate;
+    const int gy = std::clamp(y, VoterHistogram::kMinCoordinate, VoterHistogram::kMaxCoordinate) - VoterHistogram::kMinCoordinate;
+    for (int level = 0; level < kLevels; ++level)
+        m_levels[level][(gy >> level) * levelSide(level) + (gx >> level)] += n;
+}
+
+int DensityQuadtree::levelSide(int level) {
+    return kSide >> level;
+}
+
+int DensityQuadtree::count(int level, int nodeX, int nodeY) const {
+    if (level < 0 || level >= kLevels) return 0;
+    const int side = levelSide(level);
+    if (nodeX < 0 || nodeY < 0 || nodeX >= side || nodeY >= side) return 0;
+    return m_levels[level][nodeY * side + nodeX];
+}
+
+int DensityQuadtree::countAt(int level, int x, int y) const {
+    if (x < VoterHistogram::kMinCoordinate || x > VoterHistogram::kMaxCoordinate
+        || y < VoterHistogram::kMinCoordinate || y > VoterHistogram::kMaxCoordinate) return 0;
+    return count(level, (x - VoterHistogram::kMinCoordinate) >> level, (y - VoterHistogram::kMinCoordinate) >> level);
+}
+
+int DensityQuadtree::levelForScale(double cellsPerPixel) {
+    if (cellsPerPixel <= 1.0) return 0;
+    return std::min(kLevels - 1, static_cast<int>(std::floor(std::log2(cellsPerPixel))));
+}
+
+int DensityQuadtree::total() const {
+    return m_levels[kLevels - 1][0];
+}
+
+qint64 DensityQuadtree::memoryBytes() const {
+    qint64 bytes = 0;
+    for (const std::vector<int>& level : m_levels)
+        bytes += qint64(level.capacity()) * qint64(sizeof(int));
+    return bytes;
+}
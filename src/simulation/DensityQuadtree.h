@@ -0,0 +1,74 @@
+#ifndef DENSITYQUADTREE_H
+#define DENSITYQUADTREE_H
+
+#include <vector>
+
+#include "VoterHistogram.h"
+
+/**
+ * @brief Pre-aggregated voter counts over the compass at every power-of-two zoom level.
+ *
+ * @details The 201 x 201 compass grid is padded to 256 x 256 and summed into a complete quadtree: level 0 holds single cells,
+ * and every node of level L covers a 2^L x 2^L block of cells. A renderer picks the level whose nodes are about one pixel wide
+ * and reads one node per pixel, so drawing cost follows the number of pixels rather than the number of voters or cells.
+ *
+ * Single-cell changes update one node per level (9 in total).
+ */
+class DensityQuadtree {
+public:
+    static constexpr int kSide = 256;           ///< Padded grid size at level 0.
+    static constexpr int kLevels = 9;           ///< Number of levels (256, 128, ..., 1 nodes per side).
+
+    /** @brief Constructs an empty quadtree. */
+    DensityQuadtree();
+
+    /** @brief Builds a quadtree from a voter histogram. */
+    explicit DensityQuadtree(const VoterHistogram& histogram);
+
+    /** @brief Replaces all counts with the cells of @p histogram. */
+    void rebuild(const VoterHistogram& histogram);
+
+    /**
+     * @brief Adds (or, for negative @p n, removes) voters at one compass coordinate.
+     * @param x X coordinate on the compass (clamped).
+     * @param y Y coordinate on the compass (clamped).
+     * @param n Change in voter count.
+     */
+    void add(int x, int y, int n);
+
+    /** @brief Returns the number of nodes along each axis at a level. */
+    static int levelSide(int level);
+
+    /**
+     * @brief Returns the voter count of a node.
+     * @param level Quadtree level (0 = single cells).
+     * @param nodeX Node column; node 0 starts at compass X = -100.
+     * @param nodeY Node row; node 0 starts at compass Y = -100.
+     * @return Voters inside the node, or 0 outside the grid.
+     */
+    int count(int level, int nodeX, int nodeY) const;
+
+    /**
+     * @brief Returns the node covering a compass coordinate at a level.
+     * @return Voters in the 2^level x 2^level block containing (x, y), or 0 off the compass.
+     */
+    int countAt(int level, int x, int y) const;
+
+    /**
+     * @brief Picks the coarsest level whose nodes are no wider than a pixel.
+     * @param cellsPerPixel Compass units covered by one screen pixel.
+     * @return Level in [0, kLevels).
+     */
+    static int levelForScale(double cellsPerPixel);
+
+    /** @brief Returns the total number of voters (the root node). */
+    int total() const;
+
+    /** @brief Returns the heap bytes held by every level. */
+    qint64 memoryBytes() const;
+
+private:
+    std::vector<int> m_levels[kLevels];     ///< Node counts per level, row-major, levelSide(level)^2 entries each.
+};
+
+#endif // DENSITYQUADTREE_H
@@ -0,0 +1,66 @@
+#include "DistanceKernels.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace {
+
+constexpr int kLanes = IdeologyPoints::kLanes;
+
+/**
+ * @brief Nearest-point scan over the first D axes; D = 0 reads the count from @p dimensions instead.
+ */
+template <int D>
+NearestPoint nearestFixed(const IdeologyPoints& candidates, const int* point, int dimensions) {
+    constexpr int kMaxAxes = 16;
+    const int axes = D > 0 ? D : dimensions;
+    const qint8* columns[kMaxAxes];
+    int query[kMaxAxes];
+    for (int a = 0; a < axes; ++a) {
+        columns[a] = candidates.axis(a);
+        query[a] = IdeologyPoints::clamp(point[a]);
+    }
+
+    NearestPoint best{ -1, INT_MAX };
+    const int count = candidates.size();
+    for (int base = 0; base < count; base += kLanes) {
+        // At most 16 axes of 200^2 each, so 32-bit lanes cannot overflow
+        alignas(64) qint32 distance[kLanes] = {};
+        for (int a = 0; a < axes; ++a) {
+            const qint8* column = columns[a] + base;
+            const qint32 q = query[a];
+            for (int lane = 0; lane < kLanes; ++lane) {
+                const qint32 d = qint32(column[lane]) - q;
+                distance[lane] += d * d;
+            }
+        }
+
+        const int lanes = std::min(kLanes, count - base);
+        for (int lane = 0; lane < lanes; ++lane) {
+            if (distance[lane] < best.distanceSquared) {
+                best.distanceSquared = distance[lane];
+                best.index = base + lane;
+            }
+        }
+    }
+    if (best.index < 0) best.distanceSquared = 0;
+    return best;
+}
+
+} // namespace
+
+NearestPoint DistanceKernels::nearest(const IdeologyPoints& candidates, const int* point, int dimensions) {
+    Q_ASSERT(dimensions >= 0 && dimensions <= candidates.dimensions() && dimensions <= 16);
+    switch (dimensions) {
+    case 2: return nearestFixed<2>(candidates, point, dimensions);
+    case 3: return nearestFixed<3>(candidates, point, dimensions);
+    case 4: return nearestFixed<4>(candidates, point, dimensions);
+    case 8: return nearestFixed<8>(candidates, point, dimensions);
+    case 16: return nearestFixed<16>(candidates, point, dimensions);
+    default: return nearestFixed<0>(candidates, point, dimensions);
+    }
+}
+
+bool DistanceKernels::specialized(int dimensions) {
+    return dimensions == 2 || dimensions == 3 || dimensions == 4 || dimensions == 8 || dimensions == 16;
+}
@@ -0,0 +1,36 @@
+#ifndef DISTANCEKERNELS_H
+#define DISTANCEKERNELS_H
+
+#include "IdeologyPoints.h"
+
+/**
+ * @brief Result of a nearest-point search.
+ */
+struct NearestPoint {
+    int index = -1;             ///< Index of the nearest candidate, or -1 if there were none.
+    int distanceSquared = 0;    ///< Its squared Euclidean distance to the query point.
+};
+
+/**
+ * @brief Nearest-point searches over the packed columns of IdeologyPoints.
+ *
+ * @details Candidates are scanned in blocks of IdeologyPoints::kLanes: for each axis the kernel adds the squared differences of a
+ * whole block to kLanes 32-bit accumulators, a loop without branches or tails that the compiler turns into SIMD code. The number
+ * of axes is a template parameter for the common counts (2, 3, 4, 8 and 16), so the axis loop is unrolled; other counts use a
+ * generic version of the same kernel. Ties go to the candidate with the lowest index, as in a plain linear scan.
+ */
+class DistanceKernels {
+public:
+    /**
+     * @brief Finds the candidate closest to a point.
+     * @param candidates Points to search.
+     * @param point Query coordinates, one per axis; clamped to the compass range.
+     * @param dimensions Number of leading axes to compare, at most candidates.dimensions().
+     */
+    static NearestPoint nearest(const IdeologyPoints& candidates, const int* point, int dimensions);
+
+    /** @brief Returns true if nearest() has a kernel compiled for exactly this number of axes. */
+    static bool specialized(int dimensions);
+};
+
+#endif // DISTANCEKERNELS_H
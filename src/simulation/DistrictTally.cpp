@@ -0,0 +1,142 @@
+#include "DistrictTally.h"
+#include "TaskScheduler.h"
+#include "TickArena.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace {
+
+constexpr int kMinVotersPerWorker = 16384;              // below this, threading costs more than it saves
+constexpr size_t kMaxPrivateCells = size_t(1) << 22;    // budget for per-chunk count buffers
+
+}
+
+DistrictTally::DistrictTally(const QVector<Voter>& voters, const QVector<Party>& parties, int districtCount)
+    : m_districtCount(std::max(0, districtCount))
+{
+    const int partyCount = parties.size();
+    for (const Party& p : parties)
+        m_partyIds.append(p.id);
+
+    const size_t cells = static_cast<size_t>(m_districtCount) * partyCount;
+    m_counts.assign(cells, 0);
+    if (cells == 0 || voters.isEmpty()) return;
+
+    // Lookup and per-chunk buffers are scratch: they come from the arena and are rewound when the tally is built
+    TickArena::Scope arenaScope;
+    std::pmr::memory_resource* arena = TickArena::resource();
+
+    TickArena::HashMap<int, int> partyIndex(arena);
+    partyIndex.reserve(partyCount);
+    for (int p = 0; p < partyCount; ++p)
+        partyIndex.emplace(m_partyIds[p], p);
+
+    // Flat cell of a voter, or -1 if the voter does not count
+    auto cellOf = [&](const Voter& v) -> qint64 {
+        if (v.districtId < 0 || v.districtId >= m_districtCount) return -1;
+        const auto p = partyIndex.find(v.partyId);
+        if (p == partyIndex.end()) return -1;
+        return static_cast<qint64>(v.districtId) * partyCount + p->second;
+    };
+
+    const int voterCount = voters.size();
+    TaskScheduler& scheduler = TaskScheduler::instance();
+    const int workers = std::max(1, std::min(scheduler.workerCount() + 1, voterCount / kMinVotersPerWorker));
+
+    if (workers == 1) {
+        for (const Voter& v : voters) {
+            const qint64 cell = cellOf(v);
+            if (cell >= 0) ++m_counts[cell];
+        }
+        return;
+    }
+
+    const int chunk = (voterCount + workers - 1) / workers;
+
+    if (cells * workers <= kMaxPrivateCells) {
+        // Few cells: every chunk counts into its own slice of one buffer, merged afterwards
+        TickArena::Vector<int> local(cells * workers, 0, arena);
+        scheduler.parallelFor(0, workers, 1, [&](int first, int last) {
+            for (int w = first; w < last; ++w) {
+                int* counts = local.data() + cells * w;
+                const int end = std::min(voterCount, (w + 1) * chunk);
+                for (int i = w * chunk; i < end; ++i) {
+                    const qint64 cell = cellOf(voters[i]);
+                    if (cell >= 0) ++counts[cell];
+                }
+            }
+        });
+        for (int w = 0; w < workers; ++w) {
+            const int* counts = local.data() + cells * w;
+            for (size_t c = 0; c < cells; ++c)
+                m_counts[c] += counts[c];
+        }
+    } else {
+        // Many districts: contention on any one cell is rare, so share one atomic buffer
+        // rather than paying for a per-chunk merge proportional to the district count
+        TickArena::Vector<std::atomic<int>> shared(cells, arena);
+        for (size_t c = 0; c < cells; ++c)
+            shared[c].store(0, std::memory_order_relaxed);
+        scheduler.parallelFor(0, voterCount, chunk, [&](int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                const qint64 cell = cellOf(voters[i]);
+                if (cell >= 0) shared[cell].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+        for (size_t c = 0; c < cells; ++c)
+            m_counts[c] = shared[c].load(std::memory_order_relaxed);
+    }
+}
+
+int DistrictTally::districtCount() const {
+    return m_districtCount;
+}
+
+int DistrictTally::partyCount() const {
+    return m_partyIds.size();
+}
+
+const QVector<int>& DistrictTally::partyIds() const {
+    return m_partyIds;
+}
+
+int DistrictTally::votes(int district, int partyIndex) const {
+    if (district < 0 || district >= m_districtCount || partyIndex < 0 || partyIndex >= m_partyIds.size()) return 0;
+    return m_counts[static_cast<size_t>(district) * m_partyIds.size() + partyIndex];
+}
+
+QVector<int> DistrictTally::districtVotes(int district) const {
+    QVector<int> result;
+    if (district < 0 || district >= m_districtCount) return result;
+    const int partyCount = m_partyIds.size();
+    const int* row = &m_counts[static_cast<size_t>(district) * partyCount];
+    result.reserve(partyCount);
+    for (int p = 0; p < partyCount; ++p)
+        result.append(row[p]);
+    return result;
+}
+
+const int* DistrictTally::districtRow(int district) const {
+    if (district < 0 || district >= m_districtCount || m_partyIds.isEmpty()) return nullptr;
+    return &m_counts[static_cast<size_t>(district) * m_partyIds.size()];
+}
+
+int DistrictTally::districtTotal(int district) const {
+    int total = 0;
+    for (int p = 0; p < m_partyIds.size(); ++p)
+        total += votes(district, p);
+    return total;
+}
+
+QMap<int, int> DistrictTally::nationalVotes() const {
+    QMap<int, int> totals;
+    const int partyCount = m_partyIds.size();
+    for (int p = 0; p < partyCount; ++p) {
+        int sum = 0;
+        for (int d = 0; d < m_districtCount; ++d)
+            sum += m_counts[static_cast<size_t>(d) * partyCount + p];
+        totals.insert(m_partyIds[p], sum);
+    }
+    return totals;
+}
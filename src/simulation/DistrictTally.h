@@ -0,0 +1,64 @@
+#ifndef DISTRICTTALLY_H
+#define DISTRICTTALLY_H
+
+#include <QMap>
+#include <QVector>
+
+#include <vector>
+
+#include "models/Voter.h"
+#include "models/PartyModel.h"
+
+/**
+ * @brief Vote counts of every party in every electoral district.
+ *
+ * @details The tally is built in a single linear pass over the voters, split into chunks run on the TaskScheduler, with its
+ * scratch buffers taken from the TickArena. Counts live in one flat district-major array, so the pass costs O(voters) whether
+ * there are ten districts or ten thousand. Voters without a district or whose party is not standing are ignored.
+ */
+class DistrictTally {
+public:
+    /** @brief Constructs an empty tally (no districts, no parties). */
+    DistrictTally() = default;
+
+    /**
+     * @brief Counts the votes of every district.
+     * @param voters Voters to count; each votes for their assigned party.
+     * @param parties Parties standing in every district.
+     * @param districtCount Number of districts; voters with a district outside [0, districtCount) are skipped.
+     */
+    DistrictTally(const QVector<Voter>& voters, const QVector<Party>& parties, int districtCount);
+
+    /** @brief Returns the number of districts. */
+    int districtCount() const;
+    /** @brief Returns the number of parties standing. */
+    int partyCount() const;
+    /** @brief Returns the party IDs in the order used by the party index. */
+    const QVector<int>& partyIds() const;
+
+    /**
+     * @brief Returns the votes a party received in a district.
+     * @param district District index.
+     * @param partyIndex Index of the party in partyIds().
+     */
+    int votes(int district, int partyIndex) const;
+
+    /** @brief Returns the vote counts of one district, indexed like partyIds(). */
+    QVector<int> districtVotes(int district) const;
+
+    /** @brief Returns the vote counts of one district as partyCount() contiguous values, or nullptr for an unknown district. */
+    const int* districtRow(int district) const;
+
+    /** @brief Returns the number of votes cast in a district. */
+    int districtTotal(int district) const;
+
+    /** @brief Returns the national vote total of every party, keyed by party ID. */
+    QMap<int, int> nationalVotes() const;
+
+private:
+    int m_districtCount = 0;            ///< Number of districts.
+    QVector<int> m_partyIds;            ///< Party IDs, indexed by party index.
+    std::vector<int> m_counts;          ///< Vote counts, @c partyCount entries per district.
+};
+
+#endif // DISTRICTTALLY_H
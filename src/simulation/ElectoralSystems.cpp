@@ -0,0 +1,244 @@
+#include "ElectoralSystems.h"
+
+#include <QDebug>
+
+#include <algorithm>
+#include <limits>
+
+RankedBallots::RankedBallots(const QVector<Voter>& voters, const QVector<Party>& parties, int depth)
+{
+    const int partyCount = parties.size();
+    if (partyCount > std::numeric_limits<quint16>::max()) {
+        qWarning() << "[RankedBallots] Too many parties:" << partyCount;
+        return;
+    }
+
+    m_ballotCount = voters.size();
+    m_depth = (depth <= 0 || depth > partyCount) ? partyCount : depth;
+
+    m_partyIds.reserve(partyCount);
+    m_partyX.reserve(partyCount);
+    m_partyY.reserve(partyCount);
+    for (const Party& p : parties) {
+        m_partyIds.append(p.id);
+        m_partyX.push_back(static_cast<qint16>(p.ideologyX));
+        m_partyY.push_back(static_cast<qint16>(p.ideologyY));
+    }
+
+    m_voterX.reserve(m_ballotCount);
+    m_voterY.reserve(m_ballotCount);
+    for (const Voter& v : voters) {
+        m_voterX.push_back(static_cast<qint16>(v.ideologyX));
+        m_voterY.push_back(static_cast<qint16>(v.ideologyY));
+    }
+
+    if (m_depth == 0) return;
+
+    m_rankings.resize(static_cast<size_t>(m_ballotCount) * m_depth);
+
+    // Squared distance in the high word, party index in the low word: ordering the keys
+    // orders by distance and breaks ties by list position.
+    std::vector<quint64> keys(partyCount);
+    for (int b = 0; b < m_ballotCount; ++b) {
+        const qint32 vx = m_voterX[b];
+        const qint32 vy = m_voterY[b];
+        for (int p = 0; p < partyCount; ++p) {
+            const qint32 dx = m_partyX[p] - vx;
+            const qint32 dy = m_partyY[p] - vy;
+            const quint32 d2 = static_cast<quint32>(dx * dx + dy * dy);
+            keys[p] = (static_cast<quint64>(d2) << 32) | static_cast<quint32>(p);
+        }
+        std::partial_sort(keys.begin(), keys.begin() + m_depth, keys.end());
+
+        quint16* out = &m_rankings[static_cast<size_t>(b) * m_depth];
+        for (int r = 0; r < m_depth; ++r)
+            out[r] = static_cast<quint16>(keys[r] & 0xFFFFu);
+    }
+}
+
+int RankedBallots::ballotCount() const {
+    return m_ballotCount;
+}
+
+int RankedBallots::partyCount() const {
+    return m_partyIds.size();
+}
+
+int RankedBallots::depth() const {
+    return m_depth;
+}
+
+int RankedBallots::preferenceAt(int ballot, int rank) const {
+    if (ballot < 0 || ballot >= m_ballotCount || rank < 0 || rank >= m_depth) return -1;
+    return m_partyIds[m_rankings[static_cast<size_t>(ballot) * m_depth + rank]];
+}
+
+ElectionTally RankedBallots::plurality() const {
+    ElectionTally tally;
+    tally.system = "First past the post";
+
+    const int partyCount = m_partyIds.size();
+    if (m_depth == 0) return tally;
+
+    std::vector<int> counts(partyCount, 0);
+    for (int b = 0; b < m_ballotCount; ++b)
+        ++counts[m_rankings[static_cast<size_t>(b) * m_depth]];
+
+    int best = -1;
+    for (int p = 0; p < partyCount; ++p) {
+        tally.scores.insert(m_partyIds[p], counts[p]);
+        if (best == -1 || counts[p] > counts[best]) best = p;
+    }
+    tally.winnerId = m_partyIds[best];
+    return tally;
+}
+
+ElectionTally RankedBallots::instantRunoff() const {
+    ElectionTally tally;
+    tally.system = "Instant runoff";
+
+    const int partyCount = m_partyIds.size();
+    if (m_depth == 0) return tally;
+
+    std::vector<int> position(m_ballotCount, 0);            // current rank of each ballot
+    std::vector<std::vector<int>> piles(partyCount);        // ballots currently counting for each party
+    std::vector<char> eliminated(partyCount, 0);
+
+    for (int b = 0; b < m_ballotCount; ++b)
+        piles[m_rankings[static_cast<size_t>(b) * m_depth]].push_back(b);
+
+    int activeBallots = m_ballotCount;
+    int remaining = partyCount;
+
+    while (true) {
+        QMap<int, int> round;
+        int leader = -1;
+        int loser = -1;
+        for (int p = 0; p < partyCount; ++p) {
+            if (eliminated[p]) continue;
+            const int votes = static_cast<int>(piles[p].size());
+            round.insert(m_partyIds[p], votes);
+            if (leader == -1 || votes > static_cast<int>(piles[leader].size())) leader = p;
+            if (loser == -1 || votes <= static_cast<int>(piles[loser].size())) loser = p;
+        }
+        tally.rounds.append(round);
+
+        if (remaining == 1 || static_cast<qint64>(piles[leader].size()) * 2 > activeBallots) {
+            tally.winnerId = m_partyIds[leader];
+            break;
+        }
+
+        // Move only the eliminated party's ballots to their next surviving preference.
+        eliminated[loser] = 1;
+        --remaining;
+        for (int b : piles[loser]) {
+            const quint16* ballot = &m_rankings[static_cast<size_t>(b) * m_depth];
+            int r = position[b] + 1;
+            while (r < m_depth && eliminated[ballot[r]]) ++r;
+            position[b] = r;
+            if (r < m_depth)
+                piles[ballot[r]].push_back(b);
+            else
+                --activeBallots;                            // ballot exhausted
+        }
+        std::vector<int>().swap(piles[loser]);
+    }
+
+    for (int p = 0; p < partyCount; ++p)
+        tally.scores.insert(m_partyIds[p], static_cast<double>(piles[p].size()));
+    return tally;
+}
+
+ElectionTally RankedBallots::borda() const {
+    ElectionTally tally;
+    tally.system = "Borda count";
+
+    const int partyCount = m_partyIds.size();
+    if (m_depth == 0) return tally;
+
+    std::vector<qint64> points(partyCount, 0);
+    for (int b = 0; b < m_ballotCount; ++b) {
+        const quint16* ballot = &m_rankings[static_cast<size_t>(b) * m_depth];
+        for (int r = 0; r < m_depth; ++r)
+            points[ballot[r]] += partyCount - 1 - r;
+    }
+
+    int best = -1;
+    for (int p = 0; p < partyCount; ++p) {
+        tally.scores.insert(m_partyIds[p], static_cast<double>(points[p]));
+        if (best == -1 || points[p] > points[best]) best = p;
+    }
+    tally.winnerId = m_partyIds[best];
+    return tally;
+}
+
+ElectionTally RankedBallots::approval(double maxDistance) const {
+    ElectionTally tally;
+    tally.system = "Approval";
+
+    const int partyCount = m_partyIds.size();
+    if (partyCount == 0) return tally;
+
+    // Approval is independent of ballot depth, so it works on the packed coordinates directly.
+    const double limit = maxDistance < 0 ? -1.0 : maxDistance * maxDistance;
+    std::vector<int> approvals(partyCount, 0);
+    for (int b = 0; b < m_ballotCount; ++b) {
+        const qint32 vx = m_voterX[b];
+        const qint32 vy = m_voterY[b];
+        for (int p = 0; p < partyCount; ++p) {
+            const qint32 dx = m_partyX[p] - vx;
+            const qint32 dy = m_partyY[p] - vy;
+            if (dx * dx + dy * dy <= limit) ++approvals[p];
+        }
+    }
+
+    int best = -1;
+    for (int p = 0; p < partyCount; ++p) {
+        tally.scores.insert(m_partyIds[p], approvals[p]);
+        if (best == -1 || approvals[p] > approvals[best]) best = p;
+    }
+    tally.winnerId = m_partyIds[best];
+    return tally;
+}
+
+ElectionTally RankedBallots::condorcet() const {
+    ElectionTally tally;
+    tally.system = "Condorcet";
+
+    const int partyCount = m_partyIds.size();
+    if (m_depth == 0) return tally;
+
+    // prefers[a * partyCount + b] = number of ballots ranking a above b
+    std::vector<int> prefers(static_cast<size_t>(partyCount) * partyCount, 0);
+    std::vector<char> ranked(partyCount, 0);
+    for (int b = 0; b < m_ballotCount; ++b) {
+        const quint16* ballot = &m_rankings[static_cast<size_t>(b) * m_depth];
+        for (int r = 0; r < m_depth; ++r) {
+            int* row = &prefers[static_cast<size_t>(ballot[r]) * partyCount];
+            for (int s = r + 1; s < m_depth; ++s)
+                ++row[ballot[s]];
+            ranked[ballot[r]] = 1;
+        }
+        if (m_depth < partyCount) {
+            for (int r = 0; r < m_depth; ++r) {
+                int* row = &prefers[static_cast<size_t>(ballot[r]) * partyCount];
+                for (int q = 0; q < partyCount; ++q)
+                    if (!ranked[q]) ++row[q];
+            }
+        }
+        for (int r = 0; r < m_depth; ++r)
+            ranked[ballot[r]] = 0;
+    }
+
+    for (int a = 0; a < partyCount; ++a) {
+        int wins = 0;
+        for (int c = 0; c < partyCount; ++c) {
+            if (a == c) continue;
+            if (prefers[static_cast<size_t>(a) * partyCount + c] > prefers[static_cast<size_t>(c) * partyCount + a])
+                ++wins;
+        }
+        tally.scores.insert(m_partyIds[a], wins);
+        if (wins == partyCount - 1) tally.winnerId = m_partyIds[a];
+    }
+    return tally;
+}
@@ -0,0 +1,94 @@
+#ifndef ELECTORALSYSTEMS_H
+#define ELECTORALSYSTEMS_H
+
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+#include <vector>
+
+#include "models/Voter.h"
+#include "models/PartyModel.h"
+
+/**
+ * @brief Result of counting one election under a particular electoral system.
+ */
+struct ElectionTally {
+    QString system;                     ///< Name of the electoral system that produced this tally.
+    QMap<int, double> scores;           ///< Final score per party ID (votes, Borda points, approvals or pairwise wins).
+    int winnerId = -1;                  ///< ID of the winning party, or -1 if there is no winner (e.g. no Condorcet winner).
+    QVector<QMap<int, int>> rounds;     ///< Instant-runoff only: vote count of every remaining party per round.
+};
+
+/**
+ * @brief Distance-ranked ballots of every voter, used to count ranked electoral systems.
+ *
+ * @details Each voter ranks the parties by Euclidean distance to their ideology. Distances are packed together with the party index into
+ * 64-bit keys and only the top @c depth entries are ordered with a partial sort, so building the ballots costs O(voters * parties * log(depth)).
+ * Ties are broken by the party's position in the list, which matches VoterModel::findClosestPartyId.
+ */
+class RankedBallots {
+public:
+    /**
+     * @brief Builds the ranked ballots for the given voters and parties.
+     * @param voters Voters casting the ballots.
+     * @param parties Parties standing in the election.
+     * @param depth How many preferences each ballot holds; values <= 0 or larger than the party count rank every party.
+     */
+    RankedBallots(const QVector<Voter>& voters, const QVector<Party>& parties, int depth = -1);
+
+    /** @brief Returns the number of ballots (one per voter). */
+    int ballotCount() const;
+    /** @brief Returns the number of parties standing. */
+    int partyCount() const;
+    /** @brief Returns the number of preferences stored on each ballot. */
+    int depth() const;
+
+    /**
+     * @brief Returns the party ID at a given rank on a ballot.
+     * @param ballot Ballot (voter) index.
+     * @param rank Preference rank, 0 being the closest party.
+     * @return The party ID, or -1 if the indices are out of range.
+     */
+    int preferenceAt(int ballot, int rank) const;
+
+    /** @brief First-past-the-post: every ballot counts for its first preference. */
+    ElectionTally plurality() const;
+
+    /**
+     * @brief Instant-runoff voting.
+     *
+     * The party with the fewest votes is eliminated each round until one party holds a majority of the non-exhausted ballots.
+     * Only the ballots of the eliminated party are moved to their next preference, so the whole count costs O(ballots * depth).
+     */
+    ElectionTally instantRunoff() const;
+
+    /** @brief Borda count: rank r earns (partyCount - 1 - r) points, unranked parties earn nothing. */
+    ElectionTally borda() const;
+
+    /**
+     * @brief Approval voting.
+     * @param maxDistance Voters approve every party whose ideology lies within this distance of their own.
+     */
+    ElectionTally approval(double maxDistance) const;
+
+    /**
+     * @brief Condorcet method with Copeland scores.
+     *
+     * Scores are the number of pairwise contests each party wins. The winner is the party that beats every other party head to head, or -1 if none does.
+     * Ranked parties are preferred over unranked ones; unranked parties are tied with each other.
+     */
+    ElectionTally condorcet() const;
+
+private:
+    QVector<int> m_partyIds;                ///< Party IDs, indexed by party index.
+    int m_depth = 0;                        ///< Number of preferences per ballot.
+    int m_ballotCount = 0;                  ///< Number of ballots.
+    std::vector<quint16> m_rankings;        ///< Party indices, @c m_depth per ballot, closest first.
+    std::vector<qint16> m_voterX;           ///< Packed voter X coordinates (for approval voting).
+    std::vector<qint16> m_voterY;           ///< Packed voter Y coordinates (for approval voting).
+    std::vector<qint16> m_partyX;           ///< Packed party X coordinates.
+    std::vector<qint16> m_partyY;           ///< Packed party Y coordinates.
+};
+
+#endif // ELECTORALSYSTEMS_H
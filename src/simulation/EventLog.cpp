@@ -0,0 +1,403 @@
+#include "EventLog.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QHash>
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+constexpr quint32 kMagic = 0x50534556;      // "PSEV"
+constexpr quint16 kFormatVersion = 1;
+constexpr qint64 kFileHeaderSize = 6;       // magic + version
+constexpr qint64 kRecordHeaderSize = 9;     // type (1) + tick (4) + payload size (4)
+
+QDataStream& configure(QDataStream& stream) {
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    return stream;
+}
+
+void writeParty(QDataStream& out, const Party& party) {
+    out << qint32(party.id) << party.name << qint32(party.ideologyId)
+        << qint32(party.ideologyX) << qint32(party.ideologyY);
+}
+
+Party readParty(QDataStream& in) {
+    Party party;
+    qint32 id, ideologyId, x, y;
+    in >> id >> party.name >> ideologyId >> x >> y;
+    party.id = id;
+    party.ideologyId = ideologyId;
+    party.ideologyX = x;
+    party.ideologyY = y;
+    return party;
+}
+
+void writeVoter(QDataStream& out, const Voter& voter) {
+    out << qint32(voter.id) << qint32(voter.ideologyId) << qint32(voter.ideologyX)
+        << qint32(voter.ideologyY) << qint32(voter.districtId);
+}
+
+Voter readVoter(QDataStream& in) {
+    Voter voter;
+    qint32 id, ideologyId, x, y, districtId;
+    in >> id >> ideologyId >> x >> y >> districtId;
+    voter.id = id;
+    voter.ideologyId = ideologyId;
+    voter.ideologyX = x;
+    voter.ideologyY = y;
+    voter.districtId = districtId;
+    return voter;
+}
+
+/**
+ * @brief Scenario being rebuilt from log records.
+ *
+ * Voters' parties are derived from the nearest party. A voter that moves is reassigned on its own; a party change marks every
+ * assignment stale, and they are recomputed at most once before the next tally.
+ */
+class ReplayState {
+public:
+    void apply(EventLog::RecordType type, QDataStream& in) {
+        switch (type) {
+        case EventLog::RecordType::PartyChanged: {
+            const Party party = readParty(in);
+            m_parties.insert(party.id, party);
+            m_assignmentsStale = true;
+            break;
+        }
+        case EventLog::RecordType::PartyRemoved: {
+            qint32 id;
+            in >> id;
+            m_parties.remove(id);
+            m_assignmentsStale = true;
+            break;
+        }
+        case EventLog::RecordType::VoterChanged: {
+            Voter voter = readVoter(in);
+            unassign(voter.id);
+            if (!m_assignmentsStale) assign(voter);
+            m_voters.insert(voter.id, voter);
+            break;
+        }
+        case EventLog::RecordType::VoterRemoved: {
+            qint32 id;
+            in >> id;
+            unassign(id);
+            m_voters.remove(id);
+            break;
+        }
+        case EventLog::RecordType::VotersMoved: {
+            quint32 count;
+            in >> count;
+            for (quint32 i = 0; i < count; ++i) {
+                qint32 id, x, y, ideologyId;
+                in >> id >> x >> y >> ideologyId;
+                auto it = m_voters.find(id);
+                if (it == m_voters.end()) continue;
+                unassign(id);
+                it->ideologyX = x;
+                it->ideologyY = y;
+                it->ideologyId = ideologyId;
+                if (!m_assignmentsStale) assign(*it);
+            }
+            break;
+        }
+        case EventLog::RecordType::Checkpoint: {
+            m_parties.clear();
+            m_voters.clear();
+            quint32 partyCount, voterCount;
+            in >> partyCount;
+            for (quint32 i = 0; i < partyCount; ++i) {
+                const Party party = readParty(in);
+                m_parties.insert(party.id, party);
+            }
+            in >> voterCount;
+            m_voters.reserve(voterCount);
+            for (quint32 i = 0; i < voterCount; ++i) {
+                const Voter voter = readVoter(in);
+                m_voters.insert(voter.id, voter);
+            }
+            m_assignmentsStale = true;
+            break;
+        }
+        case EventLog::RecordType::Tick:
+            break;
+        }
+    }
+
+    QMap<int, int> tally() {
+        refreshAssignments();
+        QMap<int, int> result;
+        for (auto it = m_tally.cbegin(); it != m_tally.cend(); ++it)
+            if (it.value() > 0) result.insert(it.key(), it.value());
+        return result;
+    }
+
+    SimulationState snapshot(int tick) {
+        refreshAssignments();
+        SimulationState state;
+        state.tick = tick;
+        state.parties.reserve(m_parties.size());
+        for (const Party& p : m_parties) state.parties.append(p);
+        state.voters.reserve(m_voters.size());
+        for (const Voter& v : m_voters) state.voters.append(v);
+        std::sort(state.voters.begin(), state.voters.end(),
+                  [](const Voter& a, const Voter& b) { return a.id < b.id; });
+        return state;
+    }
+
+private:
+    void refreshAssignments() {
+        if (!m_assignmentsStale) return;
+        m_tally.clear();
+        for (Voter& v : m_voters) assign(v);
+        m_assignmentsStale = false;
+    }
+
+    // Same rule as VoterModel::findClosestPartyId: strictly closer wins, so ties go to the lower ID
+    void assign(Voter& voter) {
+        int best = std::numeric_limits<int>::max();
+        int bestId = -1;
+        for (const Party& p : m_parties) {
+            const int dx = p.ideologyX - voter.ideologyX;
+            const int dy = p.ideologyY - voter.ideologyY;
+            const int d2 = dx * dx + dy * dy;
+            if (d2 < best) {
+                best = d2;
+                bestId = p.id;
+            }
+        }
+        voter.partyId = bestId;
+        ++m_tally[bestId];
+    }
+
+    void unassign(int voterId) {
+        if (m_assignmentsStale) return;
+        auto it = m_voters.constFind(voterId);
+        if (it != m_voters.cend()) --m_tally[it->partyId];
+    }
+
+    QMap<int, Party> m_parties;             ///< Parties ordered by ID, the order PartyModel loads them in.
+    QHash<int, Voter> m_voters;             ///< Voters keyed by ID.
+    QHash<int, int> m_tally;                ///< Voters per party ID, valid while assignments are fresh.
+    bool m_assignmentsStale = true;         ///< True when parties changed since voters were last assigned.
+};
+
+}
+
+QMap<int, int> SimulationState::tally() const {
+    QMap<int, int> result;
+    for (const Voter& v : voters) ++result[v.partyId];
+    return result;
+}
+
+EventLog::EventLog(const QString& path, int checkpointInterval)
+    : m_file(path), m_checkpointInterval(std::max(1, checkpointInterval))
+{
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        qWarning() << "[EventLog] Failed to open" << path << ":" << m_file.errorString();
+        return;
+    }
+
+    if (m_file.size() == 0) {
+        QDataStream out(&m_file);
+        configure(out) << kMagic << kFormatVersion;
+        m_file.flush();
+        return;
+    }
+
+    QDataStream in(&m_file);
+    quint32 magic = 0;
+    quint16 version = 0;
+    configure(in) >> magic >> version;
+    if (magic != kMagic || version != kFormatVersion) {
+        qWarning() << "[EventLog]" << path << "is not a simulation event log (or has an unsupported version)";
+        m_file.close();
+        return;
+    }
+    indexExistingRecords();
+}
+
+QString EventLog::pathForDatabase(const QString& databasePath) {
+    return databasePath + ".events";
+}
+
+bool EventLog::isOpen() const {
+    return m_file.isOpen();
+}
+
+bool EventLog::isEmpty() const {
+    return m_file.size() <= kFileHeaderSize;
+}
+
+int EventLog::currentTick() const {
+    return m_currentTick;
+}
+
+int EventLog::checkpointInterval() const {
+    return m_checkpointInterval;
+}
+
+void EventLog::recordPartyChanged(const Party& party) {
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    writeParty(configure(out), party);
+    append(RecordType::PartyChanged, payload);
+}
+
+void EventLog::recordPartyRemoved(int partyId) {
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    configure(out) << qint32(partyId);
+    append(RecordType::PartyRemoved, payload);
+}
+
+void EventLog::recordVoterChanged(const Voter& voter) {
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    writeVoter(configure(out), voter);
+    append(RecordType::VoterChanged, payload);
+}
+
+void EventLog::recordVoterRemoved(int voterId) {
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    configure(out) << qint32(voterId);
+    append(RecordType::VoterRemoved, payload);
+}
+
+void EventLog::recordVotersMoved(const QVector<Voter>& voters) {
+    if (voters.isEmpty()) return;
+    QByteArray payload;
+    payload.reserve(4 + voters.size() * 16);
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    configure(out) << quint32(voters.size());
+    for (const Voter& v : voters)
+        out << qint32(v.id) << qint32(v.ideologyX) << qint32(v.ideologyY) << qint32(v.ideologyId);
+    append(RecordType::VotersMoved, payload);
+}
+
+void EventLog::beginTick(int tick) {
+    m_currentTick = tick;
+    append(RecordType::Tick, QByteArray());
+}
+
+bool EventLog::checkpointDue() const {
+    return m_checkpoints.isEmpty() || m_currentTick - m_checkpoints.last().tick >= m_checkpointInterval;
+}
+
+void EventLog::recordCheckpoint(const QVector<Party>& parties, const QVector<Voter>& voters) {
+    QByteArray payload;
+    payload.reserve(8 + parties.size() * 48 + voters.size() * 20);
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    configure(out) << quint32(parties.size());
+    for (const Party& p : parties) writeParty(out, p);
+    out << quint32(voters.size());
+    for (const Voter& v : voters) writeVoter(out, v);
+
+    m_checkpoints.append({ m_currentTick, m_file.size() });
+    append(RecordType::Checkpoint, payload);
+}
+
+void EventLog::append(RecordType type, const QByteArray& payload) {
+    if (!m_file.isOpen()) return;
+    m_file.seek(m_file.size());
+    QDataStream out(&m_file);
+    configure(out) << quint8(type) << qint32(m_currentTick) << quint32(payload.size());
+    out.writeRawData(payload.constData(), payload.size());
+}
+
+void EventLog::indexExistingRecords() {
+    QDataStream in(&m_file);
+    configure(in);
+    m_file.seek(kFileHeaderSize);
+    while (m_file.size() - m_file.pos() >= kRecordHeaderSize) {
+        const qint64 offset = m_file.pos();
+        quint8 type;
+        qint32 tick;
+        quint32 size;
+        in >> type >> tick >> size;
+        if (m_file.size() - m_file.pos() < size) {
+            // A record cut short by a crash; drop it so new records start on a clean boundary
+            qWarning() << "[EventLog] Truncating incomplete record at offset" << offset;
+            m_file.resize(offset);
+            break;
+        }
+        m_currentTick = tick;
+        if (static_cast<RecordType>(type) == RecordType::Checkpoint)
+            m_checkpoints.append({ tick, offset });
+        in.skipRawData(static_cast<int>(size));
+    }
+}
+
+SimulationState EventLog::stateAt(int tick) {
+    ReplayState state;
+    if (!m_file.isOpen()) return state.snapshot(tick);
+    m_file.flush();
+
+    // Start at the last checkpoint taken at or before the requested tick
+    qint64 offset = kFileHeaderSize;
+    for (const CheckpointEntry& entry : m_checkpoints) {
+        if (entry.tick > tick) break;
+        offset = entry.offset;
+    }
+
+    QDataStream in(&m_file);
+    configure(in);
+    m_file.seek(offset);
+    while (m_file.size() - m_file.pos() >= kRecordHeaderSize) {
+        quint8 type;
+        qint32 recordTick;
+        quint32 size;
+        in >> type >> recordTick >> size;
+        if (recordTick > tick) break;
+        const QByteArray payload = m_file.read(size);
+        QDataStream record(payload);
+        state.apply(static_cast<RecordType>(type), configure(record));
+    }
+    return state.snapshot(tick);
+}
+
+QVector<QMap<int, int>> EventLog::popularityHistory(int fromTick, int toTick) {
+    QVector<QMap<int, int>> history;
+    if (!m_file.isOpen() || toTick < fromTick) return history;
+    m_file.flush();
+    history.reserve(toTick - fromTick + 1);
+
+    qint64 offset = kFileHeaderSize;
+    for (const CheckpointEntry& entry : m_checkpoints) {
+        if (entry.tick > fromTick) break;
+        offset = entry.offset;
+    }
+
+    ReplayState state;
+    QDataStream in(&m_file);
+    configure(in);
+    m_file.seek(offset);
+    int reportedTick = fromTick;
+    while (reportedTick <= toTick && m_file.size() - m_file.pos() >= kRecordHeaderSize) {
+        quint8 type;
+        qint32 recordTick;
+        quint32 size;
+        in >> type >> recordTick >> size;
+        // A record from a later tick closes every tick before it
+        while (recordTick > reportedTick && reportedTick <= toTick) {
+            history.append(state.tally());
+            ++reportedTick;
+        }
+        if (reportedTick > toTick) break;
+        const QByteArray payload = m_file.read(size);
+        QDataStream record(payload);
+        state.apply(static_cast<RecordType>(type), configure(record));
+    }
+    // Ticks after the end of the log keep the final standings
+    while (reportedTick <= toTick) {
+        history.append(state.tally());
+        ++reportedTick;
+    }
+    return history;
+}
@@ -0,0 +1,125 @@
+#ifndef EVENTLOG_H
+#define EVENTLOG_H
+
+#include <QFile>
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+#include "models/Voter.h"
+#include "models/PartyModel.h"
+
+/**
+ * @brief Snapshot of the scenario at one simulation tick, rebuilt from the event log.
+ */
+struct SimulationState {
+    int tick = 0;                   ///< Tick the state belongs to.
+    QVector<Party> parties;         ///< Parties, ordered by ID.
+    QVector<Voter> voters;          ///< Voters with coordinates, party, ideology and district (names are not logged).
+
+    /** @brief Counts the voters of every party, keyed by party ID (-1 for voters without a party). */
+    QMap<int, int> tally() const;
+};
+
+/**
+ * @brief Append-only binary log of scenario changes with periodic checkpoints.
+ *
+ * @details Party and voter changes, drift moves and simulation ticks are appended as small binary records, each stamped with
+ * the tick it happened in. Every checkpointInterval() ticks a full checkpoint of all parties and voters is written as well. The offsets of checkpoints are
+ * indexed in memory, so rebuilding any tick restores the nearest earlier checkpoint and only replays the records after it.
+ *
+ * Voters' parties are not logged: replay derives them from the nearest party, exactly like VoterModel::reassignAllVoterParties,
+ * so a party move costs one record rather than one per voter.
+ */
+class EventLog {
+public:
+    /** @brief Kinds of records stored in the log. */
+    enum class RecordType : quint8 {
+        PartyChanged = 1,       ///< A party was added or edited.
+        PartyRemoved = 2,       ///< A party was deleted.
+        VoterChanged = 3,       ///< A voter was added or edited.
+        VoterRemoved = 4,       ///< A voter was deleted.
+        VotersMoved = 5,        ///< A batch of voters moved (e.g. drift during a tick).
+        Tick = 6,               ///< A simulation tick started.
+        Checkpoint = 7          ///< Full state of all parties and voters.
+    };
+
+    /**
+     * @brief Opens (or creates) a log file and indexes its checkpoints.
+     * @param path File to append to.
+     * @param checkpointInterval Number of ticks between automatic checkpoints.
+     */
+    explicit EventLog(const QString& path, int checkpointInterval = 100);
+
+    /**
+     * @brief Returns the log file that belongs to a database: its path with ".events" appended.
+     * @param databasePath Path of the SQLite database the log records changes of.
+     */
+    static QString pathForDatabase(const QString& databasePath);
+
+    /** @brief Returns true if the log file could be opened. */
+    bool isOpen() const;
+
+    /** @brief Returns true if the log holds no records yet. */
+    bool isEmpty() const;
+
+    /** @brief Returns the tick new records belong to (0 before the first tick). */
+    int currentTick() const;
+
+    /** @brief Returns the number of ticks between automatic checkpoints. */
+    int checkpointInterval() const;
+
+    /** @brief Records a party that was added or changed. */
+    void recordPartyChanged(const Party& party);
+    /** @brief Records a deleted party. */
+    void recordPartyRemoved(int partyId);
+    /** @brief Records a voter that was added or changed. */
+    void recordVoterChanged(const Voter& voter);
+    /** @brief Records a deleted voter. */
+    void recordVoterRemoved(int voterId);
+    /** @brief Records new coordinates for a batch of voters (only ID, X and Y are stored). */
+    void recordVotersMoved(const QVector<Voter>& voters);
+
+    /**
+     * @brief Starts a new simulation tick; records appended afterwards belong to it.
+     * @param tick Number of the tick that begins.
+     */
+    void beginTick(int tick);
+
+    /** @brief Returns true if checkpointInterval() ticks have passed since the last checkpoint (or none exists yet). */
+    bool checkpointDue() const;
+
+    /** @brief Records the full state of all parties and voters. */
+    void recordCheckpoint(const QVector<Party>& parties, const QVector<Voter>& voters);
+
+    /**
+     * @brief Rebuilds the scenario as it was at a given tick.
+     * @param tick Tick to rebuild; includes every change stamped with that tick or an earlier one.
+     * @return The reconstructed state (empty if nothing was logged).
+     */
+    SimulationState stateAt(int tick);
+
+    /**
+     * @brief Computes the party tally after every tick in a range, in one pass over the log.
+     * @param fromTick First tick to report.
+     * @param toTick Last tick to report.
+     * @return One tally per tick from @p fromTick to @p toTick (party ID to voter count).
+     */
+    QVector<QMap<int, int>> popularityHistory(int fromTick, int toTick);
+
+private:
+    struct CheckpointEntry {
+        int tick;                   ///< Tick the checkpoint was taken at.
+        qint64 offset;              ///< File offset of the checkpoint record.
+    };
+
+    void append(RecordType type, const QByteArray& payload);   ///< Writes one record at the end of the file.
+    void indexExistingRecords();                                ///< Scans the file for ticks and checkpoints.
+
+    QFile m_file;                                   ///< Log file, kept open for appending.
+    int m_checkpointInterval;                       ///< Ticks between automatic checkpoints.
+    int m_currentTick = 0;                          ///< Tick new records belong to.
+    QVector<CheckpointEntry> m_checkpoints;         ///< Checkpoint offsets in file order.
+};
+
+#endif // EVENTLOG_H
@@ -0,0 +1,86 @@
+#include "IdeologyPoints.h"
+
+#include <algorithm>
+
+IdeologyPoints::IdeologyPoints(int dimensions)
+    : m_dimensions(std::max(0, dimensions)), m_axes(m_dimensions)
+{
+}
+
+int IdeologyPoints::dimensions() const {
+    return m_dimensions;
+}
+
+int IdeologyPoints::size() const {
+    return m_size;
+}
+
+void IdeologyPoints::clear() {
+    resize(0);
+}
+
+void IdeologyPoints::reserve(int count) {
+    const size_t padded = (static_cast<size_t>(std::max(0, count)) + kLanes - 1) / kLanes * kLanes;
+    for (std::vector<qint8>& column : m_axes)
+        column.reserve(padded);
+}
+
+void IdeologyPoints::append(const int* position) {
+    resize(m_size + 1);
+    for (int a = 0; a < m_dimensions; ++a)
+        m_axes[a][m_size - 1] = static_cast<qint8>(position ? clamp(position[a]) : 0);
+}
+
+void IdeologyPoints::set(int index, const int* position) {
+    for (int a = 0; a < m_dimensions; ++a)
+        m_axes[a][index] = static_cast<qint8>(clamp(position[a]));
+}
+
+void IdeologyPoints::setCoordinate(int index, int axis, int value) {
+    m_axes[axis][index] = static_cast<qint8>(clamp(value));
+}
+
+int IdeologyPoints::coordinate(int index, int axis) const {
+    return m_axes[axis][index];
+}
+
+void IdeologyPoints::swapRemove(int index) {
+    const int last = m_size - 1;
+    for (std::vector<qint8>& column : m_axes)
+        column[index] = column[last];
+    resize(last);
+}
+
+void IdeologyPoints::keepRows(const std::vector<bool>& keep) {
+    int kept = 0;
+    for (int i = 0; i < m_size; ++i) {
+        if (!keep[i]) continue;
+        for (std::vector<qint8>& column : m_axes)
+            column[kept] = column[i];
+        ++kept;
+    }
+    resize(kept);
+}
+
+const qint8* IdeologyPoints::axis(int axis) const {
+    return m_axes[axis].data();
+}
+
+qint64 IdeologyPoints::memoryBytes() const {
+    qint64 bytes = static_cast<qint64>(m_axes.capacity() * sizeof(std::vector<qint8>));
+    for (const std::vector<qint8>& column : m_axes)
+        bytes += static_cast<qint64>(column.capacity());
+    return bytes;
+}
+
+int IdeologyPoints::clamp(int value) {
+    return std::clamp(value, kMinCoordinate, kMaxCoordinate);
+}
+
+void IdeologyPoints::resize(int count) {
+    m_size = count;
+    // Padding entries may hold stale coordinates; the kernels never report a lane past size()
+    const size_t padded = (static_cast<size_t>(count) + kLanes - 1) / kLanes * kLanes;
+    for (std::vector<qint8>& column : m_axes)
+        column.resize(padded, 0);
+}
@@ -0,0 +1,77 @@
+#ifndef IDEOLOGYPOINTS_H
+#define IDEOLOGYPOINTS_H
+
+#include <QtGlobal>
+
+#include <vector>
+
+/**
+ * @brief Positions in an N-dimensional ideology space, stored one packed column per axis.
+ *
+ * @details Coordinates are clamped to the compass range [-100, 100], so one byte per axis is enough. Each column is padded to a
+ * multiple of kLanes entries, which lets the DistanceKernels read whole blocks of points without a scalar tail. Point i of
+ * the set is entry i of every column; removal moves the last point into the gap, like the rows of VoterModel.
+ */
+class IdeologyPoints {
+public:
+    static constexpr int kLanes = 16;          ///< Points per block read by the distance kernels; columns are padded to it.
+    static constexpr int kMinCoordinate = -100; ///< Smallest stored coordinate.
+    static constexpr int kMaxCoordinate = 100;  ///< Largest stored coordinate.
+
+    /** @brief Constructs an empty set of points with the given number of axes (0 is allowed). */
+    explicit IdeologyPoints(int dimensions = 0);
+
+    /** @brief Returns the number of axes. */
+    int dimensions() const;
+
+    /** @brief Returns the number of points. */
+    int size() const;
+
+    /** @brief Removes every point, keeping the number of axes. */
+    void clear();
+
+    /** @brief Reserves room for @p count points. */
+    void reserve(int count);
+
+    /**
+     * @brief Appends a point.
+     * @param position dimensions() coordinates, or nullptr for the origin.
+     */
+    void append(const int* position);
+
+    /** @brief Overwrites every coordinate of a point. */
+    void set(int index, const int* position);
+
+    /** @brief Overwrites one coordinate of a point. */
+    void setCoordinate(int index, int axis, int value);
+
+    /** @brief Returns one coordinate of a point. */
+    int coordinate(int index, int axis) const;
+
+    /** @brief Removes a point by moving the last one into its place. */
+    void swapRemove(int index);
+
+    /**
+     * @brief Keeps the points whose flag is set, in their current order.
+     * @param keep One flag per point.
+     */
+    void keepRows(const std::vector<bool>& keep);
+
+    /** @brief Returns the column of an axis, padded to a multiple of kLanes entries. */
+    const qint8* axis(int axis) const;
+
+    /** @brief Returns the heap bytes held by the columns. */
+    qint64 memoryBytes() const;
+
+    /** @brief Clamps a coordinate to the stored range. */
+    static int clamp(int value);
+
+private:
+    void resize(int count);     ///< Sets the number of points, keeping the columns padded.
+
+    int m_dimensions = 0;                   ///< Number of axes.
+    int m_size = 0;                         ///< Number of points.
+    std::vector<std::vector<qint8>> m_axes; ///< One column per axis.
+};
+
+#endif // IDEOLOGYPOINTS_H
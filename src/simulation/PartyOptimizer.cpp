@@ -0,0 +1,179 @@
+#include "PartyOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace {
+
+int clampCoordinate(int value) {
+    return std::clamp(value, VoterHistogram::kMinCoordinate, VoterHistogram::kMaxCoordinate);
+}
+
+}
+
+PartyOptimizer::PartyOptimizer(const VoterHistogram& histogram, const QVector<Party>& parties)
+    : m_parties(parties), m_electorate(histogram.total())
+{
+    // Only occupied cells can change a tally, so keep a compact list of them
+    const std::vector<int>& cells = histogram.cells();
+    for (int c = 0; c < VoterHistogram::kCellCount; ++c) {
+        if (cells[c] <= 0) continue;
+        m_cellX.push_back(static_cast<qint16>(VoterHistogram::cellX(c)));
+        m_cellY.push_back(static_cast<qint16>(VoterHistogram::cellY(c)));
+        m_cellCount.push_back(cells[c]);
+    }
+    m_cellLimit.resize(m_cellCount.size());
+}
+
+void PartyOptimizer::prepareRivals(int partyIndex) {
+    const int partyCount = m_parties.size();
+    for (size_t c = 0; c < m_cellCount.size(); ++c) {
+        int best = std::numeric_limits<int>::max();
+        int bestIndex = partyCount;
+        for (int p = 0; p < partyCount; ++p) {
+            if (p == partyIndex) continue;
+            const int dx = m_parties[p].ideologyX - m_cellX[c];
+            const int dy = m_parties[p].ideologyY - m_cellY[c];
+            const int d2 = dx * dx + dy * dy;
+            if (d2 < best) {
+                best = d2;
+                bestIndex = p;
+            }
+        }
+        // Equal distance goes to the earlier party, so an earlier candidate may also win ties
+        if (best == std::numeric_limits<int>::max())
+            m_cellLimit[c] = best;
+        else
+            m_cellLimit[c] = best + (partyIndex < bestIndex ? 1 : 0);
+    }
+    m_preparedIndex = partyIndex;
+}
+
+int PartyOptimizer::evaluate(int partyIndex, int x, int y) {
+    if (partyIndex < 0 || partyIndex >= m_parties.size()) return 0;
+    if (m_preparedIndex != partyIndex) prepareRivals(partyIndex);
+
+    int votes = 0;
+    const size_t cellCount = m_cellCount.size();
+    for (size_t c = 0; c < cellCount; ++c) {
+        const int dx = x - m_cellX[c];
+        const int dy = y - m_cellY[c];
+        if (dx * dx + dy * dy < m_cellLimit[c]) votes += m_cellCount[c];
+    }
+    return votes;
+}
+
+OptimizedPosition PartyOptimizer::optimize(int partyIndex, const OptimizerSettings& settings) {
+    OptimizedPosition result;
+    if (partyIndex < 0 || partyIndex >= m_parties.size()) return result;
+
+    Party& party = m_parties[partyIndex];
+    result.partyId = party.id;
+
+    int x = clampCoordinate(party.ideologyX);
+    int y = clampCoordinate(party.ideologyY);
+    int votes = evaluate(partyIndex, x, y);
+    int evaluations = 1;
+
+    int bestX = x, bestY = y, bestVotes = votes;
+
+    if (settings.strategy == OptimizerSettings::Strategy::SimulatedAnnealing) {
+        std::mt19937 rng(settings.seed);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        double temperature = settings.initialTemperature * m_electorate;
+
+        for (int i = 1; i < settings.iterations; ++i) {
+            // Move radius shrinks linearly so the search ends with fine adjustments
+            const int radius = std::max(1, static_cast<int>(settings.initialStep * (1.0 - double(i) / settings.iterations)));
+            std::uniform_int_distribution<int> offset(-radius, radius);
+            const int nx = clampCoordinate(x + offset(rng));
+            const int ny = clampCoordinate(y + offset(rng));
+            if (nx == x && ny == y) continue;
+
+            const int candidate = evaluate(partyIndex, nx, ny);
+            ++evaluations;
+            const int delta = candidate - votes;
+            if (delta >= 0 || (temperature > 0.0 && unit(rng) < std::exp(delta / temperature))) {
+                x = nx;
+                y = ny;
+                votes = candidate;
+            }
+            if (votes > bestVotes) {
+                bestX = x;
+                bestY = y;
+                bestVotes = votes;
+            }
+            temperature *= settings.cooling;
+        }
+        x = bestX;
+        y = bestY;
+        votes = bestVotes;
+    }
+
+    // Hill climbing; after annealing it polishes the best position with small steps
+    int step = settings.strategy == OptimizerSettings::Strategy::HillClimbing ? settings.initialStep : 2;
+    const int budget = settings.strategy == OptimizerSettings::Strategy::HillClimbing
+                           ? settings.iterations : evaluations + 8 * 8;
+    static const int directions[8][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+                                          { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 } };
+    while (step >= 1 && evaluations < budget) {
+        int moveX = x, moveY = y, moveVotes = votes;
+        for (const auto& d : directions) {
+            const int nx = clampCoordinate(x + d[0] * step);
+            const int ny = clampCoordinate(y + d[1] * step);
+            if (nx == x && ny == y) continue;
+            const int candidate = evaluate(partyIndex, nx, ny);
+            ++evaluations;
+            if (candidate > moveVotes) {
+                moveX = nx;
+                moveY = ny;
+                moveVotes = candidate;
+            }
+        }
+        if (moveVotes > votes) {
+            x = moveX;
+            y = moveY;
+            votes = moveVotes;
+        } else {
+            step /= 2;
+        }
+    }
+
+    party.ideologyX = x;
+    party.ideologyY = y;
+    m_preparedIndex = -1;   // other parties now face a moved rival
+
+    result.x = x;
+    result.y = y;
+    result.votes = votes;
+    result.share = m_electorate > 0 ? votes * 100.0 / m_electorate : 0.0;
+    result.evaluations = evaluations;
+    return result;
+}
+
+QVector<OptimizedPosition> PartyOptimizer::bestResponse(const OptimizerSettings& settings, int rounds) {
+    QVector<OptimizedPosition> positions(m_parties.size());
+    OptimizerSettings perParty = settings;
+    for (int r = 0; r < rounds; ++r) {
+        for (int p = 0; p < m_parties.size(); ++p) {
+            perParty.seed = settings.seed + static_cast<unsigned int>(r * m_parties.size() + p);
+            positions[p] = optimize(p, perParty);
+        }
+    }
+    // Later moves change earlier parties' shares, so report final standings
+    for (int p = 0; p < m_parties.size(); ++p) {
+        positions[p].votes = evaluate(p, m_parties[p].ideologyX, m_parties[p].ideologyY);
+        positions[p].share = m_electorate > 0 ? positions[p].votes * 100.0 / m_electorate : 0.0;
+    }
+    return positions;
+}
+
+const QVector<Party>& PartyOptimizer::parties() const {
+    return m_parties;
+}
+
+int PartyOptimizer::electorate() const {
+    return m_electorate;
+}
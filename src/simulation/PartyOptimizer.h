@@ -0,0 +1,100 @@
+#ifndef PARTYOPTIMIZER_H
+#define PARTYOPTIMIZER_H
+
+#include <QVector>
+
+#include <vector>
+
+#include "models/PartyModel.h"
+#include "VoterHistogram.h"
+
+/**
+ * @brief Tuning parameters for a party position search.
+ */
+struct OptimizerSettings {
+    /** @brief Search strategy. */
+    enum class Strategy {
+        HillClimbing,           ///< Greedy moves to the best neighbouring position, shrinking the step when stuck.
+        SimulatedAnnealing      ///< Random moves, occasionally accepting worse positions while the temperature is high.
+    };
+
+    Strategy strategy = Strategy::SimulatedAnnealing;   ///< Search strategy.
+    int iterations = 2000;                              ///< Maximum number of candidate evaluations.
+    int initialStep = 32;                               ///< Initial move radius on the compass.
+    double initialTemperature = 0.05;                   ///< Annealing start temperature, as a fraction of the electorate.
+    double cooling = 0.995;                             ///< Temperature multiplier applied after every candidate.
+    unsigned int seed = 1;                              ///< Random seed, so searches are reproducible.
+};
+
+/**
+ * @brief Outcome of optimising one party's position.
+ */
+struct OptimizedPosition {
+    int partyId = -1;           ///< ID of the optimised party (-1 for a party not yet saved).
+    int x = 0;                  ///< Best X coordinate found.
+    int y = 0;                  ///< Best Y coordinate found.
+    int votes = 0;              ///< Votes the party wins at the best position.
+    double share = 0.0;         ///< Vote share at the best position (percentage).
+    int evaluations = 0;        ///< Number of candidate positions scored.
+};
+
+/**
+ * @brief Searches party positions that maximise vote share against a voter density histogram.
+ *
+ * @details Every candidate is scored by visiting only the occupied cells of the histogram, with the distance to the nearest rival
+ * party precomputed per cell. A single evaluation therefore costs at most one distance computation per grid cell, independent of the
+ * number of voters. Voters choose the closest party; ties go to the party listed first, as in VoterModel::findClosestPartyId.
+ */
+class PartyOptimizer {
+public:
+    /**
+     * @brief Constructs an optimizer.
+     * @param histogram Voter density to optimise against.
+     * @param parties Current party positions; a party with ID -1 stands for one that is being created.
+     */
+    PartyOptimizer(const VoterHistogram& histogram, const QVector<Party>& parties);
+
+    /**
+     * @brief Scores a candidate position for one party, keeping every other party where it is.
+     * @param partyIndex Index of the party in parties().
+     * @param x Candidate X coordinate.
+     * @param y Candidate Y coordinate.
+     * @return Number of voters the party would win.
+     */
+    int evaluate(int partyIndex, int x, int y);
+
+    /**
+     * @brief Searches the best position for one party, others fixed.
+     * @param partyIndex Index of the party in parties().
+     * @param settings Search parameters.
+     * @return The best position found; parties() is updated to it.
+     */
+    OptimizedPosition optimize(int partyIndex, const OptimizerSettings& settings);
+
+    /**
+     * @brief Lets every party in turn move to its best response to the others.
+     * @param settings Search parameters for each individual search.
+     * @param rounds Number of passes over all parties.
+     * @return Final position of every party, in the order of parties().
+     */
+    QVector<OptimizedPosition> bestResponse(const OptimizerSettings& settings, int rounds = 3);
+
+    /** @brief Returns the parties with their current (possibly optimised) positions. */
+    const QVector<Party>& parties() const;
+
+    /** @brief Returns the number of voters in the histogram. */
+    int electorate() const;
+
+private:
+    void prepareRivals(int partyIndex);     ///< Precomputes the winning threshold of every occupied cell against the other parties.
+
+    QVector<Party> m_parties;               ///< Party positions being optimised.
+    int m_electorate = 0;                   ///< Total number of voters.
+    int m_preparedIndex = -1;               ///< Party index the thresholds were computed for.
+    std::vector<qint16> m_cellX;            ///< X coordinate of each occupied cell.
+    std::vector<qint16> m_cellY;            ///< Y coordinate of each occupied cell.
+    std::vector<int> m_cellCount;           ///< Voters in each occupied cell.
+    std::vector<int> m_cellLimit;           ///< Squared distance a candidate must stay below to win the cell.
+};
+
+#endif // PARTYOPTIMIZER_H
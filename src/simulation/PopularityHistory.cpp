@@ -0,0 +1,150 @@
+#include "PopularityHistory.h"
+
+#include <algorithm>
+
+PopularityHistory::PopularityHistory(int capacity)
+    : m_capacity(std::max(1, capacity))
+{
+}
+
+void PopularityHistory::record(const QMap<int, double>& shares) {
+    for (auto it = shares.cbegin(); it != shares.cend(); ++it)
+        if (!m_series.contains(it.key())) addSeries(it.key());
+
+    for (auto it = m_series.begin(); it != m_series.end(); ++it)
+        append(*it, static_cast<float>(shares.value(it.key(), 0.0)));
+    ++m_samples;
+}
+
+void PopularityHistory::record(const QVector<int>& partyIds, const QVector<double>& shares) {
+    Q_ASSERT(partyIds.size() == shares.size());
+    int recorded = 0;
+    for (int i = 0; i < partyIds.size(); ++i) {
+        auto it = m_series.find(partyIds[i]);
+        if (it == m_series.end() && shares[i] <= 0) continue;
+        Series& series = it != m_series.end() ? *it : addSeries(partyIds[i]);
+        append(series, static_cast<float>(shares[i]));
+        ++recorded;
+    }
+
+    // Series left over belong to deleted parties; only then is the list searched
+    if (m_series.size() > recorded) {
+        for (auto it = m_series.begin(); it != m_series.end();) {
+            if (partyIds.contains(it.key()))
+                ++it;
+            else
+                it = m_series.erase(it);
+        }
+    }
+    ++m_samples;
+}
+
+void PopularityHistory::retainParties(const QSet<int>& partyIds) {
+    for (auto it = m_series.begin(); it != m_series.end();) {
+        if (partyIds.contains(it.key()))
+            ++it;
+        else
+            it = m_series.erase(it);
+    }
+}
+
+void PopularityHistory::clear() {
+    m_series.clear();
+    m_samples = 0;
+}
+
+qint64 PopularityHistory::sampleCount() const {
+    return m_samples;
+}
+
+qint64 PopularityHistory::firstAvailableSample() const {
+    return firstHeldSample(kLevels - 1);
+}
+
+int PopularityHistory::capacity() const {
+    return m_capacity;
+}
+
+QList<int> PopularityHistory::partyIds() const {
+    return m_series.keys();
+}
+
+QVector<ShareRange> PopularityHistory::columns(int partyId, qint64 first, qint64 last, int columnCount) const {
+    QVector<ShareRange> result;
+    auto found = m_series.constFind(partyId);
+    if (found == m_series.cend() || columnCount <= 0) return result;
+    const Series& series = *found;
+
+    first = std::max({ first, series.firstSample, firstAvailableSample() });
+    last = std::min(last, m_samples - 1);
+    if (last < first) return result;
+
+    const qint64 span = last - first + 1;
+    const qint64 columns = std::min<qint64>(columnCount, span);
+
+    // Finest level with at most two buckets per column that still holds the first sample
+    int level = 0;
+    while (level < kLevels - 1 && ((span / columns) >> (level + 1)) > 0) ++level;
+    while (level < kLevels - 1 && first < firstHeldSample(level)) ++level;
+
+    result.reserve(columns);
+    for (qint64 c = 0; c < columns; ++c) {
+        const qint64 s0 = first + span * c / columns;
+        const qint64 s1 = first + span * (c + 1) / columns - 1;
+
+        ShareRange range;
+        range.sample = s0;
+        bool any = false;
+        for (qint64 b = s0 >> level; b <= (s1 >> level); ++b) {
+            Bucket bucket;
+            if (!this->bucket(series, level, b, bucket)) continue;
+            range.min = any ? std::min(range.min, bucket.min) : bucket.min;
+            range.max = any ? std::max(range.max, bucket.max) : bucket.max;
+            any = true;
+        }
+        if (any) result.append(range);
+    }
+    return result;
+}
+
+PopularityHistory::Series& PopularityHistory::addSeries(int partyId) {
+    Series& series = m_series[partyId];
+    series.firstSample = m_samples;
+    for (QVector<Bucket>& level : series.levels)
+        level.resize(m_capacity);
+    return series;
+}
+
+void PopularityHistory::append(Series& series, float share) {
+    const qint64 n = m_samples;
+    for (int level = 0; level < kLevels; ++level) {
+        const qint64 blockSize = qint64(1) << level;
+        Bucket& pending = series.pending[level];
+        if (n % blockSize == 0 || n == series.firstSample) {
+            pending.min = pending.max = share;
+        } else {
+            pending.min = std::min(pending.min, share);
+            pending.max = std::max(pending.max, share);
+        }
+        if ((n + 1) % blockSize == 0)
+            series.levels[level][(n >> level) % m_capacity] = pending;
+    }
+}
+
+bool PopularityHistory::bucket(const Series& series, int level, qint64 index, Bucket& out) const {
+    if (index < (series.firstSample >> level)) return false;
+
+    const qint64 completed = m_samples >> level;
+    if (index == completed && (m_samples & ((qint64(1) << level) - 1)) != 0) {
+        out = series.pending[level];
+        return true;
+    }
+    if (index >= completed || index < completed - m_capacity) return false;
+    out = series.levels[level][index % m_capacity];
+    return true;
+}
+
+qint64 PopularityHistory::firstHeldSample(int level) const {
+    const qint64 completed = m_samples >> level;
+    return std::max<qint64>(0, completed - m_capacity) << level;
+}
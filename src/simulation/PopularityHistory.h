@@ -0,0 +1,107 @@
+#ifndef POPULARITYHISTORY_H
+#define POPULARITYHISTORY_H
+
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QSet>
+#include <QVector>
+
+/**
+ * @brief Min/max range of one party's share over the samples drawn in one pixel column.
+ */
+struct ShareRange {
+    qint64 sample = 0;          ///< First sample covered by the column.
+    float min = 0.0f;           ///< Lowest share (percent) in the column.
+    float max = 0.0f;           ///< Highest share (percent) in the column.
+};
+
+/**
+ * @brief Fixed-memory history of every party's vote share, one sample per tally.
+ *
+ * @details Each party keeps kLevels ring buffers of capacity() buckets. Level L holds the min/max share of consecutive blocks
+ * of 2^L samples, so level 0 keeps the latest samples verbatim and the coarsest level still spans capacity() * 2^(kLevels - 1)
+ * samples. Recording a sample touches one bucket per level.
+ *
+ * columns() reads from the finest level that both covers the requested range and has at most about two buckets per column,
+ * so drawing a history of any length costs O(columns).
+ */
+class PopularityHistory {
+public:
+    static constexpr int kLevels = 16;          ///< Number of decimation levels (blocks of 1, 2, 4, ... 32768 samples).
+
+    /**
+     * @brief Constructs an empty history.
+     * @param capacity Buckets kept per level and party.
+     */
+    explicit PopularityHistory(int capacity = 1024);
+
+    /**
+     * @brief Appends one sample.
+     * @param shares Popularity percentage per party ID; known parties missing from the map are recorded as 0.
+     */
+    void record(const QMap<int, double>& shares);
+
+    /**
+     * @brief Appends one sample for exactly the given parties, without building a map.
+     * @param partyIds IDs of every existing party; the history of any other party is dropped.
+     * @param shares Popularity percentage of each party, aligned with @p partyIds.
+     *
+     * As with the map version, a party's series starts at its first non-zero share.
+     */
+    void record(const QVector<int>& partyIds, const QVector<double>& shares);
+
+    /**
+     * @brief Drops the history of every party not in @p partyIds, e.g. parties that were deleted.
+     * @param partyIds IDs of the parties that still exist.
+     */
+    void retainParties(const QSet<int>& partyIds);
+
+    /** @brief Forgets every sample and party. */
+    void clear();
+
+    /** @brief Returns the number of samples recorded so far (the next sample's index). */
+    qint64 sampleCount() const;
+
+    /** @brief Returns the oldest sample index the coarsest level still covers. */
+    qint64 firstAvailableSample() const;
+
+    /** @brief Returns the number of buckets kept per level and party. */
+    int capacity() const;
+
+    /** @brief Returns the IDs of every party that has been recorded. */
+    QList<int> partyIds() const;
+
+    /**
+     * @brief Decimates a party's share over a sample range into pixel columns.
+     * @param partyId Party to read.
+     * @param first First sample of the range (clamped to the available history).
+     * @param last Last sample of the range (clamped to the recorded samples).
+     * @param columnCount Number of columns, usually the plot width in pixels.
+     * @return One min/max range per non-empty column, in sample order.
+     */
+    QVector<ShareRange> columns(int partyId, qint64 first, qint64 last, int columnCount) const;
+
+private:
+    struct Bucket {
+        float min = 0.0f;
+        float max = 0.0f;
+    };
+
+    struct Series {
+        qint64 firstSample = 0;                 ///< Index of the first sample recorded for the party.
+        QVector<Bucket> levels[kLevels];        ///< Completed buckets per level, slot = bucket index % capacity.
+        Bucket pending[kLevels];                ///< Bucket still being filled at each level.
+    };
+
+    Series& addSeries(int partyId);                                             ///< Starts a party's series at sample m_samples.
+    void append(Series& series, float share);                                   ///< Adds sample m_samples to a series.
+    bool bucket(const Series& series, int level, qint64 index, Bucket& out) const; ///< Reads one bucket if still held.
+    qint64 firstHeldSample(int level) const;                                    ///< Oldest sample covered by a level.
+
+    QHash<int, Series> m_series;                ///< History per party ID.
+    qint64 m_samples = 0;                       ///< Number of samples recorded.
+    int m_capacity;                             ///< Buckets kept per level.
+};
+
+#endif // POPULARITYHISTORY_H
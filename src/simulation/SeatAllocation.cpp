@@ -0,0 +1,135 @@
+#include "SeatAllocation.h"
+#include "DistrictTally.h"
+#include "TickArena.h"
+
+#include <algorithm>
+
+namespace {
+
+struct Quotient {
+    double value;
+    int party;
+
+    // Max-heap order: larger quotient first, then lower party index
+    bool operator<(const Quotient& other) const {
+        if (value != other.value) return value < other.value;
+        return party > other.party;
+    }
+};
+
+// Ranking buffers of one allocation; taken from the arena and reused from district to district
+struct Ranking {
+    explicit Ranking(std::pmr::memory_resource* arena) : heap(arena) {}
+
+    void push(Quotient q) {
+        heap.push_back(q);
+        std::push_heap(heap.begin(), heap.end());
+    }
+    Quotient pop() {
+        std::pop_heap(heap.begin(), heap.end());
+        const Quotient top = heap.back();
+        heap.pop_back();
+        return top;
+    }
+
+    TickArena::Vector<Quotient> heap;   ///< Max-heap of quotients.
+};
+
+void highestAverages(const int* votes, int parties, int seats, int divisorStep, int* won, Ranking& ranking) {
+    ranking.heap.clear();
+    for (int p = 0; p < parties; ++p)
+        if (votes[p] > 0) ranking.push({ static_cast<double>(votes[p]), p });
+
+    // Divisor after n seats: 1 + n * divisorStep (D'Hondt: 1, 2, 3..., Sainte-Laguë: 1, 3, 5...)
+    for (int s = 0; s < seats && !ranking.heap.empty(); ++s) {
+        const int p = ranking.pop().party;
+        ++won[p];
+        ranking.push({ votes[p] / (1.0 + won[p] * divisorStep), p });
+    }
+}
+
+void largestRemainder(const int* votes, int parties, int seats, int* won, Ranking& ranking) {
+    qint64 total = 0;
+    for (int p = 0; p < parties; ++p) total += votes[p];
+    if (total == 0) return;
+
+    ranking.heap.clear();
+    int assigned = 0;
+    for (int p = 0; p < parties; ++p) {
+        const qint64 scaled = static_cast<qint64>(votes[p]) * seats;    // votes / (total / seats), kept exact
+        won[p] = static_cast<int>(scaled / total);
+        assigned += won[p];
+        ranking.heap.push_back({ static_cast<double>(scaled % total), p });
+    }
+
+    std::make_heap(ranking.heap.begin(), ranking.heap.end());
+    for (; assigned < seats && !ranking.heap.empty(); ++assigned)
+        ++won[ranking.pop().party];
+}
+
+// Adds the seats of one district to @p won, which must hold @p parties zeros
+void allocateInto(const int* votes, int parties, int seats, SeatMethod method, int* won, Ranking& ranking) {
+    if (seats <= 0 || parties == 0) return;
+
+    switch (method) {
+    case SeatMethod::FirstPastThePost: {
+        int winner = 0;
+        for (int p = 1; p < parties; ++p)
+            if (votes[p] > votes[winner]) winner = p;
+        if (votes[winner] > 0) won[winner] = seats;
+        return;
+    }
+    case SeatMethod::DHondt:
+        highestAverages(votes, parties, seats, 1, won, ranking);
+        return;
+    case SeatMethod::SainteLague:
+        highestAverages(votes, parties, seats, 2, won, ranking);
+        return;
+    case SeatMethod::LargestRemainder:
+        largestRemainder(votes, parties, seats, won, ranking);
+        return;
+    }
+}
+
+}
+
+QVector<int> SeatAllocator::allocate(const QVector<int>& votes, int seats, SeatMethod method) {
+    TickArena::Scope arenaScope;
+    Ranking ranking(TickArena::resource());
+    QVector<int> won(votes.size(), 0);
+    allocateInto(votes.constData(), votes.size(), seats, method, won.data(), ranking);
+    return won;
+}
+
+QMap<int, int> SeatAllocator::parliament(const DistrictTally& tally, int seatsPerDistrict, SeatMethod method) {
+    const QVector<int>& partyIds = tally.partyIds();
+    const int parties = partyIds.size();
+
+    TickArena::Scope arenaScope;
+    std::pmr::memory_resource* arena = TickArena::resource();
+    Ranking ranking(arena);
+    TickArena::Vector<int> seats(static_cast<size_t>(parties), 0, arena);
+    TickArena::Vector<int> won(static_cast<size_t>(parties), 0, arena);
+
+    for (int d = 0; d < tally.districtCount(); ++d) {
+        std::fill(won.begin(), won.end(), 0);
+        allocateInto(tally.districtRow(d), parties, seatsPerDistrict, method, won.data(), ranking);
+        for (int p = 0; p < parties; ++p)
+            seats[p] += won[p];
+    }
+
+    QMap<int, int> result;
+    for (int p = 0; p < parties; ++p)
+        result.insert(partyIds[p], seats[p]);
+    return result;
+}
+
+QString SeatAllocator::methodName(SeatMethod method) {
+    switch (method) {
+    case SeatMethod::FirstPastThePost: return "First past the post";
+    case SeatMethod::DHondt:           return "D'Hondt";
+    case SeatMethod::SainteLague:      return "Sainte-Laguë";
+    case SeatMethod::LargestRemainder: return "Largest remainder";
+    }
+    return QString();
+}
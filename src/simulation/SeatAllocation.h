@@ -0,0 +1,49 @@
+#ifndef SEATALLOCATION_H
+#define SEATALLOCATION_H
+
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+class DistrictTally;
+
+/**
+ * @brief Methods for turning district votes into parliamentary seats.
+ */
+enum class SeatMethod {
+    FirstPastThePost,   ///< The district's plurality winner takes every seat.
+    DHondt,             ///< Highest averages with divisors 1, 2, 3, ...
+    SainteLague,        ///< Highest averages with divisors 1, 3, 5, ...
+    LargestRemainder    ///< Hare quota, leftover seats go to the largest remainders.
+};
+
+/**
+ * @brief Allocates seats from vote counts using the supported apportionment methods.
+ *
+ * @details Ties are resolved in favour of the party that appears first in the vote list, so allocations are deterministic.
+ */
+class SeatAllocator {
+public:
+    /**
+     * @brief Allocates the seats of a single district.
+     * @param votes Votes per party (in party index order).
+     * @param seats Number of seats to fill.
+     * @param method Apportionment method.
+     * @return Seats won per party, in the same order as @p votes.
+     */
+    static QVector<int> allocate(const QVector<int>& votes, int seats, SeatMethod method);
+
+    /**
+     * @brief Allocates the seats of every district and sums them into a parliament.
+     * @param tally Per-district vote counts.
+     * @param seatsPerDistrict Number of seats each district elects.
+     * @param method Apportionment method applied within each district.
+     * @return Total seats per party ID (parties without seats are included with 0).
+     */
+    static QMap<int, int> parliament(const DistrictTally& tally, int seatsPerDistrict, SeatMethod method);
+
+    /** @brief Returns a human-readable name for an apportionment method. */
+    static QString methodName(SeatMethod method);
+};
+
+#endif // SEATALLOCATION_H
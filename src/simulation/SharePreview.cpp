@@ -0,0 +1,69 @@
+#include "SharePreview.h"
+
+#include <limits>
+
+SharePreview::SharePreview(const VoterHistogram& histogram, const QVector<Party>& parties, int partyIndex)
+    : m_partyIndex(partyIndex >= 0 && partyIndex < parties.size() ? partyIndex : parties.size()),
+      m_partyCount(m_partyIndex == parties.size() ? parties.size() + 1 : parties.size())
+{
+    m_current.votes.fill(0, m_partyCount);
+    m_current.electorate = histogram.total();
+
+    const std::vector<int>& cells = histogram.cells();
+    for (int c = 0; c < VoterHistogram::kCellCount; ++c) {
+        if (cells[c] <= 0) continue;
+        const int x = VoterHistogram::cellX(c);
+        const int y = VoterHistogram::cellY(c);
+
+        // Nearest party overall and nearest party other than the moving one; strict '<' keeps the earlier party on ties
+        int owner = -1, ownerD2 = std::numeric_limits<int>::max();
+        int rival = -1, rivalD2 = std::numeric_limits<int>::max();
+        for (int p = 0; p < parties.size(); ++p) {
+            const int dx = parties[p].ideologyX - x;
+            const int dy = parties[p].ideologyY - y;
+            const int d2 = dx * dx + dy * dy;
+            if (d2 < ownerD2) {
+                owner = p;
+                ownerD2 = d2;
+            }
+            if (p != m_partyIndex && d2 < rivalD2) {
+                rival = p;
+                rivalD2 = d2;
+            }
+        }
+
+        m_cellX.push_back(static_cast<qint16>(x));
+        m_cellY.push_back(static_cast<qint16>(y));
+        m_cellCount.push_back(cells[c]);
+        m_cellOwner.push_back(owner);
+        m_cellRival.push_back(rival);
+        // An earlier moving party also wins ties
+        m_cellLimit.push_back(rival == -1 ? std::numeric_limits<int>::max()
+                                          : rivalD2 + (m_partyIndex < rival ? 1 : 0));
+        if (owner != -1) m_current.votes[owner] += cells[c];
+    }
+}
+
+ShareProjection SharePreview::project(int x, int y) const {
+    ShareProjection result;
+    result.votes.fill(0, m_partyCount);
+    result.electorate = m_current.electorate;
+
+    const size_t cellCount = m_cellCount.size();
+    for (size_t c = 0; c < cellCount; ++c) {
+        const int dx = x - m_cellX[c];
+        const int dy = y - m_cellY[c];
+        const int winner = (dx * dx + dy * dy < m_cellLimit[c]) ? m_partyIndex : m_cellRival[c];
+        if (winner != -1) result.votes[winner] += m_cellCount[c];
+        if (winner != m_cellOwner[c]) result.switched += m_cellCount[c];
+    }
+    return result;
+}
+
+const ShareProjection& SharePreview::current() const {
+    return m_current;
+}
+
+int SharePreview::partyIndex() const {
+    return m_partyIndex;
+}
@@ -0,0 +1,68 @@
+#ifndef SHAREPREVIEW_H
+#define SHAREPREVIEW_H
+
+#include <QVector>
+
+#include <vector>
+
+#include "models/PartyModel.h"
+#include "VoterHistogram.h"
+
+/**
+ * @brief Projected election outcome for one candidate position of a party.
+ */
+struct ShareProjection {
+    QVector<int> votes;         ///< Votes per party, in the order of the parties given to SharePreview (a new party last).
+    int switched = 0;           ///< Voters whose nearest party differs from the current one.
+    int electorate = 0;         ///< Total number of voters.
+
+    /** @brief Returns the vote share of a party as a percentage (0 if there are no voters). */
+    double share(int partyIndex) const {
+        return electorate > 0 ? votes.value(partyIndex) * 100.0 / electorate : 0.0;
+    }
+};
+
+/**
+ * @brief Previews vote shares while one party is being moved, without touching the voter data.
+ *
+ * @details The constructor walks the occupied cells of a VoterHistogram once and stores, per cell, the party that wins it today, the
+ * best rival of the moving party and the squared distance the moving party must beat. project() then decides every cell with one
+ * distance comparison, so a preview costs O(occupied cells) (at most 40 401) regardless of the number of voters or parties.
+ * Voters choose the closest party; ties go to the party listed first, as in VoterModel::findClosestPartyId.
+ */
+class SharePreview {
+public:
+    /**
+     * @brief Prepares previews for one party.
+     * @param histogram Voter density to project against.
+     * @param parties Current party positions, in the order VoterModel assigns voters.
+     * @param partyIndex Index of the party being moved, or -1 for a new party that will be appended after @p parties.
+     */
+    SharePreview(const VoterHistogram& histogram, const QVector<Party>& parties, int partyIndex);
+
+    /**
+     * @brief Projects the outcome with the party at a new position and every other party where it is.
+     * @param x Candidate X coordinate.
+     * @param y Candidate Y coordinate.
+     */
+    ShareProjection project(int x, int y) const;
+
+    /** @brief Returns the projection for the parties as they are now (the moving party at its current position). */
+    const ShareProjection& current() const;
+
+    /** @brief Returns the index of the moving party in ShareProjection::votes. */
+    int partyIndex() const;
+
+private:
+    int m_partyIndex;                       ///< Index of the moving party in the projection.
+    int m_partyCount;                       ///< Number of parties in the projection (including a new party).
+    ShareProjection m_current;              ///< Outcome with the current positions.
+    std::vector<qint16> m_cellX;            ///< X coordinate of each occupied cell.
+    std::vector<qint16> m_cellY;            ///< Y coordinate of each occupied cell.
+    std::vector<int> m_cellCount;           ///< Voters in each occupied cell.
+    std::vector<int> m_cellOwner;           ///< Party winning each cell today (-1 if there are no parties).
+    std::vector<int> m_cellRival;           ///< Best other party for each cell (-1 if the moving party is alone).
+    std::vector<int> m_cellLimit;           ///< Squared distance the moving party must stay below to win the cell.
+};
+
+#endif // SHAREPREVIEW_H
@@ -0,0 +1,146 @@
+#include "SimulationEngine.h"
+
+#include "EventLog.h"
+#include "TaskScheduler.h"
+#include "TickArena.h"
+#include "VoterHistogram.h"
+#include "models/PartyModel.h"
+#include "models/VoterModel.h"
+
+#include <QVector>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+
+namespace {
+
+constexpr int kDriftChunk = 8192;       // voters per generator; part of the result, so changing it changes seeded runs
+
+int sign(int value) {
+    return (value > 0) - (value < 0);
+}
+
+int clampCoordinate(int value) {
+    return std::clamp(value, VoterHistogram::kMinCoordinate, VoterHistogram::kMaxCoordinate);
+}
+
+std::uint64_t mix64(std::uint64_t z) {
+    z += 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+// Seed of a chunk's generator, mixed from the run seed, the tick and the chunk index (splitmix64 finaliser)
+std::uint32_t chunkSeed(unsigned int seed, int tick, int chunk) {
+    const std::uint64_t z = mix64(mix64((std::uint64_t(seed) << 32) | std::uint32_t(tick)) ^ std::uint32_t(chunk));
+    return static_cast<std::uint32_t>(z ^ (z >> 32));
+}
+
+}
+
+SimulationEngine::SimulationEngine(VoterModel* voterModel, PartyModel* partyModel, EventLog* log, QObject* parent)
+    : QObject(parent), voterModel(voterModel), partyModel(partyModel), eventLog(log)
+{
+    if (eventLog) m_tick = eventLog->currentTick();
+}
+
+void SimulationEngine::setSettings(const DriftSettings& settings) {
+    m_settings = settings;
+}
+
+const DriftSettings& SimulationEngine::settings() const {
+    return m_settings;
+}
+
+int SimulationEngine::currentTick() const {
+    return m_tick;
+}
+
+void SimulationEngine::step(int ticks) {
+    for (int i = 0; i < ticks; ++i)
+        runTick();
+}
+
+void SimulationEngine::runTick() {
+    if (!voterModel || !partyModel) return;
+
+    ++m_tick;
+    if (eventLog) eventLog->beginTick(m_tick);
+
+    {
+        // Scratch of the tick comes from the arena; the scope closes before the moves reach the models
+        TickArena::Scope arenaScope;
+        std::pmr::memory_resource* arena = TickArena::resource();
+
+        const QVector<Party>& parties = partyModel->getAllParties();
+        TickArena::HashMap<int, const Party*> partyById(arena);
+        partyById.reserve(parties.size());
+        for (const Party& p : parties)
+            partyById.emplace(p.id, &p);
+
+        static const int offsets[4][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+
+        const QVector<Voter>& voters = voterModel->getAllVoters();
+        const int voterCount = voters.size();
+        const int chunks = (voterCount + kDriftChunk - 1) / kDriftChunk;
+        const DriftSettings settings = m_settings;
+        const int tick = m_tick;
+
+        // Every chunk writes its moves to its own slice of one buffer, so no chunk allocates
+        TickArena::Vector<VoterMove> candidates(static_cast<size_t>(voterCount), arena);
+        TickArena::Vector<int> movedPerChunk(static_cast<size_t>(chunks), 0, arena);
+        TaskScheduler::instance().parallelFor(0, chunks, 1, [&](int firstChunk, int lastChunk) {
+            for (int c = firstChunk; c < lastChunk; ++c) {
+                const int begin = c * kDriftChunk;
+                const int end = std::min(voterCount, begin + kDriftChunk);
+                std::mt19937 rng(chunkSeed(settings.seed, tick, c));
+                std::uniform_real_distribution<double> unit(0.0, 1.0);
+                std::uniform_int_distribution<int> direction(0, 3);
+
+                VoterMove* out = candidates.data() + begin;
+                int moved = 0;
+                for (int i = begin; i < end; ++i) {
+                    const Voter& v = voters[i];
+                    int x = v.ideologyX;
+                    int y = v.ideologyY;
+
+                    const auto party = partyById.find(v.partyId);
+                    if (party != partyById.end() && unit(rng) < settings.attraction) {
+                        x += sign(party->second->ideologyX - x);
+                        y += sign(party->second->ideologyY - y);
+                    }
+                    if (unit(rng) < settings.noise) {
+                        const int d = direction(rng);
+                        x = clampCoordinate(x + offsets[d][0]);
+                        y = clampCoordinate(y + offsets[d][1]);
+                    }
+
+                    if (x != v.ideologyX || y != v.ideologyY)
+                        out[moved++] = VoterMove{ v.id, x, y };
+                }
+                movedPerChunk[c] = moved;
+            }
+        });
+
+        // Concatenate in chunk order into the retained list, which keeps its capacity between ticks
+        int total = 0;
+        for (int moved : movedPerChunk)
+            total += moved;
+        m_moves.clear();
+        m_moves.reserve(total);
+        for (int c = 0; c < chunks; ++c) {
+            const VoterMove* first = candidates.data() + static_cast<size_t>(c) * kDriftChunk;
+            for (int i = 0; i < movedPerChunk[c]; ++i)
+                m_moves.append(first[i]);
+        }
+    }
+
+    voterModel->moveVoters(m_moves);
+
+    if (eventLog && eventLog->checkpointDue())
+        eventLog->recordCheckpoint(partyModel->getAllParties(), voterModel->getAllVoters());
+
+    emit tickCompleted(m_tick);
+}
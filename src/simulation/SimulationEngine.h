@@ -0,0 +1,76 @@
+#ifndef SIMULATIONENGINE_H
+#define SIMULATIONENGINE_H
+
+#include <QObject>
+#include <QVector>
+
+#include "models/VoterModel.h"
+
+class PartyModel;
+class EventLog;
+
+/**
+ * @brief Tuning parameters for the opinion drift applied every tick.
+ */
+struct DriftSettings {
+    double attraction = 0.3;    ///< Probability that a voter steps one unit towards their party per tick.
+    double noise = 0.2;         ///< Probability that a voter steps one unit in a random direction per tick.
+    unsigned int seed = 1;      ///< Random seed, so runs are reproducible.
+};
+
+/**
+ * @brief Advances the scenario in discrete ticks of voter opinion drift.
+ *
+ * @details Each tick moves voters a unit at a time towards their current party (and randomly, to keep the population spread),
+ * applies all moves through VoterModel::moveVoters and, when an EventLog is attached, stamps the tick in the log and writes a
+ * checkpoint whenever one is due.
+ *
+ * The moves are computed in fixed chunks of voters on the TaskScheduler. Each chunk draws from its own generator seeded with
+ * the seed, the tick and the chunk index, so a run is reproducible whatever the number of threads. Scratch data of the drift
+ * pass (the party lookup and the per-chunk move buffers) comes from the TickArena, whose scope closes before the moves are
+ * applied, and the final move list is kept between ticks, so computing the moves of a tick of steady size does not allocate.
+ * Applying them does: VoterModel::moveVoters writes to SQLite, and the change signals it emits update the popularity charts.
+ */
+class SimulationEngine : public QObject {
+    Q_OBJECT
+
+signals:
+    /** @brief Emitted after a tick has been applied to the models. */
+    void tickCompleted(int tick);
+
+public:
+    /**
+     * @brief Constructor for SimulationEngine.
+     * @param voterModel Voters to move.
+     * @param partyModel Parties voters drift towards.
+     * @param log Optional event log; ticks continue from its last recorded tick.
+     * @param parent Optional parent object.
+     */
+    SimulationEngine(VoterModel* voterModel, PartyModel* partyModel, EventLog* log = nullptr, QObject* parent = nullptr);
+
+    /** @brief Replaces the drift parameters, including the seed of later ticks. */
+    void setSettings(const DriftSettings& settings);
+    /** @brief Returns the current drift parameters. */
+    const DriftSettings& settings() const;
+
+    /** @brief Returns the number of the last completed tick. */
+    int currentTick() const;
+
+    /**
+     * @brief Runs one or more ticks.
+     * @param ticks Number of ticks to run.
+     */
+    void step(int ticks = 1);
+
+private:
+    void runTick();                     ///< Computes and applies one tick of drift.
+
+    VoterModel* voterModel;             ///< Voters being simulated.
+    PartyModel* partyModel;             ///< Parties voters are attracted to.
+    EventLog* eventLog;                 ///< Event log receiving ticks and checkpoints (optional).
+    DriftSettings m_settings;           ///< Drift parameters.
+    int m_tick = 0;                     ///< Last completed tick.
+    QVector<VoterMove> m_moves;         ///< Moves of the last tick; cleared, not freed, so its capacity is reused.
+};
+
+#endif // SIMULATIONENGINE_H
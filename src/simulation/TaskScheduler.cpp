@@ -0,0 +1,205 @@
+#include "TaskScheduler.h"
+
+#include "diagnostics/MetricsRegistry.h"
+
+#include <chrono>
+
+namespace {
+
+thread_local const TaskScheduler* t_scheduler = nullptr;    // Scheduler owning the calling worker thread
+thread_local int t_workerIndex = -1;                        // Index of the calling worker thread in t_scheduler
+
+qint64 nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+TaskScheduler& TaskScheduler::instance() {
+    static TaskScheduler scheduler;
+    return scheduler;
+}
+
+int TaskScheduler::defaultWorkerCount() {
+    const int configured = qEnvironmentVariableIntValue("POLITICALSIM_WORKERS");
+    if (configured > 0) return configured;
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+}
+
+TaskScheduler::TaskScheduler(int workerCount)
+    : m_startNs(nowNs())
+{
+    const int count = std::max(1, workerCount);
+    m_workers.reserve(count);
+    for (int i = 0; i < count; ++i)
+        m_workers.push_back(std::make_unique<Worker>());
+    for (int i = 0; i < count; ++i)
+        m_workers[i]->thread = std::thread([this, i]() { workerLoop(i); });
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers)
+        worker->thread.join();
+}
+
+int TaskScheduler::workerCount() const {
+    return static_cast<int>(m_workers.size());
+}
+
+TaskScheduler::Stats TaskScheduler::stats() const {
+    Stats s;
+    s.workers = workerCount();
+    s.tasksExecuted = m_externalExecuted.load(std::memory_order_relaxed);
+    qint64 busyNs = m_externalBusyNs.load(std::memory_order_relaxed);
+    for (const auto& worker : m_workers) {
+        s.tasksExecuted += worker->executed.load(std::memory_order_relaxed);
+        s.steals += worker->steals.load(std::memory_order_relaxed);
+        busyNs += worker->busyNs.load(std::memory_order_relaxed);
+    }
+    s.busyUs = busyNs / 1000;
+    s.uptimeUs = (nowNs() - m_startNs) / 1000;
+    return s;
+}
+
+void TaskScheduler::push(Job job) {
+    const int self = currentWorker();
+    if (self >= 0) {
+        Worker& worker = *m_workers[self];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.deque.push_back(std::move(job));
+    } else {
+        std::lock_guard<std::mutex> lock(m_injectMutex);
+        m_injected.push_back(std::move(job));
+    }
+    m_queued.fetch_add(1, std::memory_order_release);
+
+    // Taking the lock orders the increment before a worker's predicate check, so the wakeup cannot be lost
+    { std::lock_guard<std::mutex> lock(m_sleepMutex); }
+    m_wake.notify_one();
+}
+
+bool TaskScheduler::takeJob(int self, Job& job, bool& stolen) {
+    stolen = false;
+    if (m_queued.load(std::memory_order_acquire) <= 0) return false;
+
+    if (self >= 0) {
+        Worker& own = *m_workers[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.deque.empty()) {
+            job = std::move(own.deque.back());
+            own.deque.pop_back();
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_injectMutex);
+        if (!m_injected.empty()) {
+            job = std::move(m_injected.front());
+            m_injected.pop_front();
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // Steal the oldest job of another worker, starting after our own index to spread the thieves
+    const int count = workerCount();
+    for (int offset = 1; offset <= count; ++offset) {
+        const int victim = (std::max(self, 0) + offset) % count;
+        if (victim == self) continue;
+        Worker& other = *m_workers[victim];
+        std::lock_guard<std::mutex> lock(other.mutex);
+        if (!other.deque.empty()) {
+            job = std::move(other.deque.front());
+            other.deque.pop_front();
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            stolen = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TaskScheduler::runOne() {
+    const int self = currentWorker();
+    Job job;
+    bool stolen = false;
+    if (!takeJob(self, job, stolen)) return false;
+
+    const qint64 start = nowNs();
+    job.run();
+    const qint64 elapsed = nowNs() - start;
+
+    if (self >= 0) {
+        Worker& worker = *m_workers[self];
+        worker.executed.fetch_add(1, std::memory_order_relaxed);
+        worker.busyNs.fetch_add(elapsed, std::memory_order_relaxed);
+        if (stolen) worker.steals.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        m_externalExecuted.fetch_add(1, std::memory_order_relaxed);
+        m_externalBusyNs.fetch_add(elapsed, std::memory_order_relaxed);
+    }
+
+    TaskGroup* group = job.group;
+    group->m_executed.fetch_add(1, std::memory_order_relaxed);
+    group->m_busyNs.fetch_add(elapsed, std::memory_order_relaxed);
+    if (stolen) group->m_steals.fetch_add(1, std::memory_order_relaxed);
+    // Last access to the group: once pending reaches zero its owner may return from wait() and destroy it
+    group->m_pending.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+void TaskScheduler::workerLoop(int index) {
+    t_scheduler = this;
+    t_workerIndex = index;
+
+    for (;;) {
+        if (runOne()) continue;
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [this]() { return m_stopping || m_queued.load(std::memory_order_acquire) > 0; });
+        if (m_stopping) return;
+    }
+}
+
+int TaskScheduler::currentWorker() const {
+    return t_scheduler == this ? t_workerIndex : -1;
+}
+
+TaskScheduler::TaskGroup::TaskGroup(TaskScheduler& scheduler, CancellationToken token)
+    : m_scheduler(scheduler), m_token(std::move(token))
+{
+}
+
+TaskScheduler::TaskGroup::~TaskGroup() {
+    wait();
+}
+
+void TaskScheduler::TaskGroup::spawn(std::function<void()> task) {
+    if (m_pending.fetch_add(1, std::memory_order_relaxed) == 0 && m_startNs == 0) m_startNs = nowNs();
+    m_scheduler.push(Job{ std::move(task), this });
+}
+
+void TaskScheduler::TaskGroup::wait() {
+    while (m_pending.load(std::memory_order_acquire) > 0) {
+        if (!m_scheduler.runOne()) std::this_thread::yield();
+    }
+    if (m_startNs == 0) return;
+
+    const qint64 wallNs = std::max<qint64>(1, nowNs() - m_startNs);
+    const qint64 busyNs = m_busyNs.exchange(0, std::memory_order_relaxed);
+    const int threads = m_scheduler.workerCount() + 1;  // workers plus the waiting thread
+    MetricsRegistry& metrics = MetricsRegistry::instance();
+    metrics.increment("scheduler.groups");
+    metrics.increment("scheduler.tasks", m_executed.exchange(0, std::memory_order_relaxed));
+    metrics.increment("scheduler.steals", m_steals.exchange(0, std::memory_order_relaxed));
+    metrics.observe("scheduler.join_us", wallNs / 1000.0);
+    metrics.observe("scheduler.utilization_pct", std::min(100.0, 100.0 * busyNs / (double(wallNs) * threads)));
+    m_startNs = 0;
+}
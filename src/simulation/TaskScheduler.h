@@ -0,0 +1,236 @@
+#ifndef TASKSCHEDULER_H
+#define TASKSCHEDULER_H
+
+#include <QtGlobal>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Shared flag that asks running parallel work to stop early.
+ *
+ * @details Copies share the flag. Work checks it between ranges: parallelFor() skips ranges not yet started once it is set,
+ * and long range bodies may poll isCancelled() themselves.
+ */
+class CancellationToken {
+public:
+    /** @brief Creates a token that is not cancelled. */
+    CancellationToken() : m_flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+    /** @brief Requests cancellation; visible to every copy. */
+    void cancel() const { m_flag->store(true, std::memory_order_relaxed); }
+
+    /** @brief Returns true once cancel() was called on any copy. */
+    bool isCancelled() const { return m_flag->load(std::memory_order_relaxed); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> m_flag;  ///< Flag shared by all copies.
+};
+
+/**
+ * @brief Work-stealing thread pool for the simulation kernels (drift ticks, district tallies, bulk reassignment).
+ *
+ * @details Each worker owns a deque of tasks. A worker pushes the tasks it spawns to the back of its own deque and pops from
+ * the back, so nested work stays hot in its cache; an idle worker steals from the front of another worker's deque, taking
+ * the oldest and therefore largest pieces. Tasks spawned from other threads (e.g. the GUI) go to a shared injection queue.
+ * Each deque has its own lock, which only thieves contend for.
+ *
+ * A thread that waits for a TaskGroup runs queued tasks itself instead of blocking, so fork/join can nest to any depth and
+ * the calling thread adds to the pool rather than idling. parallelFor() splits a range in halves down to a grain size;
+ * parallelReduce() maps fixed chunks and combines them in order, so its result does not depend on scheduling.
+ *
+ * Every joined group reports to the MetricsRegistry: "scheduler.tasks", "scheduler.steals", the wall time in
+ * "scheduler.join_us" and the share of the available threads that ran its tasks in "scheduler.utilization_pct".
+ *
+ * @code
+ * const qint64 sum = TaskScheduler::instance().parallelReduce(0, voters.size(), 4096, qint64(0),
+ *     [&](int begin, int end) { qint64 s = 0; for (int i = begin; i < end; ++i) s += voters[i].ideologyX; return s; },
+ *     [](qint64 a, qint64 b) { return a + b; });
+ * @endcode
+ */
+class TaskScheduler {
+public:
+    /** @brief Totals since the scheduler started. */
+    struct Stats {
+        int workers = 0;                ///< Worker threads.
+        qint64 tasksExecuted = 0;       ///< Tasks run by workers and by waiting threads.
+        qint64 steals = 0;              ///< Tasks taken from another worker's deque.
+        qint64 busyUs = 0;              ///< Time spent running tasks, summed over threads.
+        qint64 uptimeUs = 0;            ///< Time since the scheduler started.
+
+        /** @brief Returns busyUs as a share of the workers' uptime (0..1). */
+        double utilization() const { return workers > 0 && uptimeUs > 0 ? double(busyUs) / (double(uptimeUs) * workers) : 0.0; }
+    };
+
+    class TaskGroup;
+
+    /** @brief Returns the process-wide scheduler, with defaultWorkerCount() workers. */
+    static TaskScheduler& instance();
+
+    /** @brief Returns POLITICALSIM_WORKERS if set, else one worker per hardware thread but one (at least one). */
+    static int defaultWorkerCount();
+
+    /** @brief Starts @p workerCount worker threads (at least one). */
+    explicit TaskScheduler(int workerCount = defaultWorkerCount());
+
+    /** @brief Stops and joins the workers; every TaskGroup must have been waited for. */
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    /** @brief Returns the number of worker threads. */
+    int workerCount() const;
+
+    /** @brief Returns the totals since the scheduler started. */
+    Stats stats() const;
+
+    /**
+     * @brief Runs @p body over [begin, end) in ranges of at most @p grain indices and waits for all of them.
+     * @param body Called as body(rangeBegin, rangeEnd), possibly on several threads at once.
+     * @param token Ranges not yet started are skipped once it is cancelled.
+     * @return False if the token was cancelled (some ranges may not have run).
+     */
+    template <typename Body>
+    bool parallelFor(int begin, int end, int grain, const Body& body, const CancellationToken& token = CancellationToken());
+
+    /**
+     * @brief Maps chunks of [begin, end) in parallel and combines the results in index order.
+     * @param grain Chunk size; chunk boundaries depend only on @p begin and @p grain.
+     * @param identity Starting value, also the value of chunks skipped after cancellation.
+     * @param map Called as map(chunkBegin, chunkEnd) and returns a T.
+     * @param combine Called as combine(T accumulated, T next) and returns a T; applied on the calling thread.
+     * @param token Chunks not yet started are skipped once it is cancelled.
+     */
+    template <typename T, typename Map, typename Combine>
+    T parallelReduce(int begin, int end, int grain, T identity, const Map& map, const Combine& combine,
+                     const CancellationToken& token = CancellationToken());
+
+private:
+    struct Job {
+        std::function<void()> run;      ///< Work to do.
+        TaskGroup* group = nullptr;     ///< Group notified when it is done.
+    };
+
+    struct Worker {
+        std::mutex mutex;               ///< Guards deque against thieves.
+        std::deque<Job> deque;          ///< Owner works at the back, thieves take from the front.
+        std::thread thread;             ///< The worker thread.
+        std::atomic<qint64> executed{ 0 };  ///< Tasks run by this worker.
+        std::atomic<qint64> steals{ 0 };    ///< Tasks it stole.
+        std::atomic<qint64> busyNs{ 0 };    ///< Time it spent running tasks.
+    };
+
+    void push(Job job);                 ///< Queues a job on the calling worker's deque, or on the injection queue.
+    bool runOne();                      ///< Runs one queued job on the calling thread; false if none was found.
+    bool takeJob(int self, Job& job, bool& stolen);     ///< Pops own work, then injected work, then steals.
+    void workerLoop(int index);         ///< Body of each worker thread.
+    int currentWorker() const;          ///< Index of the calling thread among this scheduler's workers, or -1.
+
+    template <typename Body>
+    void splitRange(TaskGroup& group, int begin, int end, int grain, const Body& body);  ///< Forks halves down to grain.
+
+    std::vector<std::unique_ptr<Worker>> m_workers;     ///< Worker threads and their deques.
+    std::mutex m_injectMutex;           ///< Guards m_injected.
+    std::deque<Job> m_injected;         ///< Jobs spawned from threads that are not workers.
+    std::mutex m_sleepMutex;            ///< Pairs with m_wake.
+    std::condition_variable m_wake;     ///< Wakes idle workers when jobs are queued.
+    std::atomic<int> m_queued{ 0 };     ///< Jobs queued and not yet taken.
+    bool m_stopping = false;            ///< Set under m_sleepMutex when the workers must exit.
+    std::atomic<qint64> m_externalExecuted{ 0 };    ///< Tasks run by waiting threads that are not workers.
+    std::atomic<qint64> m_externalBusyNs{ 0 };      ///< Time those threads spent running tasks.
+    qint64 m_startNs = 0;               ///< Start time, for the uptime.
+};
+
+/**
+ * @brief Set of tasks forked on a TaskScheduler and joined together.
+ *
+ * @details spawn() may be called from any thread, including from a task of the same group. wait() returns once every task
+ * spawned so far has finished, running queued tasks on the calling thread meanwhile; the destructor waits too.
+ */
+class TaskScheduler::TaskGroup {
+public:
+    /** @brief Creates an empty group on a scheduler, observing a cancellation token. */
+    explicit TaskGroup(TaskScheduler& scheduler = TaskScheduler::instance(), CancellationToken token = CancellationToken());
+
+    /** @brief Waits for the remaining tasks. */
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    /** @brief Queues a task. */
+    void spawn(std::function<void()> task);
+
+    /** @brief Runs queued tasks until every task of the group has finished, then reports to the MetricsRegistry. */
+    void wait();
+
+    /** @brief Returns true once the group's token is cancelled. */
+    bool isCancelled() const { return m_token.isCancelled(); }
+
+    /** @brief Returns the group's token. */
+    const CancellationToken& token() const { return m_token; }
+
+private:
+    friend class TaskScheduler;
+
+    TaskScheduler& m_scheduler;         ///< Scheduler running the tasks.
+    CancellationToken m_token;          ///< Cancellation observed by the group's work.
+    std::atomic<int> m_pending{ 0 };    ///< Tasks spawned and not finished.
+    std::atomic<qint64> m_executed{ 0 };    ///< Tasks finished since the last report.
+    std::atomic<qint64> m_steals{ 0 };      ///< Of which stolen.
+    std::atomic<qint64> m_busyNs{ 0 };      ///< Time spent in them.
+    qint64 m_startNs = 0;               ///< Time of the first spawn since the last report.
+};
+
+template <typename Body>
+void TaskScheduler::splitRange(TaskGroup& group, int begin, int end, int grain, const Body& body) {
+    // Fork the upper half and keep the lower one until the range fits the grain
+    while (end - begin > grain) {
+        const int mid = begin + (end - begin) / 2;
+        group.spawn([this, &group, mid, end, grain, &body]() { splitRange(group, mid, end, grain, body); });
+        end = mid;
+    }
+    if (!group.isCancelled()) body(begin, end);
+}
+
+template <typename Body>
+bool TaskScheduler::parallelFor(int begin, int end, int grain, const Body& body, const CancellationToken& token) {
+    if (end > begin) {
+        grain = std::max(1, grain);
+        TaskGroup group(*this, token);
+        group.spawn([this, &group, begin, end, grain, &body]() { splitRange(group, begin, end, grain, body); });
+        group.wait();
+    }
+    return !token.isCancelled();
+}
+
+template <typename T, typename Map, typename Combine>
+T TaskScheduler::parallelReduce(int begin, int end, int grain, T identity, const Map& map, const Combine& combine,
+                                const CancellationToken& token) {
+    if (end <= begin) return identity;
+    grain = std::max(1, grain);
+    const int chunks = static_cast<int>((qint64(end) - begin + grain - 1) / grain);
+
+    std::vector<T> partial(chunks, identity);
+    parallelFor(0, chunks, 1, [&](int first, int last) {
+        for (int c = first; c < last; ++c) {
+            const qint64 chunkBegin = qint64(begin) + qint64(c) * grain;
+            partial[c] = map(static_cast<int>(chunkBegin), static_cast<int>(std::min<qint64>(end, chunkBegin + grain)));
+        }
+    }, token);
+
+    T result = std::move(identity);
+    for (T& p : partial)
+        result = combine(std::move(result), std::move(p));
+    return result;
+}
+
+#endif // TASKSCHEDULER_H
@@ -0,0 +1,121 @@
+#include "TickArena.h"
+
+#include "diagnostics/MetricsRegistry.h"
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+
+namespace {
+
+/**
+ * @brief Heap fallback of an arena, counting what it hands out.
+ */
+class SpillResource : public std::pmr::memory_resource {
+public:
+    qint64 spilled = 0;     ///< Bytes allocated since the last reset.
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        spilled += static_cast<qint64>(bytes);
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+/**
+ * @brief Arena of one thread: a retained buffer served by a monotonic resource, spilling to the heap when full.
+ */
+class ThreadArena : public std::pmr::memory_resource {
+public:
+    ThreadArena() { allocateBuffer(TickArena::kInitialBytes); }
+
+    void open() { ++m_stats.depth; }
+
+    void close() {
+        if (--m_stats.depth > 0) return;
+
+        m_stats.peakBytes = std::max(m_stats.peakBytes, m_stats.usedBytes);
+        ++m_stats.resets;
+        const qint64 used = m_stats.usedBytes;
+        const bool spilled = m_spill.spilled > 0;
+        m_stats.usedBytes = 0;
+
+        if (!spilled) {
+            m_monotonic->release();     // rewinds to the start of the buffer
+            return;
+        }
+
+        // Leave room for alignment padding, then round up so repeated growth stays logarithmic
+        size_t capacity = m_capacity;
+        const size_t needed = static_cast<size_t>(used) + static_cast<size_t>(used) / 8;
+        while (capacity < needed)
+            capacity *= 2;
+        m_monotonic.reset();
+        m_spill.spilled = 0;
+        allocateBuffer(capacity);
+        ++m_stats.growths;
+        MetricsRegistry::instance().increment("arena.growths");
+    }
+
+    TickArena::Stats stats() const {
+        TickArena::Stats s = m_stats;
+        s.capacityBytes = static_cast<qint64>(m_capacity);
+        s.spilledBytes = m_spill.spilled;
+        return s;
+    }
+
+private:
+    void allocateBuffer(size_t capacity) {
+        m_buffer.reset();
+        m_buffer = std::make_unique<std::byte[]>(capacity);
+        m_capacity = capacity;
+        m_monotonic.emplace(m_buffer.get(), m_capacity, &m_spill);
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        Q_ASSERT_X(m_stats.depth > 0, "TickArena", "allocation outside a TickArena::Scope");
+        m_stats.usedBytes += static_cast<qint64>(bytes);
+        return m_monotonic->allocate(bytes, alignment);
+    }
+    void do_deallocate(void*, size_t, size_t) override {
+        // Released all at once when the outermost scope closes
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::unique_ptr<std::byte[]> m_buffer;                          ///< Retained buffer.
+    size_t m_capacity = 0;                                          ///< Its size.
+    SpillResource m_spill;                                          ///< Heap used once the buffer is full.
+    std::optional<std::pmr::monotonic_buffer_resource> m_monotonic; ///< Bump allocator over m_buffer.
+    TickArena::Stats m_stats;                                       ///< Usage so far.
+};
+
+ThreadArena& localArena() {
+    thread_local ThreadArena arena;
+    return arena;
+}
+
+} // namespace
+
+TickArena::Scope::Scope() {
+    localArena().open();
+}
+
+TickArena::Scope::~Scope() {
+    localArena().close();
+}
+
+std::pmr::memory_resource* TickArena::resource() {
+    return &localArena();
+}
+
+TickArena::Stats TickArena::stats() {
+    return localArena().stats();
+}
@@ -0,0 +1,70 @@
+#ifndef TICKARENA_H
+#define TICKARENA_H
+
+#include <QtGlobal>
+
+#include <memory_resource>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Thread-local monotonic arenas for the scratch data of a simulation pass (tallies, ranking buffers, drift moves).
+ *
+ * @details Every thread owns one retained buffer. While a Scope is open, resource() hands out memory from it with a pointer
+ * bump; deallocation is a no-op. When the outermost Scope of the thread closes, the arena rewinds to the start of the buffer,
+ * so the next pass reuses the same memory. A pass that needs more than the buffer spills to the heap; the arena then grows
+ * to the next power of two above its peak when the scope closes (counted in "arena.growths" of the MetricsRegistry), so a
+ * steady-state pass ends up making no heap allocations for its scratch.
+ *
+ * Memory from the arena stays valid until the owning thread's outermost Scope closes. Other threads may read and write it
+ * meanwhile (e.g. the tasks of a parallelFor filling a buffer owned by the caller), but must not allocate from it: each
+ * thread calls resource() for its own arena.
+ *
+ * @code
+ * TickArena::Scope scope;
+ * TickArena::Vector<int> counts(cells, 0, TickArena::resource());
+ * @endcode
+ */
+class TickArena {
+public:
+    static constexpr size_t kInitialBytes = size_t(1) << 20;   ///< Buffer size of a thread's arena before it grows.
+
+    template <typename T>
+    using Vector = std::pmr::vector<T>;     ///< Vector allocating from an arena.
+
+    template <typename K, typename V>
+    using HashMap = std::pmr::unordered_map<K, V>;  ///< Hash map allocating from an arena.
+
+    /** @brief Usage of the calling thread's arena. */
+    struct Stats {
+        qint64 capacityBytes = 0;   ///< Size of the retained buffer.
+        qint64 usedBytes = 0;       ///< Bytes handed out since the outermost scope opened.
+        qint64 peakBytes = 0;       ///< Largest usedBytes seen at the close of an outermost scope.
+        qint64 spilledBytes = 0;    ///< Bytes taken from the heap because the buffer was full, since the scope opened.
+        int growths = 0;            ///< Times the buffer was enlarged.
+        qint64 resets = 0;          ///< Outermost scopes closed.
+        int depth = 0;              ///< Scopes currently open.
+    };
+
+    /**
+     * @brief Marks a pass whose scratch memory is released together; scopes nest.
+     */
+    class Scope {
+    public:
+        /** @brief Opens a scope on the calling thread. */
+        Scope();
+        /** @brief Closes it, rewinding the arena if it was the outermost scope. */
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    /** @brief Returns the calling thread's arena; only valid to allocate from while a Scope is open on the thread. */
+    static std::pmr::memory_resource* resource();
+
+    /** @brief Returns the usage of the calling thread's arena. */
+    static Stats stats();
+};
+
+#endif // TICKARENA_H
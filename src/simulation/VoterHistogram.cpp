@@ -0,0 +1,103 @@
+#include "VoterHistogram.h"
+
+#include <algorithm>
+
+VoterHistogram::VoterHistogram()
+    : m_cells(kCellCount, 0)
+{
+}
+
+VoterHistogram::VoterHistogram(const QVector<Voter>& voters)
+    : VoterHistogram()
+{
+    for (const Voter& v : voters)
+        ++m_cells[cellIndex(v.ideologyX, v.ideologyY)];
+    m_total = voters.size();
+}
+
+void VoterHistogram::add(int x, int y, int n) {
+    m_cells[cellIndex(x, y)] += n;
+    m_total += n;
+    m_prefixDirty = true;
+}
+
+void VoterHistogram::remove(int x, int y, int n) {
+    m_cells[cellIndex(x, y)] -= n;
+    m_total -= n;
+    m_prefixDirty = true;
+}
+
+void VoterHistogram::move(int oldX, int oldY, int newX, int newY) {
+    const int from = cellIndex(oldX, oldY);
+    const int to = cellIndex(newX, newY);
+    if (from == to) return;
+    --m_cells[from];
+    ++m_cells[to];
+    m_prefixDirty = true;
+}
+
+void VoterHistogram::clear() {
+    std::fill(m_cells.begin(), m_cells.end(), 0);
+    m_total = 0;
+    m_prefixDirty = true;
+}
+
+int VoterHistogram::count(int x, int y) const {
+    if (x < kMinCoordinate || x > kMaxCoordinate || y < kMinCoordinate || y > kMaxCoordinate) return 0;
+    return m_cells[cellIndex(x, y)];
+}
+
+int VoterHistogram::total() const {
+    return m_total;
+}
+
+qint64 VoterHistogram::memoryBytes() const {
+    return qint64(m_cells.capacity() + m_prefix.capacity()) * qint64(sizeof(int));
+}
+
+int VoterHistogram::rectangleCount(int x0, int y0, int x1, int y1) const {
+    if (x0 > x1) std::swap(x0, x1);
+    if (y0 > y1) std::swap(y0, y1);
+    if (x1 < kMinCoordinate || x0 > kMaxCoordinate || y1 < kMinCoordinate || y0 > kMaxCoordinate) return 0;
+
+    x0 = std::max(x0, kMinCoordinate) - kMinCoordinate;
+    y0 = std::max(y0, kMinCoordinate) - kMinCoordinate;
+    x1 = std::min(x1, kMaxCoordinate) - kMinCoordinate + 1;
+    y1 = std::min(y1, kMaxCoordinate) - kMinCoordinate + 1;
+
+    if (m_prefixDirty) rebuildPrefixSums();
+    constexpr int stride = kSide + 1;
+    return m_prefix[y1 * stride + x1] - m_prefix[y0 * stride + x1]
+           - m_prefix[y1 * stride + x0] + m_prefix[y0 * stride + x0];
+}
+
+void VoterHistogram::rebuildPrefixSums() const {
+    constexpr int stride = kSide + 1;
+    m_prefix.assign(stride * stride, 0);
+    for (int y = 0; y < kSide; ++y) {
+        int rowSum = 0;
+        for (int x = 0; x < kSide; ++x) {
+            rowSum += m_cells[y * kSide + x];
+            m_prefix[(y + 1) * stride + (x + 1)] = m_prefix[y * stride + (x + 1)] + rowSum;
+        }
+    }
+    m_prefixDirty = false;
+}
+
+int VoterHistogram::cellIndex(int x, int y) {
+    x = std::clamp(x, kMinCoordinate, kMaxCoordinate) - kMinCoordinate;
+    y = std::clamp(y, kMinCoordinate, kMaxCoordinate) - kMinCoordinate;
+    return y * kSide + x;
+}
+
+int VoterHistogram::cellX(int cell) {
+    return cell % kSide + kMinCoordinate;
+}
+
+int VoterHistogram::cellY(int cell) {
+    return cell / kSide + kMinCoordinate;
+}
+
+const std::vector<int>& VoterHistogram::cells() const {
+    return m_cells;
+}
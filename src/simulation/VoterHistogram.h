@@ -0,0 +1,81 @@
+#ifndef VOTERHISTOGRAM_H
+#define VOTERHISTOGRAM_H
+
+#include <QVector>
+
+#include <vector>
+
+#include "models/Voter.h"
+
+/**
+ * @brief Number of voters at every integer point of the ideology compass.
+ *
+ * @details The compass spans [-100, 100] on both axes, giving a fixed grid of 201 x 201 cells. Aggregate queries over the whole
+ * population (vote shares, what-if evaluation) can iterate the grid instead of individual voters, so their cost no longer depends
+ * on how many voters exist. Coordinates outside the compass are clamped to its edge.
+ *
+ * Rectangle counts use a summed-area table that is rebuilt in O(cells) on the first query after a change and answered in O(1) afterwards.
+ */
+class VoterHistogram {
+public:
+    static constexpr int kMinCoordinate = -100;                      ///< Smallest coordinate on either axis.
+    static constexpr int kMaxCoordinate = 100;                       ///< Largest coordinate on either axis.
+    static constexpr int kSide = kMaxCoordinate - kMinCoordinate + 1; ///< Cells along each axis (201).
+    static constexpr int kCellCount = kSide * kSide;                 ///< Total number of cells.
+
+    /** @brief Constructs an empty histogram. */
+    VoterHistogram();
+
+    /**
+     * @brief Builds a histogram from a list of voters.
+     * @param voters Voters to count by their ideology coordinates.
+     */
+    explicit VoterHistogram(const QVector<Voter>& voters);
+
+    /** @brief Adds @p n voters at the given coordinates. */
+    void add(int x, int y, int n = 1);
+
+    /** @brief Removes @p n voters from the given coordinates. */
+    void remove(int x, int y, int n = 1);
+
+    /** @brief Moves one voter from the old coordinates to the new ones. */
+    void move(int oldX, int oldY, int newX, int newY);
+
+    /** @brief Removes every voter. */
+    void clear();
+
+    /** @brief Returns the number of voters at the given coordinates. */
+    int count(int x, int y) const;
+
+    /** @brief Returns the number of voters in the histogram. */
+    int total() const;
+
+    /**
+     * @brief Counts the voters inside an axis-aligned rectangle (bounds inclusive, in any order).
+     * @return Number of voters with x0 <= X <= x1 and y0 <= Y <= y1, clipped to the compass.
+     */
+    int rectangleCount(int x0, int y0, int x1, int y1) const;
+
+    /** @brief Returns the flat, row-major cell index of a coordinate pair (after clamping). */
+    static int cellIndex(int x, int y);
+    /** @brief Returns the X coordinate of a cell index. */
+    static int cellX(int cell);
+    /** @brief Returns the Y coordinate of a cell index. */
+    static int cellY(int cell);
+
+    /** @brief Provides the raw cell counts, @c kSide cells per row, row 0 being Y = -100. */
+    const std::vector<int>& cells() const;
+
+    /** @brief Returns the heap bytes held by the cells and the summed-area table. */
+    qint64 memoryBytes() const;
+
+private:
+    void rebuildPrefixSums() const;         ///< Recomputes the summed-area table from the cells.
+
+    std::vector<int> m_cells;               ///< Voter count per cell.
+    int m_total = 0;                        ///< Sum of all cells.
+    mutable std::vector<int> m_prefix;      ///< Summed-area table, (kSide + 1)^2 entries with a zero border.
+    mutable bool m_prefixDirty = true;      ///< True when the cells changed since the table was built.
+};
+
+#endif // VOTERHISTOGRAM_H
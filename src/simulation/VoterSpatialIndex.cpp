@@ -0,0 +1,178 @@
+#include "VoterSpatialIndex.h"
+
+#include "VoterHistogram.h"
+#include "diagnostics/MemoryReport.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <tuple>
+#include <utility>
+
+VoterSpatialIndex::VoterSpatialIndex()
+    : m_cells(VoterHistogram::kCellCount)
+{
+}
+
+void VoterSpatialIndex::rebuild(const QVector<Voter>& voters) {
+    clear();
+    m_slots.reserve(voters.size());
+    for (const Voter& v : voters)
+        insert(v.id, v.ideologyX, v.ideologyY);
+}
+
+void VoterSpatialIndex::clear() {
+    for (std::vector<int>& cell : m_cells)
+        cell.clear();
+    m_slots.clear();
+}
+
+void VoterSpatialIndex::insert(int voterId, int x, int y) {
+    if (m_slots.contains(voterId)) {
+        move(voterId, x, y);
+        return;
+    }
+    const int cell = VoterHistogram::cellIndex(x, y);
+    std::vector<int>& ids = m_cells[cell];
+    m_slots.insert(voterId, Slot{ cell, static_cast<int>(ids.size()) });
+    ids.push_back(voterId);
+}
+
+void VoterSpatialIndex::remove(int voterId) {
+    auto it = m_slots.find(voterId);
+    if (it == m_slots.end()) return;
+
+    // Move the cell's last ID into the gap
+    const Slot slot = *it;
+    m_slots.erase(it);
+    std::vector<int>& ids = m_cells[slot.cell];
+    const int last = ids.back();
+    ids[slot.index] = last;
+    ids.pop_back();
+    if (last != voterId) m_slots[last].index = slot.index;
+}
+
+void VoterSpatialIndex::move(int voterId, int x, int y) {
+    auto it = m_slots.constFind(voterId);
+    if (it != m_slots.cend() && it->cell == VoterHistogram::cellIndex(x, y)) return;
+    remove(voterId);
+    insert(voterId, x, y);
+}
+
+int VoterSpatialIndex::size() const {
+    return static_cast<int>(m_slots.size());
+}
+
+qint64 VoterSpatialIndex::memoryBytes() const {
+    qint64 bytes = qint64(m_cells.capacity()) * qint64(sizeof(std::vector<int>));
+    for (const std::vector<int>& ids : m_cells)
+        bytes += qint64(ids.capacity()) * qint64(sizeof(int));
+    return bytes + MemoryReport::hashBytes(m_slots);
+}
+
+QVector<VoterNeighbour> VoterSpatialIndex::nearest(int x, int y, int k, int excludeId) const {
+    QVector<VoterNeighbour> result;
+    if (k <= 0) return result;
+
+    const int cell = VoterHistogram::cellIndex(x, y);
+    const int cx = VoterHistogram::cellX(cell);
+    const int cy = VoterHistogram::cellY(cell);
+
+    // Max-heap of the best k so far, ordered by (squared distance, ID), with the cell of each
+    std::priority_queue<std::tuple<int, int, int>> best;
+    auto visit = [&](int px, int py) {
+        if (px < VoterHistogram::kMinCoordinate || px > VoterHistogram::kMaxCoordinate
+            || py < VoterHistogram::kMinCoordinate || py > VoterHistogram::kMaxCoordinate) return;
+        const int d2 = (px - cx) * (px - cx) + (py - cy) * (py - cy);
+        const int c = VoterHistogram::cellIndex(px, py);
+        for (int id : m_cells[c]) {
+            if (id == excludeId) continue;
+            const std::tuple<int, int, int> candidate(d2, id, c);
+            if (static_cast<int>(best.size()) < k) {
+                best.push(candidate);
+            } else if (candidate < best.top()) {
+                best.pop();
+                best.push(candidate);
+            }
+        }
+    };
+
+    for (int r = 0; r < VoterHistogram::kSide; ++r) {
+        for (int dx = -r; dx <= r; ++dx) {
+            visit(cx + dx, cy - r);
+            if (r > 0) visit(cx + dx, cy + r);
+        }
+        for (int dy = -r + 1; dy <= r - 1; ++dy) {
+            visit(cx - r, cy + dy);
+            visit(cx + r, cy + dy);
+        }
+
+        // Cells beyond ring r are at least r + 1 away
+        if (static_cast<int>(best.size()) == k && std::get<0>(best.top()) <= (r + 1) * (r + 1)) break;
+    }
+
+    result.resize(static_cast<int>(best.size()));
+    for (int i = result.size() - 1; i >= 0; --i) {
+        const auto [d2, id, neighbourCell] = best.top();
+        result[i] = VoterNeighbour{ id, VoterHistogram::cellX(neighbourCell), VoterHistogram::cellY(neighbourCell),
+                                    std::sqrt(static_cast<double>(d2)) };
+        best.pop();
+    }
+    return result;
+}
+
+QVector<int> VoterSpatialIndex::inRectangle(int x0, int y0, int x1, int y1) const {
+    QVector<int> result;
+    if (x0 > x1) std::swap(x0, x1);
+    if (y0 > y1) std::swap(y0, y1);
+    if (x1 < VoterHistogram::kMinCoordinate || x0 > VoterHistogram::kMaxCoordinate
+        || y1 < VoterHistogram::kMinCoordinate || y0 > VoterHistogram::kMaxCoordinate) return result;
+
+    x0 = std::max(x0, VoterHistogram::kMinCoordinate);
+    x1 = std::min(x1, VoterHistogram::kMaxCoordinate);
+    y0 = std::max(y0, VoterHistogram::kMinCoordinate);
+    y1 = std::min(y1, VoterHistogram::kMaxCoordinate);
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            for (int id : m_cells[VoterHistogram::cellIndex(x, y)])
+                result.append(id);
+        }
+    }
+    return result;
+}
+
+QVector<int> VoterSpatialIndex::inPolygon(const QVector<QPointF>& polygon) const {
+    QVector<int> result;
+    if (polygon.size() < 3) return result;
+
+    double minY = polygon.first().y(), maxY = minY;
+    for (const QPointF& p : polygon) {
+        minY = std::min(minY, p.y());
+        maxY = std::max(maxY, p.y());
+    }
+    const int y0 = std::max(VoterHistogram::kMinCoordinate, static_cast<int>(std::ceil(minY)));
+    const int y1 = std::min(VoterHistogram::kMaxCoordinate, static_cast<int>(std::floor(maxY)));
+
+    std::vector<double> crossings;
+    for (int y = y0; y <= y1; ++y) {
+        // X coordinates where the row crosses an edge; half-open edges count shared vertices once
+        crossings.clear();
+        for (int i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+            const QPointF& a = polygon[i];
+            const QPointF& b = polygon[j];
+            if ((a.y() > y) == (b.y() > y)) continue;
+            crossings.push_back(a.x() + (y - a.y()) * (b.x() - a.x()) / (b.y() - a.y()));
+        }
+        std::sort(crossings.begin(), crossings.end());
+
+        for (size_t k = 0; k + 1 < crossings.size(); k += 2) {
+            const int x0 = std::max(VoterHistogram::kMinCoordinate, static_cast<int>(std::ceil(crossings[k])));
+            const int x1 = std::min(VoterHistogram::kMaxCoordinate, static_cast<int>(std::floor(crossings[k + 1])));
+            for (int x = x0; x <= x1; ++x) {
+                for (int id : m_cells[VoterHistogram::cellIndex(x, y)])
+                    result.append(id);
+            }
+        }
+    }
+    return result;
+}
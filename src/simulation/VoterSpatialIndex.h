@@ -0,0 +1,93 @@
+#ifndef VOTERSPATIALINDEX_H
+#define VOTERSPATIALINDEX_H
+
+#include <QHash>
+#include <QPointF>
+#include <QVector>
+
+#include <vector>
+
+#include "models/Voter.h"
+
+/**
+ * @brief A voter found by VoterSpatialIndex::nearest, with its distance from the query point.
+ */
+struct VoterNeighbour {
+    int voterId = -1;           ///< ID of the neighbouring voter.
+    int x = 0;                  ///< X coordinate of the neighbour.
+    int y = 0;                  ///< Y coordinate of the neighbour.
+    double distance = 0.0;      ///< Euclidean distance on the compass.
+};
+
+/**
+ * @brief Voter IDs bucketed by compass cell, for nearest-neighbour queries.
+ *
+ * @details Uses the same 201 x 201 grid as VoterHistogram, but each cell lists the voters in it. Each voter remembers its slot, so
+ * insertions, removals and moves are O(1) (removal swaps the last ID of the cell into the gap).
+ *
+ * nearest() scans square rings of cells outward from the query point and stops once the ring distance exceeds the k-th best
+ * distance found, so its cost depends on k and the local density, not on the population. Range and polygon queries decide
+ * whole cells at once and only visit the cells inside the query's bounding box.
+ */
+class VoterSpatialIndex {
+public:
+    /** @brief Constructs an empty index. */
+    VoterSpatialIndex();
+
+    /** @brief Replaces the index contents with @p voters. */
+    void rebuild(const QVector<Voter>& voters);
+
+    /** @brief Removes every voter. */
+    void clear();
+
+    /** @brief Adds a voter at a compass coordinate (clamped); an already indexed voter is moved instead. */
+    void insert(int voterId, int x, int y);
+
+    /** @brief Removes a voter; unknown IDs are ignored. */
+    void remove(int voterId);
+
+    /** @brief Moves a voter to a new compass coordinate (clamped); unknown IDs are inserted. */
+    void move(int voterId, int x, int y);
+
+    /** @brief Returns the number of indexed voters. */
+    int size() const;
+
+    /** @brief Returns an estimate of the heap bytes held by the cell lists and the slot lookup. */
+    qint64 memoryBytes() const;
+
+    /**
+     * @brief Finds the voters closest to a point.
+     * @param x X coordinate of the query point.
+     * @param y Y coordinate of the query point.
+     * @param k Maximum number of neighbours to return.
+     * @param excludeId Voter to leave out, e.g. the voter at the query point (-1 for none).
+     * @return Up to @p k neighbours ordered by distance, ties broken by lower ID.
+     */
+    QVector<VoterNeighbour> nearest(int x, int y, int k, int excludeId = -1) const;
+
+    /**
+     * @brief Finds the voters inside an axis-aligned rectangle.
+     * @return IDs of the voters with x0 <= X <= x1 and y0 <= Y <= y1 (bounds in any order, clipped to the compass).
+     */
+    QVector<int> inRectangle(int x0, int y0, int x1, int y1) const;
+
+    /**
+     * @brief Finds the voters inside a polygon, e.g. a lasso drawn on the compass.
+     * @param polygon Vertices in compass coordinates; the last vertex connects back to the first.
+     * @return IDs of the voters whose cell lies inside the polygon (even-odd rule).
+     *
+     * Each grid row is intersected with the polygon edges once, and every cell between a pair of crossings is taken whole.
+     */
+    QVector<int> inPolygon(const QVector<QPointF>& polygon) const;
+
+private:
+    struct Slot {
+        int cell = 0;               ///< Cell index (VoterHistogram::cellIndex).
+        int index = 0;              ///< Position within the cell's list.
+    };
+
+    std::vector<std::vector<int>> m_cells;  ///< Voter IDs per cell, row-major like VoterHistogram.
+    QHash<int, Slot> m_slots;               ///< Cell and position of every indexed voter.
+};
+
+#endif // VOTERSPATIALINDEX_H
@@ -0,0 +1,113 @@
+#include "ParliamentChartWidget.h"
+#include "simulation/DistrictTally.h"
+#include "simulation/SeatAllocation.h"
+#include "diagnostics/InteractionProfiler.h"
+#include "diagnostics/Tracer.h"
+#include "diagnostics/MetricsRegistry.h"
+
+#include <QtCharts/QChart>
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+
+ParliamentChartWidget::ParliamentChartWidget(PartyModel* partyModel, VoterModel* voterModel, QWidget* parent)
+    : QWidget(parent), partyModel(partyModel), voterModel(voterModel)
+{
+    seatSeries = new QPieSeries();
+    setupChart();
+    updateChart();
+
+    connect(partyModel, &PartyModel::dataChangedExternally, this, &ParliamentChartWidget::updateChart);
+    connect(voterModel, &VoterModel::districtsChanged, this, &ParliamentChartWidget::updateChart);
+}
+
+void ParliamentChartWidget::setupChart() {
+    // Half a donut reads as a hemicycle
+    seatSeries->setPieStartAngle(-90);
+    seatSeries->setPieEndAngle(90);
+    seatSeries->setHoleSize(0.45);
+    seatSeries->setVerticalPosition(0.7);
+
+    QChart* chart = new QChart();
+    chart->addSeries(seatSeries);
+    chart->setTitle("Parliament Composition");
+    chart->legend()->setAlignment(Qt::AlignRight);
+
+    chartView = new QChartView(chart);
+    chartView->setRenderHint(QPainter::Antialiasing);
+
+    methodComboBox = new QComboBox(this);
+    for (SeatMethod method : { SeatMethod::FirstPastThePost, SeatMethod::DHondt,
+                               SeatMethod::SainteLague, SeatMethod::LargestRemainder }) {
+        methodComboBox->addItem(SeatAllocator::methodName(method), static_cast<int>(method));
+    }
+
+    seatsSpinBox = new QSpinBox(this);
+    seatsSpinBox->setPrefix("Seats/district ");
+    seatsSpinBox->setRange(1, 100);
+    seatsSpinBox->setValue(1);
+
+    districtsSpinBox = new QSpinBox(this);
+    districtsSpinBox->setPrefix("Districts ");
+    districtsSpinBox->setRange(1, 100000);
+    districtsSpinBox->setValue(qMax(1, voterModel->districtCount()));
+
+    redistrictButton = new QPushButton("Redistrict", this);
+    summaryLabel = new QLabel(this);
+
+    auto controls = new QHBoxLayout();
+    controls->addWidget(methodComboBox);
+    controls->addWidget(seatsSpinBox);
+    controls->addWidget(districtsSpinBox);
+    controls->addWidget(redistrictButton);
+
+    auto layout = new QVBoxLayout(this);
+    layout->addLayout(controls);
+    layout->addWidget(chartView);
+    layout->addWidget(summaryLabel);
+    layout->setContentsMargins(0, 0, 0, 0);
+
+    connect(methodComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &ParliamentChartWidget::updateChart);
+    connect(seatsSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, &ParliamentChartWidget::updateChart);
+    connect(redistrictButton, &QPushButton::clicked, this, [this]() {
+        voterModel->assignDistricts(districtsSpinBox->value());
+    });
+}
+
+void ParliamentChartWidget::updateChart() {
+    ProfileScope profile("chart/ParliamentChartWidget::updateChart");
+    TRACE_SCOPE("chart", "ParliamentChartWidget::updateChart");
+    MetricsRegistry::instance().increment("chart.ParliamentChartWidget::updateChart");
+    seatSeries->clear();
+
+    const int districts = voterModel->districtCount();
+    if (districts == 0) {
+        seatSeries->append("No districts", 1.0);
+        summaryLabel->setText("Press Redistrict to divide voters into districts.");
+        return;
+    }
+
+    const QVector<Party>& parties = partyModel->getAllParties();
+    const SeatMethod method = static_cast<SeatMethod>(methodComboBox->currentData().toInt());
+    const int seatsPerDistrict = seatsSpinBox->value();
+
+    DistrictTally tally(voterModel->getAllVoters(), parties, districts);
+    QMap<int, int> seats = SeatAllocator::parliament(tally, seatsPerDistrict, method);
+
+    int totalSeats = 0;
+    for (const Party& p : parties) {
+        const int won = seats.value(p.id, 0);
+        if (won > 0) {
+            seatSeries->append(QString("%1 (%2)").arg(p.name).arg(won), won);
+            totalSeats += won;
+        }
+    }
+
+    if (totalSeats == 0) {
+        seatSeries->append("No Data", 1.0);
+        summaryLabel->setText(QString("%1 districts, no votes cast").arg(districts));
+        return;
+    }
+
+    summaryLabel->setText(QString("%1 seats in %2 districts, majority %3")
+                              .arg(totalSeats).arg(districts).arg(totalSeats / 2 + 1));
+}
@@ -0,0 +1,53 @@
+#ifndef PARLIAMENTCHARTWIDGET_H
+#define PARLIAMENTCHARTWIDGET_H
+
+#include <QWidget>
+#include <QComboBox>
+#include <QLabel>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QtCharts/QChartView>
+#include <QtCharts/QPieSeries>
+#include "models/PartyModel.h"
+#include "models/VoterModel.h"
+
+/**
+ * @brief Widget showing the composition of parliament as a hemicycle chart.
+ *
+ * @details Votes are tallied per electoral district and turned into seats with the selected apportionment method. The user picks the number of districts, the seats per district and the method.
+ */
+class ParliamentChartWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructs a ParliamentChartWidget.
+     * @param partyModel PartyModel providing the parties standing for election.
+     * @param voterModel VoterModel providing voters and their districts.
+     * @param parent Optional parent widget.
+     */
+    explicit ParliamentChartWidget(PartyModel* partyModel, VoterModel* voterModel, QWidget* parent = nullptr);
+
+public slots:
+    /**
+     * @brief Recounts every district and redraws the hemicycle.
+     *
+     * Called whenever voters, parties or districts change.
+     */
+    void updateChart();
+
+private:
+    void setupChart();                  ///< Creates the chart view and the district/method controls.
+
+    QChartView* chartView;              ///< View displaying the hemicycle.
+    QPieSeries* seatSeries;             ///< Half-pie series, one slice per party holding seats.
+    QComboBox* methodComboBox;          ///< Seat allocation method selector.
+    QSpinBox* seatsSpinBox;             ///< Seats elected by each district.
+    QSpinBox* districtsSpinBox;         ///< Number of districts to draw.
+    QPushButton* redistrictButton;      ///< Applies the district count to all voters.
+    QLabel* summaryLabel;               ///< Total seats and majority threshold.
+    PartyModel* partyModel;             ///< PartyModel providing party data.
+    VoterModel* voterModel;             ///< VoterModel providing voter and district data.
+};
+
+#endif // PARLIAMENTCHARTWIDGET_H
@@ -1,8 +1,13 @@
 #include "PartyChartWidget.h"
 #include "PartyModel.h"
+#include "diagnostics/InteractionProfiler.h"
+#include "diagnostics/Tracer.h"
+#include "diagnostics/MetricsRegistry.h"
 #include <QtCharts/QChart>
 #include <QVBoxLayout>
 
+#include <utility>
+
 PartyChartWidget::PartyChartWidget(PartyModel *model, QWidget *parent)
     : QWidget(parent), partyModel(model) {
 
@@ -34,26 +39,39 @@ void PartyChartWidget::onDataChanged() {
 }
 
 void PartyChartWidget::updateChart() {
-    pieSeries->clear();
+    ProfileScope profile("chart/PartyChartWidget::updateChart");
+    TRACE_SCOPE("chart", "PartyChartWidget::updateChart");
+    MetricsRegistry::instance().increment("chart.PartyChartWidget::updateChart");
     const QVector<Party>& parties = partyModel->getAllParties();
+    partyModel->popularityShares(m_shares);
+
+    // Update surviving slices in place and add slices for parties that gained voters
+    QHash<int, QPieSlice*> kept;
+    kept.reserve(m_slices.size());
+    for (int row = 0; row < parties.size(); ++row) {
+        const Party& p = parties[row];
+        const double pct = m_shares[row];
+        if (pct <= 0) continue;
 
-    double total = 0;
-    for (const Party &p : parties) {
-        double pct = partyModel->calculatePopularity(p.id);
-        if (pct > 0) {
-            total += pct;
+        QPieSlice* slice = m_slices.take(p.id);
+        if (!slice) {
+            slice = pieSeries->append(p.name, pct);
+        } else {
+            if (slice->value() != pct) slice->setValue(pct);
+            if (slice->label() != p.name) slice->setLabel(p.name);
         }
+        kept.insert(p.id, slice);
     }
 
-    if (total == 0) {
-        pieSeries->append("No Data", 1.0);
-        return;
-    }
+    // Whatever is left belongs to deleted parties or parties without voters
+    for (QPieSlice* slice : std::as_const(m_slices))
+        pieSeries->remove(slice);
+    m_slices = kept;
 
-    for (const Party &p : parties) {
-        double pct = partyModel->calculatePopularity(p.id);
-        if (pct > 0) {
-            pieSeries->append(p.name, pct);
-        }
+    if (m_slices.isEmpty() && !m_emptySlice) {
+        m_emptySlice = pieSeries->append("No Data", 1.0);
+    } else if (!m_slices.isEmpty() && m_emptySlice) {
+        pieSeries->remove(m_emptySlice);
+        m_emptySlice = nullptr;
     }
 }
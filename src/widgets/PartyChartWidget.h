@@ -2,12 +2,18 @@
 #define PARTYCHARTWIDGET_H
 
 #include <QWidget>
+#include <QHash>
+#include <QVector>
 #include <QtCharts/QChartView>
 #include <QtCharts/QPieSeries>
+#include <QtCharts/QPieSlice>
 #include "models/PartyModel.h"
 
 /**
  * @brief Widget for displaying party popularity as a pie chart.
+ *
+ * @details Slices are kept per party ID and updated in place; slices are only created or removed when a party gains its first
+ * voter or loses its last one, so frequent updates (e.g. during a drift simulation) do not rebuild the series.
  */
 class PartyChartWidget : public QWidget {
     Q_OBJECT
@@ -26,7 +32,7 @@ public slots:
     /**
      * @brief Slot to update the chart when the party data changes.
      *
-     * Rebuilds the pie chart to reflect the current party data.
+     * Updates the slice values from one popularity snapshot.
      */
     void onDataChanged();
 
@@ -37,6 +43,9 @@ private:
     QChartView* chartView;       ///< Chart view widget displaying the pie chart.
     QPieSeries* pieSeries;       ///< Pie series representing party popularity data.
     PartyModel* partyModel;      ///< PartyModel providing the data for the chart.
+    QHash<int, QPieSlice*> m_slices;     ///< Slice of every party with voters, keyed by party ID (owned by pieSeries).
+    QPieSlice* m_emptySlice = nullptr;   ///< Placeholder slice shown while no party has voters.
+    QVector<double> m_shares;            ///< Popularity per party row, refilled on every update.
 };
 
 #endif // PARTYCHARTWIDGET_H
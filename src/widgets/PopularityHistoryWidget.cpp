@@ -0,0 +1,114 @@
+#include "PopularityHistoryWidget.h"
+#include "diagnostics/InteractionProfiler.h"
+#include "diagnostics/Tracer.h"
+#include "diagnostics/MetricsRegistry.h"
+#include <QtCharts/QChart>
+#include <QTimer>
+#include <QVBoxLayout>
+
+#include <algorithm>
+#include <utility>
+
+PopularityHistoryWidget::PopularityHistoryWidget(PartyModel* model, QWidget* parent)
+    : QWidget(parent), partyModel(model)
+{
+    setupChart();
+    recordSnapshot();
+
+    connect(partyModel, &PartyModel::dataChangedExternally, this, &PopularityHistoryWidget::recordSnapshot);
+}
+
+void PopularityHistoryWidget::setupChart() {
+    chart = new QChart();
+    chart->setTitle("Popularity Over Time");
+    chart->legend()->setAlignment(Qt::AlignBottom);
+
+    axisX = new QValueAxis();
+    axisX->setTitleText("Sample");
+    axisX->setLabelFormat("%d");
+    axisY = new QValueAxis();
+    axisY->setTitleText("Share (%)");
+    axisY->setRange(0, 100);
+    chart->addAxis(axisX, Qt::AlignBottom);
+    chart->addAxis(axisY, Qt::AlignLeft);
+
+    chartView = new QChartView(chart);
+    chartView->setRenderHint(QPainter::Antialiasing);
+
+    auto layout = new QVBoxLayout(this);
+    layout->addWidget(chartView);
+    layout->setContentsMargins(0, 0, 0, 0);
+
+    // The column count follows the plot width
+    connect(chart, &QChart::plotAreaChanged, this, &PopularityHistoryWidget::scheduleRedraw);
+}
+
+const PopularityHistory& PopularityHistoryWidget::history() const {
+    return m_history;
+}
+
+void PopularityHistoryWidget::recordSnapshot() {
+    // Runs on every tick, so the buffers are members; listing every party also drops the rings of deleted ones
+    const QVector<Party>& parties = partyModel->getAllParties();
+    m_partyIds.resize(parties.size());
+    for (int row = 0; row < parties.size(); ++row)
+        m_partyIds[row] = parties[row].id;
+    partyModel->popularityShares(m_shares);
+    m_history.record(m_partyIds, m_shares);
+    scheduleRedraw();
+}
+
+void PopularityHistoryWidget::clearHistory() {
+    m_history.clear();
+    recordSnapshot();
+}
+
+void PopularityHistoryWidget::scheduleRedraw() {
+    if (m_redrawPending) return;
+    m_redrawPending = true;
+    QTimer::singleShot(0, this, [this]() {
+        m_redrawPending = false;
+        redraw();
+    });
+}
+
+void PopularityHistoryWidget::redraw() {
+    ProfileScope profile("chart/PopularityHistoryWidget::redraw");
+    TRACE_SCOPE("chart", "PopularityHistoryWidget::redraw");
+    MetricsRegistry::instance().increment("chart.PopularityHistoryWidget::redraw");
+    const qint64 first = m_history.firstAvailableSample();
+    const qint64 last = std::max<qint64>(first, m_history.sampleCount() - 1);
+    const int columns = std::max(1, static_cast<int>(chart->plotArea().width()));
+
+    QHash<int, QLineSeries*> kept;
+    for (const Party& p : partyModel->getAllParties()) {
+        QLineSeries* series = m_series.take(p.id);
+        if (!series) {
+            series = new QLineSeries();
+            chart->addSeries(series);
+            series->attachAxis(axisX);
+            series->attachAxis(axisY);
+        }
+        if (series->name() != p.name) series->setName(p.name);
+
+        // Two points per column: the line sweeps each column's full min/max range
+        const QVector<ShareRange> ranges = m_history.columns(p.id, first, last, columns);
+        QList<QPointF> points;
+        points.reserve(ranges.size() * 2);
+        for (const ShareRange& r : ranges) {
+            points.append(QPointF(r.sample, r.min));
+            if (r.max != r.min) points.append(QPointF(r.sample, r.max));
+        }
+        series->replace(points);
+        kept.insert(p.id, series);
+    }
+
+    // Whatever is left belongs to deleted parties
+    for (QLineSeries* series : std::as_const(m_series)) {
+        chart->removeSeries(series);
+        delete series;
+    }
+    m_series = kept;
+
+    axisX->setRange(first, std::max<qint64>(last, first + 1));
+}
@@ -0,0 +1,61 @@
+#ifndef POPULARITYHISTORYWIDGET_H
+#define POPULARITYHISTORYWIDGET_H
+
+#include <QWidget>
+#include <QHash>
+#include <QtCharts/QChartView>
+#include <QtCharts/QLineSeries>
+#include <QtCharts/QValueAxis>
+#include "models/PartyModel.h"
+#include "simulation/PopularityHistory.h"
+
+/**
+ * @brief Widget plotting every party's vote share over time.
+ *
+ * @details A sample of PartyModel::popularityShares() is recorded into a PopularityHistory each time the popularity is
+ * recalculated, i.e. after every voter or party change and every simulation tick. Each party is drawn as a min/max envelope
+ * with one column per plot pixel, so redrawing costs the same for ten samples or a hundred thousand. Redraws are coalesced
+ * so a burst of samples triggers one.
+ */
+class PopularityHistoryWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructs a PopularityHistoryWidget.
+     * @param model Pointer to the PartyModel providing the popularity.
+     * @param parent Optional parent widget.
+     *
+     * Records the current popularity as the first sample.
+     */
+    explicit PopularityHistoryWidget(PartyModel* model, QWidget* parent = nullptr);
+
+    /** @brief Provides the recorded history. */
+    const PopularityHistory& history() const;
+
+public slots:
+    /** @brief Records the current popularity of every party and schedules a redraw. */
+    void recordSnapshot();
+
+    /** @brief Forgets all samples, e.g. after the data was reset, and starts again from the current popularity. */
+    void clearHistory();
+
+private:
+    void setupChart();          ///< Sets up the chart view, axes and redraw triggers.
+    void scheduleRedraw();      ///< Queues one redraw for the next event loop pass.
+    void redraw();              ///< Decimates the history to the plot width and replaces each party's series.
+
+    QChart* chart;                          ///< Chart holding one line series per party.
+    QChartView* chartView;                  ///< View widget for the chart.
+    QValueAxis* axisX;                      ///< Sample axis.
+    QValueAxis* axisY;                      ///< Share axis (0-100 %).
+    PartyModel* partyModel;                 ///< PartyModel providing the popularity.
+
+    PopularityHistory m_history;            ///< Recorded shares of every party.
+    QHash<int, QLineSeries*> m_series;      ///< Envelope series per party ID (owned by the chart).
+    QVector<int> m_partyIds;                ///< Party IDs of the sample being recorded, in row order.
+    QVector<double> m_shares;               ///< Shares of the sample being recorded, aligned with m_partyIds.
+    bool m_redrawPending = false;           ///< True while a redraw is queued.
+};
+
+#endif // POPULARITYHISTORYWIDGET_H
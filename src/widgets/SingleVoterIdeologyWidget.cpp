@@ -1,13 +1,36 @@
 #include "SingleVoterIdeologyWidget.h"
+#include "models/PartyModel.h"
+#include "models/VoterModel.h"
+#include "models/IdeologySpace.h"
+#include "simulation/IdeologyPoints.h"
+#include "diagnostics/InteractionProfiler.h"
+#include "diagnostics/Tracer.h"
+#include "diagnostics/MetricsRegistry.h"
 #include <QVBoxLayout>
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
 SingleVoterIdeologyWidget::SingleVoterIdeologyWidget(QWidget* parent)
     : QWidget(parent)
 {
     chart = new QChart();
     chart->setTitle("Selected Voter Ideology");
 
+    partySeries = new QScatterSeries();
+    partySeries->setName("Parties");
+    partySeries->setMarkerShape(QScatterSeries::MarkerShapeRectangle);
+    partySeries->setMarkerSize(10.0);
+    chart->addSeries(partySeries);
+
+    neighbourSeries = new QScatterSeries();
+    neighbourSeries->setName("Nearest voters");
+    neighbourSeries->setMarkerSize(7.0);
+    chart->addSeries(neighbourSeries);
+
     series = new QScatterSeries();
+    series->setName("Voter");
     series->setMarkerSize(12.0);
     chart->addSeries(series);
 
@@ -20,19 +43,101 @@ SingleVoterIdeologyWidget::SingleVoterIdeologyWidget(QWidget* parent)
 
     chart->addAxis(axisX, Qt::AlignBottom);
     chart->addAxis(axisY, Qt::AlignLeft);
-    series->attachAxis(axisX);
-    series->attachAxis(axisY);
-    chart->legend()->hide();
+    for (QScatterSeries* s : { partySeries, neighbourSeries, series }) {
+        s->attachAxis(axisX);
+        s->attachAxis(axisY);
+    }
+    chart->legend()->setAlignment(Qt::AlignBottom);
 
     chartView = new QChartView(chart);
     chartView->setRenderHint(QPainter::Antialiasing);
 
+    distanceLabel = new QLabel(this);
+    distanceLabel->setWordWrap(true);
+
     QVBoxLayout* layout = new QVBoxLayout(this);
     layout->addWidget(chartView);
+    layout->addWidget(distanceLabel);
     setLayout(layout);
 }
 
+void SingleVoterIdeologyWidget::setVoterModel(const VoterModel* model) {
+    voterModel = model;
+}
+
+void SingleVoterIdeologyWidget::setPartyModel(const PartyModel* model) {
+    partyModel = model;
+}
+
+void SingleVoterIdeologyWidget::setNeighbourCount(int count) {
+    m_neighbourCount = std::max(0, count);
+}
+
+int SingleVoterIdeologyWidget::neighbourCount() const {
+    return m_neighbourCount;
+}
+
 void SingleVoterIdeologyWidget::showVoter(const Voter& voter) {
-    series->clear();
-    series->append(voter.ideologyX, voter.ideologyY);
-}
\ No newline at end of file
+    ProfileScope profile("chart/SingleVoterIdeologyWidget::showVoter");
+    TRACE_SCOPE("chart", "SingleVoterIdeologyWidget::showVoter");
+    MetricsRegistry::instance().increment("chart.SingleVoterIdeologyWidget::showVoter");
+    series->replace({ QPointF(voter.ideologyX, voter.ideologyY) });
+
+    QStringList lines;
+
+    QList<QPointF> neighbours;
+    if (voterModel) {
+        const QVector<VoterNeighbour> nearest =
+            voterModel->spatialIndex().nearest(voter.ideologyX, voter.ideologyY, m_neighbourCount, voter.id);
+        neighbours.reserve(nearest.size());
+        for (const VoterNeighbour& n : nearest)
+            neighbours.append(QPointF(n.x, n.y));
+        if (!nearest.isEmpty())
+            lines << QString("%1 nearest voters within %2").arg(nearest.size()).arg(nearest.last().distance, 0, 'f', 1);
+    }
+    neighbourSeries->replace(neighbours);
+
+    QList<QPointF> partyPoints;
+    if (partyModel) {
+        // Distances are measured on every axis of the space; the chart itself only shows the first two
+        int position[IdeologySpace::kMaxDimensions] = {};
+        int dimensions = IdeologySpace::kMinDimensions;
+        if (voterModel) dimensions = voterModel->positionAt(voterModel->rowOfVoter(voter.id), position);
+        position[0] = voter.ideologyX;
+        position[1] = voter.ideologyY;
+
+        const QVector<Party>& parties = partyModel->getAllParties();
+        const IdeologyPoints& partyPositions = partyModel->positions();
+        dimensions = std::min(dimensions, std::max(partyPositions.dimensions(), IdeologySpace::kMinDimensions));
+        QVector<QPair<double, QString>> distances;
+        for (int i = 0; i < parties.size(); ++i) {
+            const Party& p = parties[i];
+            partyPoints.append(QPointF(p.ideologyX, p.ideologyY));
+            double squared = double(p.ideologyX - position[0]) * (p.ideologyX - position[0])
+                             + double(p.ideologyY - position[1]) * (p.ideologyY - position[1]);
+            for (int a = IdeologySpace::kMinDimensions; a < dimensions; ++a) {
+                const double delta = (i < partyPositions.size() ? partyPositions.coordinate(i, a) : 0) - position[a];
+                squared += delta * delta;
+            }
+            distances.append({ std::sqrt(squared), p.name });
+        }
+        std::sort(distances.begin(), distances.end());
+
+        if (distances.size() >= 2) {
+            lines << QString("Nearest party: %1 (%2), runner-up: %3 (%4), margin %5")
+                         .arg(distances[0].second).arg(distances[0].first, 0, 'f', 1)
+                         .arg(distances[1].second).arg(distances[1].first, 0, 'f', 1)
+                         .arg(distances[1].first - distances[0].first, 0, 'f', 1);
+        } else if (distances.size() == 1) {
+            lines << QString("Nearest party: %1 (%2)").arg(distances[0].second).arg(distances[0].first, 0, 'f', 1);
+        }
+
+        QStringList all;
+        for (const auto& d : std::as_const(distances))
+            all << QString("%1 %2").arg(d.second).arg(d.first, 0, 'f', 1);
+        if (!all.isEmpty()) lines << "Party distances: " + all.join(", ");
+    }
+    partySeries->replace(partyPoints);
+
+    distanceLabel->setText(lines.join('\n'));
+}
@@ -2,13 +2,21 @@
 #define SINGLEVOTERIDEOLOGYWIDGET_H
 
 #include <QWidget>
+#include <QLabel>
 #include <QtCharts/QChartView>
 #include <QtCharts/QScatterSeries>
 #include <QtCharts/QValueAxis>
 #include "models/Voter.h"
 
+class VoterModel;
+class PartyModel;
+
 /**
  * @brief Widget for displaying a single voter's ideology on a 2D chart.
+ *
+ * @details Besides the voter itself the chart shows the voter's nearest neighbours, found through VoterModel::spatialIndex(),
+ * and every party's position. A label lists the distance to each party, measured on every axis of the ideology space, and the
+ * margin between the nearest party and the runner-up.
  */
 class SingleVoterIdeologyWidget : public QWidget {
     Q_OBJECT
@@ -26,16 +34,40 @@ public:
      * @brief Plots the given voter's ideological position on the chart.
      * @param voter The Voter whose ideology will be displayed.
      *
-     * Resets the chart series to show the provided voter's coordinates.
+     * Resets the chart series to show the provided voter's coordinates, nearest neighbours and party distances.
      */
     void showVoter(const Voter& voter);
 
+    /**
+     * @brief Sets the VoterModel whose spatial index provides the neighbours.
+     * @param model Pointer to the VoterModel, or nullptr to show no neighbours.
+     */
+    void setVoterModel(const VoterModel* model);
+
+    /**
+     * @brief Sets the PartyModel providing the party positions.
+     * @param model Pointer to the PartyModel, or nullptr to show no parties.
+     */
+    void setPartyModel(const PartyModel* model);
+
+    /** @brief Sets how many nearest voters are shown (default 10). */
+    void setNeighbourCount(int count);
+
+    /** @brief Returns how many nearest voters are shown. */
+    int neighbourCount() const;
+
 private:
     QChart* chart;               ///< Chart object for the ideology scatter plot.
     QChartView* chartView;         ///< View widget for displaying the chart.
     QScatterSeries* series;         ///< Scatter series representing the single voter point.
+    QScatterSeries* neighbourSeries;    ///< Nearest voters of the selected voter.
+    QScatterSeries* partySeries;        ///< Position of every party.
+    QLabel* distanceLabel;              ///< Party distances and runner-up margin.
     QValueAxis* axisX;             ///< X-axis (economic axis) of the chart.
     QValueAxis* axisY;             ///< Y-axis (social axis) of the chart.
+    const VoterModel* voterModel = nullptr;     ///< VoterModel providing the spatial index.
+    const PartyModel* partyModel = nullptr;     ///< PartyModel providing the party positions.
+    int m_neighbourCount = 10;                  ///< Number of nearest voters to show.
 };
 
 #endif // SINGLEVOTERIDEOLOGYWIDGET_H
@@ -1,5 +1,29 @@
 #include "VoterIdeologyChartWidget.h"
+#include "diagnostics/InteractionProfiler.h"
+#include "diagnostics/Tracer.h"
+#include "diagnostics/MetricsRegistry.h"
+#include "diagnostics/MemoryReport.h"
+#include <QComboBox>
+#include <QHBoxLayout>
+#include <QLabel>
 #include <QVBoxLayout>
+#include <QMouseEvent>
+#include <QPainterPath>
+#include <QPen>
+#include <QPolygonF>
+#include <QWheelEvent>
+#include <QTimer>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr int kPaletteSize = 256;
+const char* const kDefaultXTitle = "Left <--> Right";
+const char* const kDefaultYTitle = "Libertarian <--> Authoritarian";
+
+}
 
 VoterIdeologyChartWidget::VoterIdeologyChartWidget(QWidget *parent)
     : QWidget(parent), voterModel(nullptr)
@@ -12,8 +36,8 @@ VoterIdeologyChartWidget::VoterIdeologyChartWidget(QWidget *parent)
     axisY = new QValueAxis;
     axisX->setRange(-100, 100);
     axisY->setRange(-100, 100);
-    axisX->setTitleText("Left <--> Right");
-    axisY->setTitleText("Libertarian <--> Authoritarian");
+    axisX->setTitleText(kDefaultXTitle);
+    axisY->setTitleText(kDefaultYTitle);
 
     chart->addSeries(series);
     chart->addAxis(axisX, Qt::AlignBottom);
@@ -25,23 +49,546 @@ VoterIdeologyChartWidget::VoterIdeologyChartWidget(QWidget *parent)
 
     chartView = new QChartView(chart);
     chartView->setRenderHint(QPainter::Antialiasing);
+    chartView->setRubberBand(QChartView::RectangleRubberBand);
+    chartView->viewport()->installEventFilter(this);
+
+    m_selectionOutline = new QGraphicsPathItem(chart);
+    m_selectionOutline->setPen(QPen(Qt::black, 1, Qt::DashLine));
+    m_selectionOutline->setBrush(QColor(0, 0, 0, 30));
+    m_selectionOutline->setZValue(100);
+
+    // Sparse cells are a translucent blue, dense ones an opaque red
+    m_palette.reserve(kPaletteSize);
+    for (int i = 0; i < kPaletteSize; ++i) {
+        const double t = double(i) / (kPaletteSize - 1);
+        m_palette.append(QColor::fromHsv(int(240 * (1.0 - t)), 255, 255, int(70 + 185 * t)).rgba());
+    }
+
+    // Zooming, panning and resizing change which compass cells each pixel shows
+    connect(axisX, &QValueAxis::rangeChanged, this, [this] { scheduleHeatmapRender(); });
+    connect(axisY, &QValueAxis::rangeChanged, this, [this] { scheduleHeatmapRender(); });
+    connect(chart, &QChart::plotAreaChanged, this, [this] { scheduleHeatmapRender(); });
+    connect(axisX, &QValueAxis::rangeChanged, this, &VoterIdeologyChartWidget::updateSelectionOutline);
+    connect(axisY, &QValueAxis::rangeChanged, this, &VoterIdeologyChartWidget::updateSelectionOutline);
+    connect(chart, &QChart::plotAreaChanged, this, &VoterIdeologyChartWidget::updateSelectionOutline);
+
+    axisBar = new QWidget(this);
+    horizontalAxisBox = new QComboBox(axisBar);
+    verticalAxisBox = new QComboBox(axisBar);
+    QHBoxLayout* axisLayout = new QHBoxLayout(axisBar);
+    axisLayout->setContentsMargins(0, 0, 0, 0);
+    axisLayout->addWidget(new QLabel("Horizontal axis:", axisBar));
+    axisLayout->addWidget(horizontalAxisBox);
+    axisLayout->addWidget(new QLabel("Vertical axis:", axisBar));
+    axisLayout->addWidget(verticalAxisBox);
+    axisLayout->addStretch();
+    axisBar->hide();
+    connect(horizontalAxisBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+            [this](int axis) { setAxes(axis, m_verticalAxis); });
+    connect(verticalAxisBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+            [this](int axis) { setAxes(m_horizontalAxis, axis); });
 
     QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->addWidget(axisBar);
     layout->addWidget(chartView);
     setLayout(layout);
 }
 
+void VoterIdeologyChartWidget::setAxes(int horizontal, int vertical) {
+    const int dimensions = voterModel ? voterModel->space().dimensions() : IdeologySpace::kMinDimensions;
+    if (horizontal < 0 || horizontal >= dimensions || vertical < 0 || vertical >= dimensions) {
+        horizontal = 0;
+        vertical = 1;
+    }
+    if (horizontal == m_horizontalAxis && vertical == m_verticalAxis) return;
+
+    m_horizontalAxis = horizontal;
+    m_verticalAxis = vertical;
+    m_densityCells.clear();     // the heatmap now counts a different pair of coordinates
+    clearSelection();
+    updateChart();
+}
+
+int VoterIdeologyChartWidget::horizontalAxis() const {
+    return m_horizontalAxis;
+}
+
+int VoterIdeologyChartWidget::verticalAxis() const {
+    return m_verticalAxis;
+}
+
+bool VoterIdeologyChartWidget::customAxes() const {
+    return m_horizontalAxis != 0 || m_verticalAxis != 1;
+}
+
+QPointF VoterIdeologyChartWidget::pointAt(int row) const {
+    return QPointF(voterModel->coordinate(row, m_horizontalAxis), voterModel->coordinate(row, m_verticalAxis));
+}
+
+void VoterIdeologyChartWidget::syncAxisChoices() {
+    const IdeologySpace& space = voterModel->space();
+    if (m_horizontalAxis >= space.dimensions() || m_verticalAxis >= space.dimensions()) {
+        // The space shrank under the chosen pair
+        m_horizontalAxis = 0;
+        m_verticalAxis = 1;
+        m_densityCells.clear();
+    }
+
+    axisBar->setVisible(space.dimensions() > IdeologySpace::kMinDimensions);
+    for (QComboBox* box : { horizontalAxisBox, verticalAxisBox }) {
+        QStringList items;
+        for (int i = 0; i < box->count(); ++i)
+            items.append(box->itemText(i));
+        if (items == space.axisNames()) continue;
+        const QSignalBlocker blocker(box);
+        box->clear();
+        box->addItems(space.axisNames());
+    }
+    {
+        const QSignalBlocker horizontalBlocker(horizontalAxisBox);
+        const QSignalBlocker verticalBlocker(verticalAxisBox);
+        horizontalAxisBox->setCurrentIndex(m_horizontalAxis);
+        verticalAxisBox->setCurrentIndex(m_verticalAxis);
+    }
+
+    axisX->setTitleText(customAxes() ? space.axisName(m_horizontalAxis) : kDefaultXTitle);
+    axisY->setTitleText(customAxes() ? space.axisName(m_verticalAxis) : kDefaultYTitle);
+}
+
+void VoterIdeologyChartWidget::scheduleRebuild() {
+    if (m_rebuildPending) return;
+    // A custom pair has no incremental path, so a batch of signals shares one full update
+    m_rebuildPending = true;
+    QTimer::singleShot(0, this, [this] {
+        m_rebuildPending = false;
+        updateChart();
+    });
+}
+
 void VoterIdeologyChartWidget::setVoterModel(VoterModel* model) {
+    if (voterModel) disconnect(voterModel, nullptr, this, nullptr);
     voterModel = model;
+    m_densityCells.clear();
+    if (voterModel) {
+        connect(voterModel, &VoterModel::voterInserted, this, &VoterIdeologyChartWidget::onVoterInserted);
+        connect(voterModel, &VoterModel::voterChanged, this, &VoterIdeologyChartWidget::onVoterChanged);
+        connect(voterModel, &VoterModel::voterRemoved, this, &VoterIdeologyChartWidget::onVoterRemoved);
+        connect(voterModel, &VoterModel::votersChanged, this, &VoterIdeologyChartWidget::onVotersChanged);
+        connect(voterModel, &VoterModel::votersReset, this, &VoterIdeologyChartWidget::updateChart);
+    }
+    updateChart();
+}
+
+void VoterIdeologyChartWidget::setHeatmapThreshold(int voters) {
+    m_heatmapThreshold = std::max(0, voters);
     updateChart();
 }
 
+int VoterIdeologyChartWidget::heatmapThreshold() const {
+    return m_heatmapThreshold;
+}
+
+void VoterIdeologyChartWidget::reportMemory(MemoryReport& report, const QString& prefix) const {
+    const QList<QPointF> seriesPoints = series->points();
+    if (seriesPoints.constData() != m_points.constData())
+        report.add(prefix + ".series", MemoryReport::vectorBytes(seriesPoints), seriesPoints.size());
+    report.add(prefix + ".point_buffer", MemoryReport::vectorBytes(m_points), m_points.size());
+    report.add(prefix + ".point_ids", MemoryReport::vectorBytes(m_pointVoterIds) + MemoryReport::hashBytes(m_pointIndexById),
+               m_pointVoterIds.size());
+    report.add(prefix + ".density", m_density.memoryBytes() + MemoryReport::stdVectorBytes(m_densityCells));
+    report.add(prefix + ".heatmap", m_heatmap.sizeInBytes());
+}
+
+bool VoterIdeologyChartWidget::isHeatmapActive() const {
+    return m_heatmapActive;
+}
+
 void VoterIdeologyChartWidget::updateChart() {
+    ProfileScope profile("chart/VoterIdeologyChartWidget::updateChart");
+    TRACE_SCOPE("chart", "VoterIdeologyChartWidget::updateChart");
+    MetricsRegistry::instance().increment("chart.VoterIdeologyChartWidget::updateChart");
     if (!voterModel) return;
+    syncAxisChoices();
+
+    const bool heatmap = heatmapWanted();
+    if (heatmap != m_heatmapActive) {
+        m_heatmapActive = heatmap;
+        series->setVisible(!heatmap);
+        chart->setPlotAreaBackgroundVisible(heatmap);
+        if (heatmap) {
+            m_points.clear();
+            m_pointVoterIds.clear();
+            m_pointIndexById.clear();
+            series->clear();
+            m_heatmap = QImage();   // the view may have changed while markers were shown
+        }
+    }
+
+    if (heatmap)
+        updateHeatmap();
+    else
+        rebuildPoints();
+}
+
+bool VoterIdeologyChartWidget::heatmapWanted() const {
+    return voterModel && voterModel->totalVoters() > m_heatmapThreshold;
+}
+
+void VoterIdeologyChartWidget::rebuildPoints() {
+    const QVector<Voter>& voters = voterModel->getAllVoters();
+    m_points.clear();
+    m_pointVoterIds.clear();
+    m_pointIndexById.clear();
+    m_points.reserve(voters.size());
+    m_pointVoterIds.reserve(voters.size());
+    m_pointIndexById.reserve(voters.size());
+    for (int row = 0; row < voters.size(); ++row) {
+        m_pointIndexById.insert(voters[row].id, m_points.size());
+        m_points.append(pointAt(row));
+        m_pointVoterIds.append(voters[row].id);
+    }
+    series->replace(m_points);     // one repaint instead of one per appended point
+}
+
+void VoterIdeologyChartWidget::onVoterInserted(const Voter& voter) {
+    if (customAxes()) {
+        scheduleRebuild();
+        return;
+    }
+    if (heatmapWanted() != m_heatmapActive) {
+        updateChart();
+        return;
+    }
+    if (m_heatmapActive) {
+        addDensity(voter.ideologyX, voter.ideologyY, 1);
+        flushDensity();
+        return;
+    }
+    m_pointIndexById.insert(voter.id, m_points.size());
+    m_points.append(QPointF(voter.ideologyX, voter.ideologyY));
+    m_pointVoterIds.append(voter.id);
+    series->append(m_points.last());
+}
+
+void VoterIdeologyChartWidget::onVoterChanged(const Voter& before, const Voter& after) {
+    if (customAxes()) {
+        scheduleRebuild();
+        return;
+    }
+    if (m_heatmapActive) {
+        if (before.ideologyX == after.ideologyX && before.ideologyY == after.ideologyY) return;
+        addDensity(before.ideologyX, before.ideologyY, -1);
+        addDensity(after.ideologyX, after.ideologyY, 1);
+        flushDensity();
+        return;
+    }
+    const int index = m_pointIndexById.value(after.id, -1);
+    if (index == -1) return;
+    const QPointF point(after.ideologyX, after.ideologyY);
+    if (m_points[index] == point) return;
+    m_points[index] = point;
+    series->replace(index, point);
+}
+
+void VoterIdeologyChartWidget::onVoterRemoved(const Voter& voter) {
+    if (customAxes()) {
+        scheduleRebuild();
+        return;
+    }
+    if (heatmapWanted() != m_heatmapActive) {
+        updateChart();
+        return;
+    }
+    if (m_heatmapActive) {
+        addDensity(voter.ideologyX, voter.ideologyY, -1);
+        flushDensity();
+        return;
+    }
+    const int index = m_pointIndexById.value(voter.id, -1);
+    if (index == -1) return;
+    m_pointIndexById.remove(voter.id);
+
+    // Move the last point into the gap so removal stays O(1)
+    const int last = m_points.size() - 1;
+    if (index != last) {
+        m_points[index] = m_points[last];
+        m_pointVoterIds[index] = m_pointVoterIds[last];
+        m_pointIndexById.insert(m_pointVoterIds[index], index);
+        series->replace(index, m_points[index]);
+    }
+    m_points.removeLast();
+    m_pointVoterIds.removeLast();
+    series->remove(last);
+}
+
+void VoterIdeologyChartWidget::onVotersChanged(const QVector<Voter>& before, const QVector<Voter>& after) {
+    if (customAxes()) {
+        scheduleRebuild();
+        return;
+    }
+    if (m_heatmapActive) {
+        for (int i = 0; i < after.size(); ++i) {
+            if (before[i].ideologyX == after[i].ideologyX && before[i].ideologyY == after[i].ideologyY) continue;
+            addDensity(before[i].ideologyX, before[i].ideologyY, -1);
+            addDensity(after[i].ideologyX, after[i].ideologyY, 1);
+        }
+        flushDensity();
+        return;
+    }
+
+    // Large batches are cheaper to push as one bulk replace than as many single-point signals
+    const bool bulk = after.size() > m_points.size() / 8;
+    for (const Voter& v : after) {
+        const int index = m_pointIndexById.value(v.id, -1);
+        if (index == -1) continue;
+        m_points[index] = QPointF(v.ideologyX, v.ideologyY);
+        if (!bulk) series->replace(index, m_points[index]);
+    }
+    if (bulk) series->replace(m_points);
+}
+
+void VoterIdeologyChartWidget::updateHeatmap() {
+    // The model's histogram covers the first two axes; other pairs are counted here
+    VoterHistogram pair;
+    if (customAxes()) {
+        for (int row = 0; row < voterModel->totalVoters(); ++row)
+            pair.add(voterModel->coordinate(row, m_horizontalAxis), voterModel->coordinate(row, m_verticalAxis));
+    }
+    const VoterHistogram& histogram = customAxes() ? pair : voterModel->histogram();
+    const std::vector<int>& cells = histogram.cells();
+
+    if (m_densityCells.empty() || m_heatmap.isNull()) {
+        m_density.rebuild(histogram);
+        m_densityCells = cells;
+        renderHeatmap();
+        return;
+    }
+
+    // Diff against the cells the quadtree reflects; cost depends on the grid, not the population
+    for (int c = 0; c < VoterHistogram::kCellCount; ++c) {
+        const int delta = cells[c] - m_densityCells[c];
+        if (delta != 0) addDensity(VoterHistogram::cellX(c), VoterHistogram::cellY(c), delta);
+    }
+    flushDensity();
+}
+
+void VoterIdeologyChartWidget::addDensity(int x, int y, int delta) {
+    if (m_densityCells.empty()) return;     // not synced yet; the next full update rebuilds everything
+    m_densityCells[VoterHistogram::cellIndex(x, y)] += delta;
+    m_density.add(x, y, delta);
+    if (m_density.countAt(m_heatmapLevel, x, y) > m_heatmapScaleMax) m_scaleExceeded = true;
+    m_dirtyCells |= QRect(x, y, 1, 1);
+}
+
+void VoterIdeologyChartWidget::flushDensity() {
+    if (m_dirtyCells.isEmpty() || m_heatmap.isNull()) return;
+    if (m_scaleExceeded) {
+        renderHeatmap();
+    } else {
+        renderHeatmapPixels(pixelsForCells(m_dirtyCells.left(), m_dirtyCells.top(), m_dirtyCells.right(), m_dirtyCells.bottom()));
+        applyHeatmapBrush();
+    }
+    m_dirtyCells = QRect();
+    m_scaleExceeded = false;
+}
+
+void VoterIdeologyChartWidget::scheduleHeatmapRender() {
+    if (!m_heatmapActive || m_renderPending) return;
+    // Both axes change during one zoom, so coalesce into a single repaint
+    m_renderPending = true;
+    QTimer::singleShot(0, this, [this] {
+        m_renderPending = false;
+        if (m_heatmapActive) renderHeatmap();
+    });
+}
+
+void VoterIdeologyChartWidget::renderHeatmap() {
+    const QSize size = chart->plotArea().size().toSize();
+    if (size.isEmpty()) return;
+    if (m_heatmap.size() != size)
+        m_heatmap = QImage(size, QImage::Format_ARGB32);
+
+    const double unitsPerPixel = std::max((axisX->max() - axisX->min()) / size.width(),
+                                          (axisY->max() - axisY->min()) / size.height());
+    m_heatmapLevel = DensityQuadtree::levelForScale(unitsPerPixel);
+
+    // Normalise the colours against the densest node at this level
+    m_heatmapScaleMax = 1;
+    const int side = DensityQuadtree::levelSide(m_heatmapLevel);
+    for (int y = 0; y < side; ++y)
+        for (int x = 0; x < side; ++x)
+            m_heatmapScaleMax = std::max(m_heatmapScaleMax, m_density.count(m_heatmapLevel, x, y));
+
+    renderHeatmapPixels(m_heatmap.rect());
+    applyHeatmapBrush();
+    m_dirtyCells = QRect();
+    m_scaleExceeded = false;
+}
+
+void VoterIdeologyChartWidget::renderHeatmapPixels(const QRect& pixels) {
+    const QRect area = pixels.intersected(m_heatmap.rect());
+    if (area.isEmpty()) return;
+
+    const double xMin = axisX->min();
+    const double yMax = axisY->max();
+    const double unitsX = (axisX->max() - xMin) / m_heatmap.width();
+    const double unitsY = (yMax - axisY->min()) / m_heatmap.height();
+    const double logMax = std::log1p(double(m_heatmapScaleMax));
+
+    // Compass column of every pixel in the area, computed once
+    std::vector<int> columns(area.width());
+    for (int px = area.left(); px <= area.right(); ++px)
+        columns[px - area.left()] = int(std::lround(xMin + (px + 0.5) * unitsX));
+
+    for (int py = area.top(); py <= area.bottom(); ++py) {
+        const int y = int(std::lround(yMax - (py + 0.5) * unitsY));
+        QRgb* line = reinterpret_cast<QRgb*>(m_heatmap.scanLine(py));
+        for (int px = area.left(); px <= area.right(); ++px) {
+            const int count = m_density.countAt(m_heatmapLevel, columns[px - area.left()], y);
+            if (count <= 0) {
+                line[px] = qRgba(0, 0, 0, 0);
+                continue;
+            }
+            const double t = std::min(1.0, std::log1p(double(count)) / logMax);
+            line[px] = m_palette[int(t * (kPaletteSize - 1))];
+        }
+    }
+}
+
+QRect VoterIdeologyChartWidget::pixelsForCells(int x0, int y0, int x1, int y1) const {
+    // Widen to whole quadtree nodes, since every pixel of a node shows the node's count
+    const int block = 1 << m_heatmapLevel;
+    const int offset = VoterHistogram::kMinCoordinate;
+    x0 = ((x0 - offset) / block) * block + offset;
+    y0 = ((y0 - offset) / block) * block + offset;
+    x1 = ((x1 - offset) / block + 1) * block + offset - 1;
+    y1 = ((y1 - offset) / block + 1) * block + offset - 1;
+
+    const double unitsX = (axisX->max() - axisX->min()) / m_heatmap.width();
+    const double unitsY = (axisY->max() - axisY->min()) / m_heatmap.height();
+    const int left = int(std::floor((x0 - 0.5 - axisX->min()) / unitsX)) - 1;
+    const int right = int(std::ceil((x1 + 0.5 - axisX->min()) / unitsX)) + 1;
+    const int top = int(std::floor((axisY->max() - (y1 + 0.5)) / unitsY)) - 1;
+    const int bottom = int(std::ceil((axisY->max() - (y0 - 0.5)) / unitsY)) + 1;
+    return QRect(QPoint(left, top), QPoint(right, bottom));
+}
+
+void VoterIdeologyChartWidget::applyHeatmapBrush() {
+    // Brush textures are anchored at the scene origin, so shift the image onto the plot area
+    QBrush brush(m_heatmap);
+    brush.setTransform(QTransform::fromTranslate(chart->plotArea().left(), chart->plotArea().top()));
+    chart->setPlotAreaBackgroundBrush(brush);
+    chart->setPlotAreaBackgroundVisible(true);
+}
+
+bool VoterIdeologyChartWidget::eventFilter(QObject* watched, QEvent* event) {
+    if (watched != chartView->viewport()) return QWidget::eventFilter(watched, event);
+
+    switch (event->type()) {
+    case QEvent::Wheel: {
+        // Leave the wheel to the surrounding layout until there is something to zoom
+        if (!m_heatmapActive && !chart->isZoomed()) break;
+        const auto* wheel = static_cast<QWheelEvent*>(event);
+        chart->zoom(wheel->angleDelta().y() > 0 ? 1.25 : 0.8);
+        return true;
+    }
+    case QEvent::MouseButtonPress: {
+        const auto* mouse = static_cast<QMouseEvent*>(event);
+        if (mouse->button() == Qt::LeftButton && (mouse->modifiers() & (Qt::ShiftModifier | Qt::ControlModifier))) {
+            m_selecting = true;
+            m_lasso = mouse->modifiers() & Qt::ControlModifier;
+            m_selection = { valueAt(mouse->position().toPoint()) };
+            updateSelectionOutline();
+            return true;
+        }
+        if (mouse->button() != Qt::MiddleButton) break;
+        m_panning = true;
+        m_panOrigin = mouse->position().toPoint();
+        return true;
+    }
+    case QEvent::MouseMove: {
+        const auto* mouse = static_cast<QMouseEvent*>(event);
+        if (m_selecting) {
+            const QPointF value = valueAt(mouse->position().toPoint());
+            if (m_lasso) {
+                m_selection.append(value);
+            } else {
+                const QPointF origin = m_selection.first();
+                m_selection = { origin, QPointF(value.x(), origin.y()), value, QPointF(origin.x(), value.y()) };
+            }
+            updateSelectionOutline();
+            return true;
+        }
+        if (!m_panning) break;
+        const QPoint delta = mouse->position().toPoint() - m_panOrigin;
+        m_panOrigin = mouse->position().toPoint();
+        chart->scroll(-delta.x(), delta.y());
+        return true;
+    }
+    case QEvent::MouseButtonRelease: {
+        const auto* mouse = static_cast<QMouseEvent*>(event);
+        if (mouse->button() == Qt::LeftButton && m_selecting) {
+            m_selecting = false;
+            finishSelection();
+            return true;
+        }
+        if (mouse->button() != Qt::MiddleButton) break;
+        m_panning = false;
+        return true;
+    }
+    default:
+        break;
+    }
+    return QWidget::eventFilter(watched, event);
+}
+
+void VoterIdeologyChartWidget::clearSelection() {
+    m_selection.clear();
+    m_selecting = false;
+    updateSelectionOutline();
+}
+
+QPointF VoterIdeologyChartWidget::valueAt(const QPoint& viewportPos) const {
+    return chart->mapToValue(chart->mapFromScene(chartView->mapToScene(viewportPos)), series);
+}
+
+void VoterIdeologyChartWidget::updateSelectionOutline() {
+    QPainterPath path;
+    if (!m_selection.isEmpty()) {
+        path.moveTo(chart->mapToPosition(m_selection.first(), series));
+        for (int i = 1; i < m_selection.size(); ++i)
+            path.lineTo(chart->mapToPosition(m_selection[i], series));
+        path.closeSubpath();
+    }
+    m_selectionOutline->setPath(path);
+}
+
+void VoterIdeologyChartWidget::finishSelection() {
+    if (!voterModel || m_selection.isEmpty()) return;
 
-    series->clear();
-    for (int i = 0; i < voterModel->rowCount(); ++i) {
-        const Voter& v = voterModel->getVoterAt(i);
-        series->append(v.ideologyX, v.ideologyY);
+    QVector<int> ids;
+    if (customAxes()) {
+        // The spatial index only covers the first two axes, so scan the voters on the chosen pair
+        const QPolygonF polygon(m_selection);
+        const QRectF bounds = polygon.boundingRect();
+        for (int row = 0; row < voterModel->totalVoters(); ++row) {
+            const QPointF point = pointAt(row);
+            const bool inside = m_lasso ? polygon.containsPoint(point, Qt::OddEvenFill)
+                                        : point.x() >= bounds.left() && point.x() <= bounds.right()
+                                              && point.y() >= bounds.top() && point.y() <= bounds.bottom();
+            if (inside) ids.append(voterModel->getVoterIdAt(row));
+        }
+    } else if (m_lasso) {
+        ids = voterModel->spatialIndex().inPolygon(m_selection);
+    } else if (m_selection.size() == 4) {
+        // Only whole compass points inside the dragged rectangle count
+        const QPointF a = m_selection[0];
+        const QPointF b = m_selection[2];
+        const int x0 = static_cast<int>(std::ceil(std::min(a.x(), b.x())));
+        const int y0 = static_cast<int>(std::ceil(std::min(a.y(), b.y())));
+        const int x1 = static_cast<int>(std::floor(std::max(a.x(), b.x())));
+        const int y1 = static_cast<int>(std::floor(std::max(a.y(), b.y())));
+        if (x0 <= x1 && y0 <= y1) ids = voterModel->spatialIndex().inRectangle(x0, y0, x1, y1);
     }
+    emit votersSelected(ids);
 }
@@ -2,17 +2,49 @@
 #define VOTERIDEOLOGYCHARTWIDGET_H
 
 #include <QWidget>
+#include <QGraphicsPathItem>
+#include <QHash>
+#include <QImage>
+#include <QPoint>
+#include <QRect>
 #include <QtCharts/QChartView>
 #include <QtCharts/QScatterSeries>
 #include <QtCharts/QValueAxis>
 #include "models/VoterModel.h"
+#include "simulation/DensityQuadtree.h"
+class QComboBox;
+class MemoryReport;
+
+#include <vector>
 
 /**
  * @brief Widget for displaying all voters on an ideology scatter plot.
+ *
+ * @details Above heatmapThreshold() voters the scatter markers are replaced by a density heatmap. The heatmap is rasterised
+ * into a cached image that is shown as the plot area background. Each pixel reads one node of a DensityQuadtree at the level
+ * matching the current zoom. After a data change only the pixels covering changed compass cells are repainted.
+ *
+ * Below the threshold the widget keeps a point buffer indexed by voter ID and patches single points from VoterModel's typed
+ * change signals, so one edit costs O(1); full rebuilds go through a single QScatterSeries::replace().
+ *
+ * Drag with the left button to zoom into a rectangle, drag with the middle button to pan and right-click to zoom back out. The
+ * wheel zooms around the centre once the chart is zoomed in or shows the heatmap; otherwise it scrolls the surrounding layout. Shift-drag selects the voters in a rectangle and Ctrl-drag draws a lasso; both are answered
+ * by VoterModel::spatialIndex() one compass cell at a time.
+ *
+ * When the ideology space has more than two axes, two combo boxes above the chart choose the pair of axes it projects onto.
+ * The default pair (economic, social) uses the incremental paths above; any other pair rebuilds the points or the heatmap from
+ * VoterModel::coordinate() once per batch of changes, and selections scan the voters instead of the spatial index.
  */
 class VoterIdeologyChartWidget : public QWidget {
     Q_OBJECT
 
+signals:
+    /**
+     * @brief Emitted when a rectangle or lasso selection is finished.
+     * @param voterIds IDs of every voter inside the selection (empty if none).
+     */
+    void votersSelected(const QVector<int>& voterIds);
+
 public:
     /**
      * @brief Constructs a VoterIdeologyChartWidget.
@@ -26,24 +58,118 @@ public:
      * @brief Assigns a VoterModel to this widget.
      * @param model Pointer to the VoterModel providing voter data.
      *
-     * Connects the model's signals to update the chart when data changes.
+     * Connects the model's typed change signals so the chart patches only the affected points.
      */
     void setVoterModel(VoterModel* model);
 
     /**
-     * @brief Updates the scatter plot to reflect the current voter data.
+     * @brief Updates the plot to reflect the current voter data.
      *
-     * Re-populates the chart series using all voters from the model.
+     * Rebuilds the point buffer with one bulk replace, or syncs the density heatmap when the voter count is above the threshold.
      */
     void updateChart();
 
+    /**
+     * @brief Sets the voter count above which the density heatmap replaces individual markers.
+     * @param voters Threshold; 0 always shows the heatmap.
+     */
+    void setHeatmapThreshold(int voters);
+
+    /** @brief Returns the voter count above which the density heatmap is shown. */
+    int heatmapThreshold() const;
+
+    /** @brief Returns true while the density heatmap is shown instead of markers. */
+    bool isHeatmapActive() const;
+
+    /**
+     * @brief Chooses the axes of the ideology space the chart shows.
+     * @param horizontal Axis plotted left to right.
+     * @param vertical Axis plotted bottom to top.
+     *
+     * Out-of-range axes fall back to the default pair (0, 1).
+     */
+    void setAxes(int horizontal, int vertical);
+
+    /** @brief Returns the axis plotted left to right. */
+    int horizontalAxis() const;
+
+    /** @brief Returns the axis plotted bottom to top. */
+    int verticalAxis() const;
+
+    /** @brief Hides the outline of the last rectangle or lasso selection. */
+    void clearSelection();
+
+    /**
+     * @brief Adds the memory held by the chart to a report.
+     * @param report Report to add to.
+     * @param prefix Name prefix, e.g. "charts.voterChart".
+     *
+     * Covers the series points, the point buffer and its lookups, the density quadtree and the cached heatmap image. The point
+     * buffer is counted once while the series still shares it.
+     */
+    void reportMemory(MemoryReport& report, const QString& prefix) const;
+
+protected:
+    /** @brief Handles wheel zoom, middle-button panning and selections on the chart view. */
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
 private:
+    void onVoterInserted(const Voter& voter);                               ///< Adds one point or one heatmap count.
+    void onVoterChanged(const Voter& before, const Voter& after);           ///< Moves one point or heatmap count.
+    void onVoterRemoved(const Voter& voter);                                ///< Removes one point or heatmap count.
+    void onVotersChanged(const QVector<Voter>& before, const QVector<Voter>& after); ///< Applies a batch move.
+    bool heatmapWanted() const;                     ///< True if the population is above the heatmap threshold.
+    bool customAxes() const;                        ///< True if the chart shows a pair other than the first two axes.
+    QPointF pointAt(int row) const;                 ///< Chart position of the voter at a model row on the chosen axes.
+    void syncAxisChoices();                         ///< Refills the axis combo boxes from the model's space and applies the titles.
+    void scheduleRebuild();                         ///< Queues one full update for a batch of changes on a custom axis pair.
+    void rebuildPoints();                           ///< Refills the point buffer from the model and pushes it with one replace().
+    void addDensity(int x, int y, int delta);       ///< Patches the quadtree and widens the pending dirty cell area.
+    void flushDensity();                            ///< Repaints the pixels of the pending dirty cells.
+    void updateHeatmap();                           ///< Syncs the quadtree with the histogram and repaints changed pixels.
+    void scheduleHeatmapRender();                   ///< Queues a full repaint after zoom, pan or resize.
+    void renderHeatmap();                           ///< Repaints the whole cached image for the current view.
+    void renderHeatmapPixels(const QRect& pixels);  ///< Repaints part of the cached image.
+    QRect pixelsForCells(int x0, int y0, int x1, int y1) const;    ///< Image pixels covering a block of compass cells.
+    void applyHeatmapBrush();                       ///< Shows the cached image behind the plot area.
+    QPointF valueAt(const QPoint& viewportPos) const;   ///< Compass coordinates under a viewport position.
+    void updateSelectionOutline();                  ///< Redraws the selection outline for the current zoom.
+    void finishSelection();                         ///< Queries the voters inside the selection and emits votersSelected().
+
     QChart* chart;               ///< Chart object for plotting voter ideologies.
     QChartView* chartView;         ///< View widget for the scatter chart.
     QScatterSeries* series;         ///< Scatter series representing all voter points.
     QValueAxis* axisX;             ///< X-axis (economic axis) of the chart.
     QValueAxis* axisY;             ///< Y-axis (social axis) of the chart.
     VoterModel* voterModel;         ///< VoterModel providing data for the chart.
+    QWidget* axisBar;               ///< Row holding the axis choices (hidden for a two-axis space).
+    QComboBox* horizontalAxisBox;   ///< Choice of the horizontal axis.
+    QComboBox* verticalAxisBox;     ///< Choice of the vertical axis.
+
+    int m_horizontalAxis = 0;               ///< Axis plotted left to right.
+    int m_verticalAxis = 1;                 ///< Axis plotted bottom to top.
+    bool m_rebuildPending = false;          ///< True while a full update for a custom axis pair is queued.
+
+    int m_heatmapThreshold = 20000;         ///< Voter count above which the heatmap is shown.
+    bool m_heatmapActive = false;           ///< True while the heatmap replaces the scatter markers.
+    bool m_renderPending = false;           ///< True while a full heatmap repaint is queued.
+    DensityQuadtree m_density;              ///< Pre-aggregated counts the heatmap reads from.
+    std::vector<int> m_densityCells;        ///< Histogram cells the quadtree currently reflects (empty if never synced).
+    QImage m_heatmap;                       ///< Cached heatmap, one pixel per plot area pixel.
+    int m_heatmapLevel = 0;                 ///< Quadtree level the cached image was rendered from.
+    int m_heatmapScaleMax = 1;              ///< Node count mapped to the densest colour.
+    QVector<QRgb> m_palette;                ///< Colour ramp from sparse to dense.
+    QRect m_dirtyCells;                     ///< Compass cells changed since the last repaint (empty if none).
+    bool m_scaleExceeded = false;           ///< True if a pending change made a node denser than the colour scale.
+    QList<QPointF> m_points;                ///< Scatter points, in series order.
+    QVector<int> m_pointVoterIds;           ///< Voter ID of every point, parallel to m_points.
+    QHash<int, int> m_pointIndexById;       ///< Point index of every voter ID.
+    QPoint m_panOrigin;                     ///< Last mouse position while panning.
+    bool m_panning = false;                 ///< True while the middle button is held.
+    QGraphicsPathItem* m_selectionOutline;  ///< Outline of the current selection (owned by the chart).
+    QVector<QPointF> m_selection;           ///< Selection polygon in compass coordinates (empty if none).
+    bool m_selecting = false;               ///< True while a selection is being dragged.
+    bool m_lasso = false;                   ///< True if the current selection is a lasso rather than a rectangle.
 };
 
 #endif // VOTERIDEOLOGYCHARTWIDGET_H
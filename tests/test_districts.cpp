@@ -0,0 +1,91 @@
+#include <catch2/catch_test_macros.hpp>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+
+#include "models/IdeologyModel.h"
+#include "models/PartyModel.h"
+#include "models/VoterModel.h"
+#include "simulation/DistrictTally.h"
+#include "simulation/SeatAllocation.h"
+
+#include "utilities/ScopedFileRemover.h"
+
+TEST_CASE("Seat allocation methods", "[districts]") {
+    const QVector<int> votes = { 100000, 80000, 30000, 20000, 10000 };
+
+    REQUIRE(SeatAllocator::allocate(votes, 8, SeatMethod::DHondt) == QVector<int>({ 4, 3, 1, 0, 0 }));
+    REQUIRE(SeatAllocator::allocate(votes, 8, SeatMethod::SainteLague) == QVector<int>({ 3, 3, 1, 1, 0 }));
+    REQUIRE(SeatAllocator::allocate(votes, 8, SeatMethod::LargestRemainder) == QVector<int>({ 3, 3, 1, 1, 0 }));
+    REQUIRE(SeatAllocator::allocate(votes, 8, SeatMethod::FirstPastThePost) == QVector<int>({ 8, 0, 0, 0, 0 }));
+    REQUIRE(SeatAllocator::allocate(QVector<int>({ 0, 0 }), 3, SeatMethod::DHondt) == QVector<int>({ 0, 0 }));
+}
+
+TEST_CASE("District tally counts every district in one pass", "[districts]") {
+    QVector<Party> parties = {
+        Party{ 1, "Alpha", -1, "", 0, 0 },
+        Party{ 7, "Beta",  -1, "", 0, 0 },
+    };
+
+    QVector<Voter> voters;
+    for (int i = 0; i < 100000; ++i) {
+        Voter v;
+        v.districtId = i % 1000;
+        v.partyId = (i % 3 == 0) ? 7 : 1;
+        voters.append(v);
+    }
+    Voter unassigned;
+    unassigned.partyId = 1;
+    voters.append(unassigned);
+
+    DistrictTally tally(voters, parties, 1000);
+    REQUIRE(tally.districtCount() == 1000);
+    REQUIRE(tally.districtTotal(0) == 100);
+    REQUIRE(tally.nationalVotes().value(1) == 66666);
+    REQUIRE(tally.nationalVotes().value(7) == 33334);
+
+    QMap<int, int> seats = SeatAllocator::parliament(tally, 3, SeatMethod::DHondt);
+    REQUIRE(seats.value(1) == 2000);
+    REQUIRE(seats.value(7) == 1000);
+}
+
+TEST_CASE("VoterModel persists district assignment", "[districts]") {
+    const QString connName = "test_district_connection";
+    const QString dbPath = "test_districts.sqlite";
+    ScopedFileRemover cleanup(dbPath);
+
+    {
+        PartyModel partyModel(connName, nullptr, false, dbPath);
+        IdeologyModel ideologyModel(connName);     // reloadData joins the ideologies table
+        VoterModel voterModel(connName, nullptr, dbPath);
+        for (int i = 0; i < 20; ++i)
+            voterModel.addVoter(Voter(-1, QString("V%1").arg(i), "", -1, -1, "", i, -i));
+        voterModel.reloadData();
+
+        voterModel.assignDistricts(4);
+        REQUIRE(voterModel.districtCount() == 4);
+        for (const Voter& v : voterModel.getAllVoters())
+            REQUIRE(v.districtId == VoterModel::districtForVoter(v.id, 4));
+
+        voterModel.addVoter(Voter(-1, "Late", "", -1, -1, "", 0, 0));
+        int districtSignals = 0;
+        QObject::connect(&voterModel, &VoterModel::districtsChanged, [&]() { ++districtSignals; });
+        voterModel.reloadData();
+        REQUIRE(voterModel.getAllVoters().last().districtId >= 0);
+        REQUIRE(districtSignals == 0);      // same districts as before
+    }
+
+    VoterModel reloaded(connName, nullptr, dbPath);
+    REQUIRE(reloaded.districtCount() == 4);
+    REQUIRE(reloaded.getAllVoters().size() == 21);
+
+    // Clearing the districts outside the model is announced by the next reload
+    int districtSignals = 0;
+    QObject::connect(&reloaded, &VoterModel::districtsChanged, [&]() { ++districtSignals; });
+    QSqlQuery clear(QSqlDatabase::database(connName));
+    REQUIRE(clear.exec("DELETE FROM districts"));
+    reloaded.reloadData();
+    REQUIRE(reloaded.districtCount() == 0);
+    REQUIRE(districtSignals == 1);
+
+    QSqlDatabase::database(connName).close();
+}
@@ -0,0 +1,89 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "models/PartyModel.h"
+#include "models/Voter.h"
+#include "simulation/ElectoralSystems.h"
+
+namespace {
+
+// Three parties on the X axis; centre voters break ties towards the earlier party (Alpha).
+QVector<Party> lineParties() {
+    return {
+        Party{ 1, "Alpha", -1, "", 0, 0 },
+        Party{ 2, "Beta",  -1, "", 10, 0 },
+        Party{ 3, "Gamma", -1, "", 20, 0 },
+    };
+}
+
+QVector<Voter> lineVoters() {
+    QVector<Voter> voters;
+    auto add = [&](int x, int count) {
+        for (int i = 0; i < count; ++i)
+            voters.append(Voter(-1, "", "", -1, -1, "", x, 0));
+    };
+    add(0, 4);      // Alpha supporters
+    add(10, 3);     // Beta supporters
+    add(20, 5);     // Gamma supporters
+    return voters;
+}
+
+}
+
+TEST_CASE("Ballots are ranked by distance", "[electoral]") {
+    RankedBallots ballots(lineVoters(), lineParties());
+
+    REQUIRE(ballots.ballotCount() == 12);
+    REQUIRE(ballots.depth() == 3);
+    REQUIRE(ballots.preferenceAt(0, 0) == 1);
+    REQUIRE(ballots.preferenceAt(0, 1) == 2);
+    REQUIRE(ballots.preferenceAt(0, 2) == 3);
+    REQUIRE(ballots.preferenceAt(4, 0) == 2);
+    REQUIRE(ballots.preferenceAt(4, 1) == 1);   // tie broken by party order
+    REQUIRE(ballots.preferenceAt(12, 0) == -1);
+}
+
+TEST_CASE("Electoral systems disagree on the same electorate", "[electoral]") {
+    RankedBallots ballots(lineVoters(), lineParties());
+
+    SECTION("First past the post elects the largest bloc") {
+        ElectionTally t = ballots.plurality();
+        REQUIRE(t.winnerId == 3);
+        REQUIRE(t.scores.value(1) == Catch::Approx(4.0));
+    }
+
+    SECTION("Instant runoff transfers the eliminated party's ballots") {
+        ElectionTally t = ballots.instantRunoff();
+        REQUIRE(t.rounds.size() == 2);
+        REQUIRE_FALSE(t.rounds.last().contains(2));
+        REQUIRE(t.winnerId == 1);
+        REQUIRE(t.scores.value(1) == Catch::Approx(7.0));
+    }
+
+    SECTION("Borda and Condorcet favour the centre") {
+        ElectionTally borda = ballots.borda();
+        REQUIRE(borda.winnerId == 2);
+        REQUIRE(borda.scores.value(1) == Catch::Approx(11.0));
+        REQUIRE(borda.scores.value(2) == Catch::Approx(15.0));
+
+        ElectionTally condorcet = ballots.condorcet();
+        REQUIRE(condorcet.winnerId == 2);
+        REQUIRE(condorcet.scores.value(2) == Catch::Approx(2.0));
+    }
+
+    SECTION("Approval counts every party within the threshold") {
+        ElectionTally t = ballots.approval(10.0);
+        REQUIRE(t.scores.value(1) == Catch::Approx(7.0));
+        REQUIRE(t.scores.value(2) == Catch::Approx(12.0));
+        REQUIRE(t.scores.value(3) == Catch::Approx(8.0));
+    }
+}
+
+TEST_CASE("Truncated ballots exhaust in instant runoff", "[electoral]") {
+    RankedBallots ballots(lineVoters(), lineParties(), 1);
+
+    REQUIRE(ballots.depth() == 1);
+    ElectionTally t = ballots.instantRunoff();
+    REQUIRE(t.winnerId == 3);
+    REQUIRE(ballots.condorcet().winnerId == 3);
+}
@@ -0,0 +1,207 @@
+#include <catch2/catch_test_macros.hpp>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+
+#include "models/IdeologyModel.h"
+#include "models/IdeologySpace.h"
+#include "models/PartyModel.h"
+#include "models/VoterModel.h"
+#include "simulation/DistanceKernels.h"
+
+#include "utilities/ScopedFileRemover.h"
+
+#include <random>
+
+TEST_CASE("Distance kernels agree with a linear scan for every number of axes", "[ideology-space]") {
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> coordinate(-100, 100);
+
+    for (int dimensions = 1; dimensions <= IdeologySpace::kMaxDimensions; ++dimensions) {
+        for (int count : { 0, 1, 15, 16, 17, 100 }) {
+            IdeologyPoints points(dimensions);
+            std::vector<std::vector<int>> raw;
+            for (int i = 0; i < count; ++i) {
+                std::vector<int> position(dimensions);
+                // Coarse coordinates make ties common, so the tie-break is exercised too
+                for (int& c : position) c = coordinate(random) / 25 * 25;
+                points.append(position.data());
+                raw.push_back(position);
+            }
+
+            for (int query = 0; query < 20; ++query) {
+                std::vector<int> point(dimensions);
+                for (int& c : point) c = coordinate(random);
+
+                int expected = -1;
+                int expectedDistance = 0;
+                for (int i = 0; i < count; ++i) {
+                    int distance = 0;
+                    for (int a = 0; a < dimensions; ++a)
+                        distance += (raw[i][a] - point[a]) * (raw[i][a] - point[a]);
+                    if (expected == -1 || distance < expectedDistance) {
+                        expected = i;
+                        expectedDistance = distance;
+                    }
+                }
+
+                const NearestPoint nearest = DistanceKernels::nearest(points, point.data(), dimensions);
+                REQUIRE(nearest.index == expected);
+                if (expected != -1) REQUIRE(nearest.distanceSquared == expectedDistance);
+            }
+        }
+    }
+    REQUIRE(DistanceKernels::specialized(4));
+    REQUIRE_FALSE(DistanceKernels::specialized(5));
+}
+
+TEST_CASE("Packed points stay aligned through removals", "[ideology-space]") {
+    IdeologyPoints points(3);
+    for (int i = 0; i < 40; ++i) {
+        const int position[3] = { i, -i, 300 };
+        points.append(position);
+    }
+    REQUIRE(points.coordinate(5, 2) == IdeologyPoints::kMaxCoordinate);    // clamped
+
+    points.swapRemove(5);
+    REQUIRE(points.size() == 39);
+    REQUIRE(points.coordinate(5, 0) == 39);
+    REQUIRE(points.coordinate(5, 1) == -39);
+
+    std::vector<bool> keep(points.size());
+    for (int i = 0; i < points.size(); ++i) keep[i] = points.coordinate(i, 0) % 2 == 0;
+    points.keepRows(keep);
+    REQUIRE(points.size() == 20);
+    for (int i = 0; i < points.size(); ++i) REQUIRE(points.coordinate(i, 0) % 2 == 0);
+}
+
+TEST_CASE("Voters and parties are matched on every axis of the space", "[ideology-space]") {
+    const QString connName = "test_ideology_space_connection";
+    const QString dbPath = "test_ideology_space.sqlite";
+    ScopedFileRemover cleanup(dbPath);
+
+    {
+        PartyModel partyModel(connName, nullptr, false, dbPath);
+        IdeologyModel ideologyModel(connName);
+        VoterModel voterModel(connName, nullptr, dbPath);
+        voterModel.setPartyModel(&partyModel);
+        voterModel.setIdeologyModel(&ideologyModel);
+        partyModel.setVoterModel(&voterModel);
+        partyModel.setIdeologyModel(&ideologyModel);
+        REQUIRE(voterModel.space().dimensions() == 2);
+
+        QSqlDatabase db = QSqlDatabase::database(connName);
+        REQUIRE(IdeologySpace::save(db, IdeologySpace::standard(4)));
+        const IdeologySpace space = IdeologySpace::load(db);
+        REQUIRE(space.dimensions() == 4);
+        REQUIRE(space.axisName(3) == "Environmental");
+
+        QSqlQuery columns(db);
+        REQUIRE(columns.exec("PRAGMA table_info(voters)"));
+        QStringList names;
+        while (columns.next()) names.append(columns.value(1).toString());
+        REQUIRE(names.contains("axis_2"));
+        REQUIRE(names.contains("axis_3"));
+
+        ideologyModel.loadData();
+        partyModel.addParty(Party{ -1, "Doves", 1, "", 0, 0 });
+        partyModel.addParty(Party{ -1, "Hawks", 1, "", 0, 0 });
+        partyModel.reloadData();
+        const int doves = partyModel.getPartyIdAt(0);
+        const int hawks = partyModel.getPartyIdAt(1);
+
+        // Same economic and social position; only the foreign-policy axis tells them apart
+        partyModel.setPartyPosition(doves, { 0, 0, -80, 0 });
+        partyModel.setPartyPosition(hawks, { 0, 0, 80, 0 });
+        partyModel.reloadData();
+        REQUIRE(partyModel.space().dimensions() == 4);
+        REQUIRE(partyModel.positions().coordinate(1, 2) == 80);
+
+        voterModel.reloadData();
+        voterModel.addVoter(Voter(-1, "Ann", "", -1, -1, "", 0, 0));
+        voterModel.addVoter(Voter(-1, "Bob", "", -1, -1, "", 5, 5));
+        voterModel.addVoter(Voter(-1, "Cid", "", -1, -1, "", 9, 9));
+        const int ann = voterModel.getVoterIdAt(0);
+        const int cid = voterModel.getVoterIdAt(2);
+
+        voterModel.setVoterPosition(ann, { 0, 0, 70, 0 });
+        REQUIRE(voterModel.getVoterAt(voterModel.rowOfVoter(ann)).partyId == hawks);
+        voterModel.setVoterPosition(cid, { 9, 9, -60, 20 });
+        REQUIRE(voterModel.getVoterAt(voterModel.rowOfVoter(cid)).partyId == doves);
+
+        // Deleting the first row moves Cid's extra coordinates along with the row
+        voterModel.deleteVoterById(ann);
+        REQUIRE(voterModel.coordinate(voterModel.rowOfVoter(cid), 2) == -60);
+        REQUIRE(voterModel.coordinate(voterModel.rowOfVoter(cid), 3) == 20);
+
+        // Reassigning all voters keeps using every axis
+        voterModel.reassignAllVoterParties();
+        REQUIRE(voterModel.getVoterAt(voterModel.rowOfVoter(cid)).partyId == doves);
+
+        // The extra axes are stored, in both loading modes
+        voterModel.reloadData();
+        REQUIRE(voterModel.coordinate(voterModel.rowOfVoter(cid), 2) == -60);
+        voterModel.setLazyNames(true);
+        int position[IdeologySpace::kMaxDimensions];
+        REQUIRE(voterModel.positionAt(voterModel.rowOfVoter(cid), position) == 4);
+        REQUIRE(position[0] == 9);
+        REQUIRE(position[2] == -60);
+        REQUIRE(position[3] == 20);
+
+        // Ideologies have no extra coordinates yet, so the N-D search matches the 2D one
+        const int point[4] = { -80, 40, 50, -50 };
+        REQUIRE(ideologyModel.findClosestIdeologyId(point, 4) == ideologyModel.findClosestIdeologyId(-80, 40));
+
+        // Added and edited voters are matched on every axis too, whatever party the record names
+        partyModel.addParty(Party{ -1, "Greens", 1, "", 40, 0 });
+        partyModel.reloadData();
+        const int greens = partyModel.getPartyIdAt(2);
+
+        voterModel.addVoter(Voter(-1, "Dee", "", -1, hawks, "", 10, 0));
+        const int dee = voterModel.getVoterIdAt(voterModel.rowCount() - 1);
+        // On the first two axes alone Doves would be nearest, but a new voter sits at 0 on the foreign axis
+        REQUIRE(voterModel.getVoterAt(voterModel.rowOfVoter(dee)).partyId == greens);
+        const int deePosition[4] = { 10, 0, 0, 0 };
+        REQUIRE(voterModel.getVoterAt(voterModel.rowOfVoter(dee)).ideologyId == ideologyModel.findClosestIdeologyId(deePosition, 4));
+
+        // Cid keeps -60 on the foreign axis, so the same first two coordinates mean Doves
+        voterModel.updateVoter(cid, Voter(-1, "Cid", "", -1, hawks, "", 10, 0));
+        REQUIRE(voterModel.getVoterAt(voterModel.rowOfVoter(cid)).partyId == doves);
+        REQUIRE(voterModel.coordinate(voterModel.rowOfVoter(cid), 2) == -60);
+
+        // Moving a party on the first two axes keeps its extra axes in the ideology search
+        const QVector<Ideology>& ideologies = ideologyModel.getIdeologies();
+        REQUIRE(ideologies.size() >= 2);
+        const Ideology target = ideologies[0];
+        Ideology neighbour = ideologies[1];
+        auto distance = [&target](const Ideology& i) {
+            return (i.centerX - target.centerX) * (i.centerX - target.centerX) + (i.centerY - target.centerY) * (i.centerY - target.centerY);
+        };
+        for (const Ideology& i : ideologies) {
+            if (i.id != target.id && distance(i) < distance(neighbour)) neighbour = i;
+        }
+        QSqlQuery axes(db);
+        REQUIRE(axes.exec("UPDATE ideologies SET axis_2 = -100"));
+        REQUIRE(axes.exec(QString("UPDATE ideologies SET axis_2 = 100 WHERE id = %1").arg(target.id)));
+        ideologyModel.loadData();
+
+        Party moved = partyModel.getPartyAt(1);     // Hawks, at 80 on the foreign axis
+        moved.ideologyX = neighbour.centerX;
+        moved.ideologyY = neighbour.centerY;
+        partyModel.updatePartyPositions({ moved });
+        partyModel.reloadData();
+        REQUIRE(partyModel.getPartyAt(1).ideologyId == target.id);
+
+        // Adding and editing a party match on every axis too, whatever ideology the dialog picked on the first two
+        partyModel.addParty(Party{ -1, "Owls", target.id, "", neighbour.centerX, neighbour.centerY });
+        partyModel.reloadData();
+        REQUIRE(partyModel.getPartyAt(3).name == "Owls");
+        REQUIRE(partyModel.getPartyAt(3).ideologyId == neighbour.id);     // 0 on the foreign axis
+
+        partyModel.updateParty(hawks, Party{ hawks, "Hawks", neighbour.id, "", neighbour.centerX, neighbour.centerY });
+        partyModel.reloadData();
+        REQUIRE(partyModel.getPartyAt(1).ideologyId == target.id);        // keeps 80 on the foreign axis
+        REQUIRE(partyModel.positions().coordinate(1, 2) == 80);
+    }
+
+    QSqlDatabase::database(connName).close();
+}
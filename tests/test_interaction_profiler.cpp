@@ -0,0 +1,77 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "diagnostics/InteractionProfiler.h"
+#include "utilities/ScopedFileRemover.h"
+
+#include <QFile>
+#include <QJsonDocument>
+
+TEST_CASE("Interaction profiler summarises series by percentile", "[profiler]") {
+    InteractionProfiler& profiler = InteractionProfiler::instance();
+    profiler.clear();
+    profiler.setEnabled(true);
+
+    for (int i = 1; i <= 100; ++i)
+        profiler.record("chart/test", double(i));
+
+    const LatencySummary s = profiler.summary("chart/test");
+    REQUIRE(s.count == 100);
+    REQUIRE(s.p50 == 50.0);
+    REQUIRE(s.p95 == 95.0);
+    REQUIRE(s.p99 == 99.0);
+    REQUIRE(s.max == 100.0);
+    REQUIRE(profiler.summary("chart/unknown").count == 0);
+
+    // Only the latest samples are kept
+    for (int i = 0; i < InteractionProfiler::kMaxSamples; ++i)
+        profiler.record("chart/test", 1.0);
+    REQUIRE(profiler.summary("chart/test").count == InteractionProfiler::kMaxSamples);
+    REQUIRE(profiler.summary("chart/test").max == 1.0);
+
+    profiler.setEnabled(false);
+    profiler.record("chart/disabled", 1.0);
+    REQUIRE_FALSE(profiler.seriesNames().contains("chart/disabled"));
+    profiler.clear();
+}
+
+TEST_CASE("Profile scopes record only while profiling is enabled", "[profiler]") {
+    InteractionProfiler& profiler = InteractionProfiler::instance();
+    profiler.clear();
+
+    { ProfileScope scope("model/off"); }
+    REQUIRE(profiler.seriesNames().isEmpty());
+
+    profiler.setEnabled(true);
+    { ProfileScope scope("model/on"); }
+    { ProfileScope scope("model/on"); }
+    REQUIRE(profiler.seriesNames() == QStringList{ "model/on" });
+    REQUIRE(profiler.summary("model/on").count == 2);
+    REQUIRE(profiler.summary("model/on").max >= 0.0);
+
+    profiler.setEnabled(false);
+    profiler.clear();
+}
+
+TEST_CASE("Interaction profiler exports summaries as JSON", "[profiler]") {
+    InteractionProfiler& profiler = InteractionProfiler::instance();
+    profiler.clear();
+    profiler.setEnabled(true);
+    profiler.record("frame/voterTableView", 4.0);
+    profiler.record("frame/voterTableView", 8.0);
+    profiler.record("model/VoterModel::reloadData", 12.5);
+
+    const QString path = "test_profile.json";
+    ScopedFileRemover remover(path);
+    REQUIRE(profiler.exportJson(path));
+
+    QFile file(path);
+    REQUIRE(file.open(QIODevice::ReadOnly));
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    REQUIRE(root.keys() == QStringList{ "frame/voterTableView", "model/VoterModel::reloadData" });
+    REQUIRE(root["frame/voterTableView"].toObject()["count"].toInt() == 2);
+    REQUIRE(root["frame/voterTableView"].toObject()["p99_ms"].toDouble() == 8.0);
+    REQUIRE(root["model/VoterModel::reloadData"].toObject()["p50_ms"].toDouble() == 12.5);
+
+    profiler.setEnabled(false);
+    profiler.clear();
+}
@@ -0,0 +1,112 @@
+#include <catch2/catch_test_macros.hpp>
+#include <QSqlDatabase>
+
+#include "diagnostics/MetricsRegistry.h"
+#include "models/IdeologyModel.h"
+#include "models/PartyModel.h"
+#include "models/VoterModel.h"
+
+#include "utilities/ScopedFileRemover.h"
+
+#include <thread>
+
+TEST_CASE("Lazy names are fetched a page at a time and match the eager ones", "[lazy-names]") {
+    const QString connName = "test_lazy_names_connection";
+    const QString dbPath = "test_lazy_names.sqlite";
+    ScopedFileRemover cleanup(dbPath);
+
+    {
+        PartyModel partyModel(connName, nullptr, false, dbPath);
+        IdeologyModel ideologyModel(connName);
+        VoterModel model(connName, nullptr, dbPath);
+        model.setPartyModel(&partyModel);
+        model.setIdeologyModel(&ideologyModel);
+        partyModel.setVoterModel(&model);
+
+        partyModel.addParty(Party{ -1, "Centre", 1, "", 0, 0 });
+        partyModel.reloadData();
+        const int centre = partyModel.getPartyIdAt(0);
+        const int count = VoterModel::kNamePageRows * 3;
+        for (int i = 0; i < count; ++i)
+            model.addVoter(Voter(-1, QString("Voter %1").arg(i), "", 1, centre, "", i % 50, -i % 50));
+
+        QStringList eager[3];
+        for (int row = 0; row < count; ++row) {
+            for (int column = 0; column < 3; ++column)
+                eager[column].append(model.data(model.index(row, column)).toString());
+        }
+
+        model.setLazyNames(true);
+        REQUIRE(model.lazyNames());
+        REQUIRE(model.rowCount() == count);
+        for (const Voter& v : model.getAllVoters()) {
+            REQUIRE(v.name.isEmpty());
+            REQUIRE(v.partyName.isEmpty());
+        }
+
+        MetricsRegistry::instance().reset();
+        for (int row = 0; row < count; ++row) {
+            for (int column = 0; column < 3; ++column)
+                REQUIRE(model.data(model.index(row, column)).toString() == eager[column][row]);
+        }
+        // One query per page of rows, not per row
+        REQUIRE(MetricsRegistry::instance().counter("model.VoterModel.name_pages_loaded") == 3);
+        REQUIRE(model.voterName(1) == "Voter 1");
+        REQUIRE(MetricsRegistry::instance().counter("model.VoterModel.name_pages_loaded") == 3);
+
+        const Voter full = model.getVoterAt(2);
+        REQUIRE(full.name == "Voter 2");
+        REQUIRE(full.partyName == "Centre");
+
+        const QHash<int, Voter> exported = model.votersWithNames({ model.getVoterIdAt(5), model.getVoterIdAt(count - 1), 999999 });
+        REQUIRE(exported.size() == 2);
+        REQUIRE(exported.value(model.getVoterIdAt(count - 1)).name == QString("Voter %1").arg(count - 1));
+        MetricsRegistry::instance().reset();
+
+        // Off the model's thread, names come from a connection of their own, a page of IDs at a time
+        QVector<int> ids;
+        for (int row = 0; row < count; ++row) ids.append(model.getVoterIdAt(row));
+        for (int i = 0; i < 1000; ++i) ids.append(1000000 + i);    // not stored; also spreads the IDs over several pages
+        QHash<int, QString> names;
+        std::thread([&]() { names = VoterModel::readNames(connName, ids); }).join();
+        REQUIRE(names.size() == count);
+        REQUIRE(names.value(model.getVoterIdAt(count - 1)) == QString("Voter %1").arg(count - 1));
+    }
+
+    QSqlDatabase::database(connName).close();
+}
+
+TEST_CASE("Edits in lazy mode refresh the cached names", "[lazy-names]") {
+    const QString connName = "test_lazy_names_edit_connection";
+    const QString dbPath = "test_lazy_names_edit.sqlite";
+    ScopedFileRemover cleanup(dbPath);
+
+    {
+        PartyModel partyModel(connName, nullptr, false, dbPath);
+        IdeologyModel ideologyModel(connName);
+        VoterModel model(connName, nullptr, dbPath);
+        model.setLazyNames(true);
+
+        model.addVoter(Voter(-1, "Ann", "", -1, -1, "", 1, 1));
+        model.addVoter(Voter(-1, "Bob", "", -1, -1, "", 2, 2));
+        model.addVoter(Voter(-1, "Cid", "", -1, -1, "", 3, 3));
+        REQUIRE(model.voterName(0) == "Ann");
+        REQUIRE(model.getAllVoters().at(0).name.isEmpty());
+
+        model.updateVoter(model.getVoterIdAt(1), Voter(-1, "Bea", "", -1, -1, "", 2, 2));
+        REQUIRE(model.voterName(1) == "Bea");
+        REQUIRE(model.getAllVoters().at(1).name.isEmpty());
+
+        // Deleting the first row moves the last one into its place
+        const int cid = model.getVoterIdAt(2);
+        model.deleteVoterById(model.getVoterIdAt(0));
+        REQUIRE(model.rowCount() == 2);
+        REQUIRE(model.voterName(0) == "Cid");
+        REQUIRE(model.voterName(1) == "Bea");
+
+        model.setLazyNames(false);
+        REQUIRE(model.getAllVoters().at(model.rowOfVoter(cid)).name == "Cid");
+    }
+
+    QSqlDatabase::database(connName).close();
+}
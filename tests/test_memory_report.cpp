@@ -0,0 +1,84 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "diagnostics/MemoryReport.h"
+#include "diagnostics/MemorySampler.h"
+#include "simulation/VoterSpatialIndex.h"
+
+#include <QJsonArray>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+
+TEST_CASE("Memory report sums entries and counts shared strings once", "[memory]") {
+    MemoryReport report;
+    report.add("voters.records", 1000, 10);
+    report.add("voters.names", 200, 10);
+    report.add("voters.names", 50, 2);
+    report.add("parties.records", 64, 1);
+
+    REQUIRE(report.entries().size() == 3);
+    REQUIRE(report.bytes("voters.names") == 250);
+    REQUIRE(report.bytes("voters") == 1250);
+    REQUIRE(report.bytes("ideologies") == 0);
+    REQUIRE(report.totalBytes() == 1314);
+    REQUIRE(report.toJson()["entries"].toObject()["voters.names"].toObject()["items"].toInt() == 12);
+    REQUIRE(report.toText().contains("voters:"));
+
+    REQUIRE(report.stringBytes(QString()) == 0);
+    const QString name = QString("Liberal Democrats").repeated(4);
+    const qint64 alone = report.stringBytes(name);
+    REQUIRE(alone >= MemoryReport::kArrayHeaderBytes + name.size() * qint64(sizeof(QChar)));
+    REQUIRE(report.stringBytes(name) == alone);     // a buffer owned alone is counted each time it is reported
+    {
+        // Three holders of one buffer add up to a single payload
+        const QString copy1 = name;
+        const QString copy2 = name;
+        MemoryReport shared;
+        REQUIRE(shared.stringBytes(name) + shared.stringBytes(copy1) + shared.stringBytes(copy2) == alone);
+        REQUIRE(shared.stringBytes(copy1) == 0);
+    }
+
+    QVector<int> ids;
+    REQUIRE(MemoryReport::vectorBytes(ids) == 0);
+    ids.reserve(100);
+    REQUIRE(MemoryReport::vectorBytes(ids) >= 100 * qint64(sizeof(int)));
+
+    VoterSpatialIndex index;
+    const qint64 empty = index.memoryBytes();
+    for (int id = 1; id <= 1000; ++id)
+        index.insert(id, id % 201 - 100, id % 101 - 50);
+    REQUIRE(index.memoryBytes() > empty + 1000 * qint64(sizeof(int)));
+}
+
+TEST_CASE("Memory sampler collects every source and measures the SQLite cache", "[memory]") {
+    MemorySampler sampler;
+    sampler.addSource([](MemoryReport& r) { r.add("a.one", 10); });
+    sampler.addSource([](MemoryReport& r) { r.add("b.two", 20); });
+    REQUIRE(sampler.collect().totalBytes() == 30);
+    REQUIRE_FALSE(sampler.isSampling());
+
+    sampler.start(60000);
+    REQUIRE(sampler.isSampling());
+    REQUIRE(sampler.samples().size() == 1);     // the first sample is taken immediately
+    sampler.stop();
+    REQUIRE(sampler.toJson()["samples"].toArray().size() == 1);
+
+    const QString connName = "test_memory_report";
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
+        db.setDatabaseName(":memory:");
+        REQUIRE(db.open());
+        QSqlQuery query(db);
+        REQUIRE(query.exec("CREATE TABLE items (id INTEGER PRIMARY KEY, name TEXT)"));
+
+        // The cache bound never exceeds the database itself
+        const qint64 cache = MemoryReport::sqliteCacheBytes(db);
+        REQUIRE(query.exec("PRAGMA page_count"));
+        REQUIRE(query.next());
+        const qint64 pages = query.value(0).toLongLong();
+        REQUIRE(query.exec("PRAGMA page_size"));
+        REQUIRE(query.next());
+        REQUIRE(cache > 0);
+        REQUIRE(cache <= pages * query.value(0).toLongLong());
+    }
+    QSqlDatabase::removeDatabase(connName);
+}
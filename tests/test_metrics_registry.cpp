@@ -0,0 +1,84 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "diagnostics/MetricsRegistry.h"
+#include "diagnostics/MeteredQuery.h"
+
+#include <QSqlDatabase>
+
+TEST_CASE("Metrics registry keeps counters and bucketed histograms", "[metrics]") {
+    MetricsRegistry& metrics = MetricsRegistry::instance();
+    metrics.reset();
+
+    metrics.increment("test.count");
+    metrics.increment("test.count", 4);
+    REQUIRE(metrics.counter("test.count") == 5);
+    REQUIRE(metrics.counter("test.unknown") == 0);
+
+    REQUIRE(MetricsRegistry::bucketOf(0.5) == 0);
+    REQUIRE(MetricsRegistry::bucketOf(1.0) == 1);
+    REQUIRE(MetricsRegistry::bucketOf(3.0) == 2);
+    REQUIRE(MetricsRegistry::bucketOf(4.0) == 3);
+
+    for (int i = 1; i <= 100; ++i)
+        metrics.observe("test.latency", i);
+    const HistogramSnapshot h = metrics.histogram("test.latency");
+    REQUIRE(h.count == 100);
+    REQUIRE(h.min == 1.0);
+    REQUIRE(h.max == 100.0);
+    REQUIRE(h.mean() == 50.5);
+    REQUIRE(h.percentile(0.5) == 64.0);     // 50th value lies in [32, 64)
+    REQUIRE(h.percentile(0.99) == 100.0);   // capped at the maximum
+
+    REQUIRE(metrics.counterNames() == QStringList{ "test.count" });
+    REQUIRE(metrics.toJson()["histograms"].toObject()["test.latency"].toObject()["count"].toInt() == 100);
+
+    metrics.reset();
+    REQUIRE(metrics.counterNames().isEmpty());
+    REQUIRE(metrics.histogramNames().isEmpty());
+}
+
+TEST_CASE("Metered queries count statements and rows", "[metrics]") {
+    MetricsRegistry& metrics = MetricsRegistry::instance();
+    metrics.reset();
+    MeteredQuery::setEnabled(true);
+
+    const QString connName = "test_metered_query";
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
+        db.setDatabaseName(":memory:");
+        REQUIRE(db.open());
+
+        MeteredQuery query(db, "Test");
+        REQUIRE(query.exec("CREATE TABLE items (id INTEGER PRIMARY KEY, name TEXT)"));
+        REQUIRE(query.exec("INSERT INTO items (name) VALUES ('a'), ('b'), ('c')"));
+        REQUIRE(query.exec("SELECT id FROM items"));
+        int rows = 0;
+        while (query.next()) ++rows;
+        REQUIRE(rows == 3);
+        REQUIRE_FALSE(query.exec("SELECT * FROM missing"));
+    }
+    QSqlDatabase::removeDatabase(connName);
+
+    REQUIRE(metrics.counter("sql.Test.statements") == 4);
+    REQUIRE(metrics.counter("sql.statements") == 4);
+    REQUIRE(metrics.counter("sql.Test.errors") == 1);
+    REQUIRE(metrics.counter("sql.Test.rows_written") == 3);
+    REQUIRE(metrics.counter("sql.Test.rows_read") == 3);
+    REQUIRE(metrics.histogram("sql.Test.statement_us").count == 4);
+    metrics.reset();
+
+    // Switched off, statements leave the registry untouched
+    MeteredQuery::setEnabled(false);
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
+        db.setDatabaseName(":memory:");
+        REQUIRE(db.open());
+
+        MeteredQuery query(db, "Test");
+        REQUIRE(query.exec("SELECT 1"));
+        REQUIRE(query.next());
+    }
+    QSqlDatabase::removeDatabase(connName);
+    REQUIRE(metrics.counter("sql.statements") == 0);
+    REQUIRE(metrics.counter("sql.Test.rows_read") == 0);
+}
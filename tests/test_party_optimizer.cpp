@@ -0,0 +1,102 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "models/PartyModel.h"
+#include "models/Voter.h"
+#include "simulation/PartyOptimizer.h"
+#include "simulation/SharePreview.h"
+#include "simulation/VoterHistogram.h"
+
+namespace {
+
+// Two clusters: 30 voters around (40, 0) and 10 voters around (-60, 0)
+QVector<Voter> clusteredVoters() {
+    QVector<Voter> voters;
+    for (int i = 0; i < 30; ++i)
+        voters.append(Voter(-1, "", "", -1, -1, "", 40 + (i % 3) - 1, (i % 5) - 2));
+    for (int i = 0; i < 10; ++i)
+        voters.append(Voter(-1, "", "", -1, -1, "", -60, i - 5));
+    return voters;
+}
+
+}
+
+TEST_CASE("Voter histogram counts voters per integer cell", "[optimizer]") {
+    VoterHistogram histogram(clusteredVoters());
+
+    REQUIRE(histogram.total() == 40);
+    REQUIRE(histogram.count(-60, 0) == 1);
+    REQUIRE(histogram.count(500, 0) == 0);
+    REQUIRE(VoterHistogram::cellX(VoterHistogram::cellIndex(-60, 7)) == -60);
+    REQUIRE(VoterHistogram::cellY(VoterHistogram::cellIndex(-60, 7)) == 7);
+
+    histogram.add(150, 150);            // clamped onto the compass edge
+    REQUIRE(histogram.count(100, 100) == 1);
+}
+
+TEST_CASE("Party optimizer scores candidates against the histogram", "[optimizer]") {
+    VoterHistogram histogram(clusteredVoters());
+    QVector<Party> parties = {
+        Party{ 1, "Left",  -1, "", -60, 0 },
+        Party{ 2, "Right", -1, "", 90, 0 },
+    };
+    PartyOptimizer optimizer(histogram, parties);
+
+    REQUIRE(optimizer.evaluate(0, -60, 0) == 10);
+    REQUIRE(optimizer.evaluate(1, 90, 0) == 30);
+    REQUIRE(optimizer.evaluate(0, 40, 0) == 40);        // ties at equal distance go to the earlier party
+
+    SECTION("Hill climbing captures the larger cluster") {
+        OptimizerSettings settings;
+        settings.strategy = OptimizerSettings::Strategy::HillClimbing;
+        settings.initialStep = 64;
+        OptimizedPosition best = optimizer.optimize(0, settings);
+        REQUIRE(best.votes == 40);
+        REQUIRE(best.share == Catch::Approx(100.0));
+        REQUIRE(optimizer.parties()[0].ideologyX == best.x);
+    }
+
+    SECTION("Simulated annealing is reproducible") {
+        OptimizedPosition first = optimizer.optimize(1, OptimizerSettings());
+        PartyOptimizer again(histogram, parties);
+        OptimizedPosition second = again.optimize(1, OptimizerSettings());
+        REQUIRE(first.x == second.x);
+        REQUIRE(first.y == second.y);
+        REQUIRE(first.votes >= 30);
+    }
+}
+
+TEST_CASE("Share preview projects votes and switchers without reassigning voters", "[optimizer]") {
+    VoterHistogram histogram(clusteredVoters());
+    const QVector<Party> parties = {
+        Party{ 1, "Left",  -1, "", -60, 0 },
+        Party{ 2, "Right", -1, "", 90, 0 },
+    };
+
+    SECTION("Moving an existing party") {
+        SharePreview preview(histogram, parties, 1);
+        REQUIRE(preview.current().votes == QVector<int>{ 10, 30 });
+
+        const ShareProjection unchanged = preview.project(90, 0);
+        REQUIRE(unchanged.votes == preview.current().votes);
+        REQUIRE(unchanged.switched == 0);
+
+        const ShareProjection toLeft = preview.project(-60, 0);      // ties go to the earlier party
+        REQUIRE(toLeft.votes == QVector<int>{ 40, 0 });
+        REQUIRE(toLeft.switched == 30);
+        REQUIRE(toLeft.share(0) == Catch::Approx(100.0));
+    }
+
+    SECTION("Adding a new party") {
+        SharePreview preview(histogram, parties, -1);
+        REQUIRE(preview.partyIndex() == 2);
+        REQUIRE(preview.current().votes == QVector<int>{ 10, 30, 0 });
+
+        const ShareProjection projection = preview.project(-60, 0);  // a new party loses ties to existing ones
+        REQUIRE(projection.votes == QVector<int>{ 10, 30, 0 });
+
+        const ShareProjection centre = preview.project(40, 0);
+        REQUIRE(centre.votes[2] == 30);
+        REQUIRE(centre.switched == 30);
+    }
+}
@@ -78,3 +78,53 @@ TEST_CASE("Party popularity is derived from voters", "[derived-popularity]") {
 
     //QSqlDatabase::removeDatabase(connName);
 }
+
+TEST_CASE("Party tallies follow voter edits without rescanning", "[derived-popularity]") {
+    const QString connName = "test_tally_connection";
+    const QString dbPath = "test_tally.sqlite";
+    ScopedFileRemover cleanup(dbPath);
+
+    {
+        PartyModel partyModel(connName, nullptr, false, dbPath);
+        VoterModel voterModel(connName, nullptr, dbPath);
+        partyModel.setVoterModel(&voterModel);
+        voterModel.setPartyModel(&partyModel);
+
+        partyModel.addParty(Party{ -1, "West", -1, "", -50, 0 });
+        partyModel.addParty(Party{ -1, "East", -1, "", 50, 0 });
+        partyModel.reloadData();
+        const int west = partyModel.getPartyIdAt(0);
+        const int east = partyModel.getPartyIdAt(1);
+
+        for (int i = 0; i < 3; ++i)
+            voterModel.addVoter(Voter(-1, QString("W%1").arg(i), "", -1, west, "", -40, 0));
+        voterModel.addVoter(Voter(-1, "E", "", -1, east, "", 40, 0));
+        REQUIRE(voterModel.votersForParty(west) == 3);
+        REQUIRE(voterModel.votersForParty(east) == 1);
+
+        const int firstId = voterModel.getVoterIdAt(0);
+        voterModel.updateVoter(firstId, Voter(-1, "W0", "", -1, east, "", 40, 0));
+        REQUIRE(voterModel.votersForParty(west) == 2);
+        REQUIRE(voterModel.votersForParty(east) == 2);
+
+        // Drifting across the midline switches party
+        voterModel.moveVoters({ VoterMove{ voterModel.getVoterIdAt(1), 45, 0 } });
+        REQUIRE(voterModel.votersForParty(west) == 1);
+
+        voterModel.deleteVoterById(firstId);
+        REQUIRE(voterModel.countVotersPerParty() == QMap<int, int>({ { west, 1 }, { east, 2 } }));
+
+        const QMap<int, double> popularity = partyModel.popularitySnapshot();
+        REQUIRE(popularity.value(west) == Catch::Approx(100.0 / 3));
+        REQUIRE(popularity.value(east) == Catch::Approx(200.0 / 3));
+        REQUIRE(partyModel.calculatePopularity(east) == Catch::Approx(200.0 / 3));
+
+        QVector<double> shares;
+        partyModel.popularityShares(shares);
+        REQUIRE(shares.size() == 2);
+        REQUIRE(shares[0] == Catch::Approx(100.0 / 3));
+        REQUIRE(shares[1] == Catch::Approx(200.0 / 3));
+    }
+
+    QSqlDatabase::database(connName).close();
+}
@@ -0,0 +1,106 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "simulation/PopularityHistory.h"
+
+#include <algorithm>
+
+TEST_CASE("Popularity history keeps recent samples verbatim", "[history]") {
+    PopularityHistory history(16);
+    for (int i = 0; i < 10; ++i)
+        history.record({ { 1, double(i) }, { 2, 100.0 - i } });
+
+    REQUIRE(history.sampleCount() == 10);
+    REQUIRE(history.partyIds().size() == 2);
+
+    const QVector<ShareRange> columns = history.columns(1, 0, 9, 100);     // more columns than samples
+    REQUIRE(columns.size() == 10);
+    for (int i = 0; i < 10; ++i) {
+        REQUIRE(columns[i].sample == i);
+        REQUIRE(columns[i].min == float(i));
+        REQUIRE(columns[i].max == float(i));
+    }
+    REQUIRE(history.columns(3, 0, 9, 10).isEmpty());
+}
+
+TEST_CASE("Popularity history decimates long runs into min/max columns", "[history]") {
+    PopularityHistory history(256);
+    QVector<float> shares;
+    for (int i = 0; i < 100000; ++i) {
+        const double share = (i * 37) % 101;
+        shares.append(float(share));
+        history.record({ { 1, share } });
+    }
+
+    // The whole run stays available in fixed memory and draws in at most one column per pixel
+    REQUIRE(history.firstAvailableSample() == 0);
+    const QVector<ShareRange> columns = history.columns(1, 0, history.sampleCount() - 1, 500);
+    REQUIRE(columns.size() == 500);
+
+    // Every column must bracket the true samples it covers
+    for (int c = 0; c < columns.size(); ++c) {
+        const qint64 end = (c + 1 < columns.size()) ? columns[c + 1].sample : shares.size();
+        const auto first = shares.cbegin() + columns[c].sample;
+        const auto last = shares.cbegin() + end;
+        REQUIRE(columns[c].min <= *std::min_element(first, last));
+        REQUIRE(columns[c].max >= *std::max_element(first, last));
+    }
+
+    // Old samples have left the fine levels, so they are read back from coarse buckets
+    const QVector<ShareRange> old = history.columns(1, 0, 999, 1000);
+    REQUIRE(old.size() == 1000);
+    REQUIRE(old[0].max - old[0].min > 0.0f);
+}
+
+TEST_CASE("Parties that appear later or vanish are tracked from first sight", "[history]") {
+    PopularityHistory history;
+    history.record({ { 1, 100.0 } });
+    history.record({ { 1, 60.0 }, { 2, 40.0 } });
+    history.record({ { 2, 100.0 } });
+
+    const QVector<ShareRange> late = history.columns(2, 0, 2, 3);
+    REQUIRE(late.size() == 2);
+    REQUIRE(late[0].sample == 1);
+    REQUIRE(late[0].max == 40.0f);
+
+    const QVector<ShareRange> gone = history.columns(1, 0, 2, 3);
+    REQUIRE(gone.size() == 3);
+    REQUIRE(gone[2].max == 0.0f);
+}
+
+TEST_CASE("Deleted parties are dropped from the history", "[history]") {
+    PopularityHistory history;
+    for (int i = 0; i < 10; ++i)
+        history.record({ { 1, 50.0 }, { 2, 50.0 } });
+
+    history.retainParties({ 2 });
+    history.record({ { 2, 100.0 } });
+    REQUIRE(history.partyIds() == QList<int>({ 2 }));
+    REQUIRE(history.columns(1, 0, 10, 11).isEmpty());
+    REQUIRE(history.columns(2, 0, 10, 11).size() == 11);
+}
+
+TEST_CASE("Recording from a party list matches recording from a map", "[history]") {
+    PopularityHistory fromMap;
+    PopularityHistory fromList;
+    const QVector<int> ids = { 1, 2, 3 };
+    for (int i = 0; i < 40; ++i) {
+        const double share = i % 7 * 10.0;
+        fromMap.record({ { 1, share }, { 2, 100.0 - share } });
+        fromList.record(ids, { share, 100.0 - share, 0.0 });
+    }
+    // Party 3 never had voters, so neither history starts a series for it
+    REQUIRE(fromList.partyIds().size() == 2);
+    for (int party : { 1, 2 }) {
+        const QVector<ShareRange> expected = fromMap.columns(party, 0, 39, 40);
+        const QVector<ShareRange> actual = fromList.columns(party, 0, 39, 40);
+        REQUIRE(actual.size() == expected.size());
+        for (int c = 0; c < actual.size(); ++c) {
+            REQUIRE(actual[c].min == expected[c].min);
+            REQUIRE(actual[c].max == expected[c].max);
+        }
+    }
+
+    // Leaving a party out of the list drops its history
+    fromList.record({ 2 }, { 100.0 });
+    REQUIRE(fromList.partyIds() == QList<int>({ 2 }));
+}
@@ -0,0 +1,103 @@
+#include <catch2/catch_test_macros.hpp>
+#include <QSqlDatabase>
+
+#include "models/IdeologyModel.h"
+#include "models/IdeologySpace.h"
+#include "models/PartyModel.h"
+#include "models/VoterModel.h"
+
+#include "utilities/ScopedFileRemover.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Population snapshots are immutable copies", "[snapshot]") {
+    const QString connName = "test_snapshot_connection";
+    const QString dbPath = "test_snapshot.sqlite";
+    ScopedFileRemover cleanup(dbPath);
+
+    {
+        PartyModel partyModel(connName, nullptr, false, dbPath);
+        IdeologyModel ideologyModel(connName);
+        VoterModel model(connName, nullptr, dbPath);
+        REQUIRE(model.captureSnapshot()->size() == 0);
+
+        model.addVoter(Voter(-1, "A", "", -1, -1, "", 1, 2));
+        const PopulationSnapshot::Ptr first = model.captureSnapshot();
+        REQUIRE(first->size() == 1);
+        REQUIRE(first->votersForParty(-1) == 1);
+
+        // Edits do not reach a captured snapshot, only the next one
+        model.addVoter(Voter(-1, "B", "", -1, -1, "", 3, 4));
+        model.updateVoter(model.getVoterIdAt(0), Voter(-1, "A2", "", -1, -1, "", 5, 6));
+        REQUIRE(first->size() == 1);
+        REQUIRE(first->voters[0].name == "A");
+
+        const PopulationSnapshot::Ptr second = model.captureSnapshot();
+        REQUIRE(second->size() == 2);
+        REQUIRE(second->voters[0].name == "A2");
+        model.updateVoter(model.getVoterIdAt(1), Voter(-1, "B2", "", -1, -1, "", 7, 8));
+        REQUIRE(second->voters[1].name == "B");
+
+        // Snapshots carry every axis of the space, not just the first two
+        REQUIRE(IdeologySpace::save(QSqlDatabase::database(connName), IdeologySpace::standard(3)));
+        model.reloadData();
+        model.setVoterPosition(model.getVoterIdAt(0), { 5, 6, -30 });
+        const PopulationSnapshot::Ptr spatial = model.captureSnapshot();
+        REQUIRE(spatial->extraAxes.dimensions() == 1);
+        REQUIRE(spatial->coordinate(0, 0) == 5);
+        REQUIRE(spatial->coordinate(0, 2) == -30);
+        REQUIRE(spatial->coordinate(1, 2) == 0);
+    }
+
+    QSqlDatabase::database(connName).close();
+}
+
+TEST_CASE("Readers on other threads always see a consistent population", "[snapshot]") {
+    const QString connName = "test_snapshot_threads_connection";
+    const QString dbPath = "test_snapshot_threads.sqlite";
+    ScopedFileRemover cleanup(dbPath);
+
+    {
+        PartyModel partyModel(connName, nullptr, false, dbPath);
+        IdeologyModel ideologyModel(connName);
+        VoterModel model(connName, nullptr, dbPath);
+
+        // The GUI thread hands out a fresh snapshot every ten edits while readers keep using whichever one they hold
+        PopulationSnapshot::Ptr latest = model.captureSnapshot();
+        std::atomic<bool> done{ false };
+        std::atomic<int> inconsistent{ 0 };
+        std::atomic<int> reads{ 0 };
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 4; ++t) {
+            readers.emplace_back([&]() {
+                int lastSize = 0;
+                while (!done.load()) {
+                    const PopulationSnapshot::Ptr s = std::atomic_load(&latest);
+                    int counted = 0;
+                    for (auto it = s->partyCounts.cbegin(); it != s->partyCounts.cend(); ++it)
+                        counted += it.value();
+                    if (counted != s->size() || s->size() < lastSize) ++inconsistent;
+                    lastSize = s->size();
+                    ++reads;
+                }
+            });
+        }
+
+        for (int i = 0; i < 200; ++i) {
+            model.addVoter(Voter(-1, QString("V%1").arg(i), "", -1, -1, "", i % 100, -(i % 100)));
+            if (i % 10 == 9) std::atomic_store(&latest, model.captureSnapshot());
+        }
+        done = true;
+        for (std::thread& reader : readers)
+            reader.join();
+
+        REQUIRE(inconsistent == 0);
+        REQUIRE(reads > 0);
+        REQUIRE(std::atomic_load(&latest)->size() == 200);
+    }
+
+    QSqlDatabase::database(connName).close();
+}
@@ -0,0 +1,163 @@
+#include <catch2/catch_test_macros.hpp>
+#include <QSqlDatabase>
+
+#include "models/PartyModel.h"
+#include "models/VoterModel.h"
+#include "simulation/EventLog.h"
+#include "simulation/SimulationEngine.h"
+
+#include "utilities/ScopedFileRemover.h"
+
+namespace {
+
+Voter voterAt(int id, int x, int y) {
+    Voter v(id, "", "", -1, -1, "", x, y);
+    return v;
+}
+
+}
+
+TEST_CASE("Event log rebuilds any tick from the nearest checkpoint", "[events]") {
+    const QString logPath = "test_events.log";
+    ScopedFileRemover cleanup(logPath);
+
+    const QVector<Party> parties = {
+        Party{ 1, "Left",  -1, "", -50, 0 },
+        Party{ 2, "Right", -1, "", 50, 0 },
+    };
+
+    {
+        EventLog log(logPath, 2);
+        REQUIRE(log.isOpen());
+        REQUIRE(log.isEmpty());
+
+        log.recordCheckpoint(parties, { voterAt(1, -40, 0), voterAt(2, 40, 0), voterAt(3, 30, 0) });
+
+        // Tick 1: voter 3 crosses over to the left
+        log.beginTick(1);
+        log.recordVotersMoved({ voterAt(3, -10, 0) });
+        REQUIRE_FALSE(log.checkpointDue());
+
+        // Tick 2: a new voter joins and the right party moves onto them
+        log.beginTick(2);
+        log.recordVoterChanged(voterAt(4, 90, 90));
+        log.recordPartyChanged(Party{ 2, "Right", -1, "", 90, 90 });
+        REQUIRE(log.checkpointDue());
+
+        // Tick 3: the left party is dissolved
+        log.beginTick(3);
+        log.recordPartyRemoved(1);
+    }
+
+    EventLog log(logPath, 2);
+    REQUIRE(log.currentTick() == 3);
+
+    SimulationState initial = log.stateAt(0);
+    REQUIRE(initial.voters.size() == 3);
+    REQUIRE(initial.tally() == QMap<int, int>({ { 1, 1 }, { 2, 2 } }));
+
+    SimulationState second = log.stateAt(2);
+    REQUIRE(second.voters.size() == 4);
+    REQUIRE(second.voters[2].ideologyX == -10);
+    REQUIRE(second.parties[1].ideologyX == 90);
+    REQUIRE(second.tally() == QMap<int, int>({ { 1, 3 }, { 2, 1 } }));
+
+    REQUIRE(log.stateAt(3).tally() == QMap<int, int>({ { 2, 4 } }));
+
+    QVector<QMap<int, int>> history = log.popularityHistory(0, 4);
+    REQUIRE(history.size() == 5);
+    REQUIRE(history[0] == QMap<int, int>({ { 1, 1 }, { 2, 2 } }));
+    REQUIRE(history[1] == QMap<int, int>({ { 1, 2 }, { 2, 1 } }));
+    REQUIRE(history[2] == second.tally());
+    REQUIRE(history[4] == history[3]);
+}
+
+TEST_CASE("Simulation ticks are logged and replayable", "[events]") {
+    const QString connName = "test_simulation_connection";
+    const QString dbPath = "test_simulation.sqlite";
+    const QString logPath = "test_simulation.log";
+    ScopedFileRemover cleanupDb(dbPath);
+    ScopedFileRemover cleanupLog(logPath);
+
+    {
+        PartyModel partyModel(connName, nullptr, false, dbPath);
+        VoterModel voterModel(connName, nullptr, dbPath);
+        partyModel.setVoterModel(&voterModel);
+        voterModel.setPartyModel(&partyModel);
+
+        EventLog log(logPath, 3);
+        partyModel.setEventLog(&log);
+        voterModel.setEventLog(&log);
+
+        partyModel.addParty(Party{ -1, "Centre", 1, "", 0, 0 });
+        partyModel.reloadData();
+        for (int i = 0; i < 10; ++i)
+            voterModel.addVoter(Voter(-1, QString("V%1").arg(i), "", -1, partyModel.getPartyIdAt(0), "", 10 + i, -10));
+
+        SimulationEngine engine(&voterModel, &partyModel, &log);
+        DriftSettings settings;
+        settings.attraction = 1.0;
+        settings.noise = 0.0;
+        engine.setSettings(settings);
+        engine.step(5);
+        REQUIRE(engine.currentTick() == 5);
+
+        // Everyone steps one unit diagonally towards the party per tick
+        REQUIRE(voterModel.getVoterAt(0).ideologyX == 5);
+        REQUIRE(voterModel.getVoterAt(0).ideologyY == -5);
+
+        SimulationState now = log.stateAt(5);
+        REQUIRE(now.voters.size() == 10);
+        for (const Voter& v : now.voters) {
+            const int row = v.id - 1;
+            REQUIRE(v.ideologyX == voterModel.getVoterAt(row).ideologyX);
+            REQUIRE(v.ideologyY == voterModel.getVoterAt(row).ideologyY);
+        }
+
+        SimulationState start = log.stateAt(0);
+        REQUIRE(start.voters.size() == 10);
+        REQUIRE(start.voters[0].ideologyX == 10);
+        REQUIRE(log.stateAt(2).voters[0].ideologyX == 8);
+    }
+
+    QSqlDatabase::removeDatabase(connName);
+}
+
+TEST_CASE("Databases in one directory keep separate event logs", "[events]") {
+    const QString pathA = "test_events_a.sqlite";
+    const QString pathB = "test_events_b.sqlite";
+    ScopedFileRemover cleanupDbA(pathA);
+    ScopedFileRemover cleanupDbB(pathB);
+    ScopedFileRemover cleanupLogA(EventLog::pathForDatabase(pathA));
+    ScopedFileRemover cleanupLogB(EventLog::pathForDatabase(pathB));
+
+    REQUIRE(EventLog::pathForDatabase(pathA) != EventLog::pathForDatabase(pathB));
+
+    {
+        VoterModel votersA("test_events_a_connection", nullptr, pathA);
+        VoterModel votersB("test_events_b_connection", nullptr, pathB);
+        EventLog logA(EventLog::pathForDatabase(pathA));
+        EventLog logB(EventLog::pathForDatabase(pathB));
+        votersA.setEventLog(&logA);
+        votersB.setEventLog(&logB);
+
+        logA.recordCheckpoint({}, {});
+        logB.recordCheckpoint({}, {});
+        votersA.addVoter(Voter(-1, "Ann", "", -1, -1, "", -20, 0));
+        votersB.addVoter(Voter(-1, "Bob", "", -1, -1, "", 30, 0));
+        votersB.addVoter(Voter(-1, "Bea", "", -1, -1, "", 40, 0));
+    }
+
+    EventLog logA(EventLog::pathForDatabase(pathA));
+    EventLog logB(EventLog::pathForDatabase(pathB));
+    const SimulationState stateA = logA.stateAt(0);
+    const SimulationState stateB = logB.stateAt(0);
+    REQUIRE(stateA.voters.size() == 1);
+    REQUIRE(stateA.voters[0].ideologyX == -20);
+    REQUIRE(stateB.voters.size() == 2);
+    REQUIRE(stateB.voters[0].ideologyX == 30);
+    REQUIRE(stateB.voters[1].ideologyX == 40);
+
+    QSqlDatabase::removeDatabase("test_events_a_connection");
+    QSqlDatabase::removeDatabase("test_events_b_connection");
+}
@@ -0,0 +1,89 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "diagnostics/MeteredQuery.h"
+#include "diagnostics/SlowQueryLog.h"
+
+#include <QFile>
+#include <QSqlDatabase>
+
+namespace {
+
+QString readAll(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) return {};
+    return QString::fromUtf8(file.readAll());
+}
+
+} // namespace
+
+TEST_CASE("Slow queries are logged with bound values and query plan", "[slowquery]") {
+    SlowQueryLog& log = SlowQueryLog::instance();
+    const double oldThreshold = log.thresholdMs();
+    const QString oldPath = log.logPath();
+    const QString path = "test_slow_queries.log";
+    QFile::remove(path);
+    log.setLogPath(path);
+
+    const QString connName = "test_slow_query_log";
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
+        db.setDatabaseName(":memory:");
+        REQUIRE(db.open());
+
+        MeteredQuery query(db, "Test");
+        REQUIRE(query.exec("CREATE TABLE items (id INTEGER PRIMARY KEY, name TEXT)"));
+        REQUIRE(query.exec("INSERT INTO items (name) VALUES ('a'), ('b')"));
+
+        // Log every statement from here on
+        log.setThresholdMs(0.0);
+        const int before = log.entryCount();
+        REQUIRE(query.prepare("SELECT id FROM items WHERE name = ?"));
+        query.addBindValue(QString("needle"));
+        REQUIRE(query.exec());
+        REQUIRE(log.entryCount() == before + 1);
+
+        const QStringList plan = SlowQueryLog::queryPlan(db, "SELECT id FROM items WHERE id = ?", { 1 });
+        REQUIRE(plan.size() == 1);
+        REQUIRE(plan.first().startsWith("SEARCH items"));
+        REQUIRE(SlowQueryLog::queryPlan(db, "CREATE TABLE other (id INTEGER)", {}).isEmpty());
+    }
+    QSqlDatabase::removeDatabase(connName);
+    log.setThresholdMs(oldThreshold);
+    log.setLogPath(oldPath);
+
+    const QString contents = readAll(path);
+    REQUIRE(contents.contains("[Test]"));
+    REQUIRE(contents.contains("SQL: SELECT id FROM items WHERE name = ?"));
+    REQUIRE(contents.contains("Bound: [needle]"));
+    REQUIRE(contents.contains("SCAN items"));
+    QFile::remove(path);
+}
+
+TEST_CASE("Slow query log rotates when it grows too large", "[slowquery]") {
+    SlowQueryLog& log = SlowQueryLog::instance();
+    const double oldThreshold = log.thresholdMs();
+    const QString oldPath = log.logPath();
+    const qint64 oldMaxBytes = log.maxBytes();
+    const int oldKept = log.keptFiles();
+
+    const QString path = "test_slow_rotation.log";
+    for (const QString& file : { path, path + ".1", path + ".2", path + ".3" })
+        QFile::remove(file);
+    log.setLogPath(path);
+    log.setRotation(1, 2);  // Rotate before every entry
+    log.setThresholdMs(0.0);
+
+    for (int i = 0; i < 4; ++i)
+        log.report("Test", QSqlDatabase(), QString("SELECT %1").arg(i), {}, 1.0);
+
+    REQUIRE(readAll(path).contains("SELECT 3"));
+    REQUIRE(readAll(path + ".1").contains("SELECT 2"));
+    REQUIRE(readAll(path + ".2").contains("SELECT 1"));
+    REQUIRE_FALSE(QFile::exists(path + ".3"));
+
+    log.setThresholdMs(oldThreshold);
+    log.setLogPath(oldPath);
+    log.setRotation(oldMaxBytes, oldKept);
+    for (const QString& file : { path, path + ".1", path + ".2" })
+        QFile::remove(file);
+}
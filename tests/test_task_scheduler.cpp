@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "diagnostics/MetricsRegistry.h"
+#include "simulation/TaskScheduler.h"
+
+#include <atomic>
+#include <vector>
+
+TEST_CASE("Parallel for visits every index once and parallel reduce is ordered", "[scheduler]") {
+    TaskScheduler scheduler(3);
+    REQUIRE(scheduler.workerCount() == 3);
+
+    std::vector<std::atomic<int>> visits(100000);
+    REQUIRE(scheduler.parallelFor(0, 100000, 1000, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i)
+            visits[i].fetch_add(1, std::memory_order_relaxed);
+    }));
+    for (const std::atomic<int>& v : visits)
+        REQUIRE(v.load() == 1);
+
+    const qint64 sum = scheduler.parallelReduce(1, 100001, 777, qint64(0),
+        [](int begin, int end) { qint64 s = 0; for (int i = begin; i < end; ++i) s += i; return s; },
+        [](qint64 a, qint64 b) { return a + b; });
+    REQUIRE(sum == qint64(100000) * 100001 / 2);
+
+    // Chunks are combined in index order whatever thread ran them
+    const QVector<int> starts = scheduler.parallelReduce(0, 10000, 1000, QVector<int>(),
+        [](int begin, int) { return QVector<int>{ begin }; },
+        [](QVector<int> all, QVector<int> chunk) { all += chunk; return all; });
+    REQUIRE(starts == QVector<int>({ 0, 1000, 2000, 3000, 4000, 5000, 6000, 7000, 8000, 9000 }));
+
+    REQUIRE(scheduler.parallelReduce(5, 5, 10, 42, [](int, int) { return 0; }, [](int a, int b) { return a + b; }) == 42);
+}
+
+TEST_CASE("Nested fork/join completes and reports to the metrics registry", "[scheduler]") {
+    MetricsRegistry::instance().reset();
+    TaskScheduler scheduler(2);
+
+    // Every outer range runs its own parallel loop; waiting threads keep running tasks, so this cannot deadlock
+    std::atomic<qint64> total{ 0 };
+    scheduler.parallelFor(0, 64, 1, [&](int begin, int end) {
+        for (int outer = begin; outer < end; ++outer) {
+            scheduler.parallelFor(0, 1000, 100, [&](int b, int e) { total.fetch_add(e - b, std::memory_order_relaxed); });
+        }
+    });
+    REQUIRE(total.load() == 64000);
+
+    TaskScheduler::TaskGroup group(scheduler);
+    std::atomic<int> ran{ 0 };
+    for (int i = 0; i < 10; ++i)
+        group.spawn([&]() { ran.fetch_add(1); });
+    group.wait();
+    REQUIRE(ran.load() == 10);
+
+    const TaskScheduler::Stats stats = scheduler.stats();
+    REQUIRE(stats.workers == 2);
+    REQUIRE(stats.tasksExecuted >= 10);
+    REQUIRE(stats.utilization() >= 0.0);
+    REQUIRE(MetricsRegistry::instance().counter("scheduler.tasks") == stats.tasksExecuted);
+    REQUIRE(MetricsRegistry::instance().histogram("scheduler.utilization_pct").count > 0);
+    MetricsRegistry::instance().reset();
+}
+
+TEST_CASE("Cancelling a parallel loop skips the ranges not yet started", "[scheduler]") {
+    TaskScheduler scheduler(2);
+    CancellationToken token;
+    std::atomic<int> ranges{ 0 };
+
+    const bool completed = scheduler.parallelFor(0, 100000, 10, [&](int, int) {
+        if (ranges.fetch_add(1) == 5) token.cancel();
+    }, token);
+
+    REQUIRE_FALSE(completed);
+    REQUIRE(token.isCancelled());
+    REQUIRE(ranges.load() < 10000);     // 10000 ranges without cancellation
+}
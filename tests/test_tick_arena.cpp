@@ -0,0 +1,78 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "diagnostics/MetricsRegistry.h"
+#include "simulation/SeatAllocation.h"
+#include "simulation/TickArena.h"
+
+#include <thread>
+
+TEST_CASE("Arena memory is rewound when the outermost scope closes", "[arena]") {
+    const void* first = nullptr;
+    {
+        TickArena::Scope scope;
+        TickArena::Vector<int> counts(1000, 0, TickArena::resource());
+        first = counts.data();
+        {
+            TickArena::Scope nested;
+            TickArena::Vector<double> scratch(100, 1.0, TickArena::resource());
+            REQUIRE(TickArena::stats().depth == 2);
+        }
+        // Closing the nested scope must not free the outer scope's memory
+        TickArena::Vector<int> more(1000, 7, TickArena::resource());
+        REQUIRE(counts[999] == 0);
+        REQUIRE(more[0] == 7);
+        REQUIRE(TickArena::stats().usedBytes >= qint64(2000 * sizeof(int)));
+    }
+    REQUIRE(TickArena::stats().depth == 0);
+    REQUIRE(TickArena::stats().usedBytes == 0);
+
+    // The next pass starts again at the beginning of the buffer
+    TickArena::Scope scope;
+    TickArena::Vector<int> again(1000, 0, TickArena::resource());
+    REQUIRE(again.data() == first);
+    REQUIRE(TickArena::stats().spilledBytes == 0);
+}
+
+TEST_CASE("An arena that overflows grows once and then stops spilling", "[arena]") {
+    MetricsRegistry::instance().reset();
+    const size_t bytes = TickArena::kInitialBytes * 3;
+
+    // Own thread, so the arena starts at its initial size whatever other tests did; Catch2 assertions stay on this thread
+    qint64 firstSpill = 0;
+    TickArena::Stats afterGrowth;
+    qint64 laterSpill = 0;
+    TickArena::Stats afterPasses;
+    std::thread([&]() {
+        {
+            TickArena::Scope scope;
+            TickArena::Vector<char> big(bytes, 'x', TickArena::resource());
+            firstSpill = TickArena::stats().spilledBytes;
+        }
+        afterGrowth = TickArena::stats();
+
+        for (int pass = 0; pass < 3; ++pass) {
+            TickArena::Scope scope;
+            TickArena::Vector<char> big(bytes, 'x', TickArena::resource());
+            laterSpill += TickArena::stats().spilledBytes;
+        }
+        afterPasses = TickArena::stats();
+    }).join();
+
+    REQUIRE(firstSpill > 0);
+    REQUIRE(afterGrowth.growths == 1);
+    REQUIRE(afterGrowth.capacityBytes >= qint64(bytes));
+    REQUIRE(afterGrowth.peakBytes >= qint64(bytes));
+    REQUIRE(MetricsRegistry::instance().counter("arena.growths") == 1);
+
+    REQUIRE(laterSpill == 0);
+    REQUIRE(afterPasses.growths == 1);
+    REQUIRE(afterPasses.resets == 4);
+    MetricsRegistry::instance().reset();
+}
+
+TEST_CASE("Seat allocation from arena buffers matches the known results", "[arena]") {
+    // D'Hondt: 100k/80k/30k/20k for 8 seats gives 4/3/1/0
+    REQUIRE(SeatAllocator::allocate({ 100000, 80000, 30000, 20000 }, 8, SeatMethod::DHondt) == QVector<int>({ 4, 3, 1, 0 }));
+    REQUIRE(SeatAllocator::allocate({ 100000, 80000, 30000, 20000 }, 8, SeatMethod::SainteLague) == QVector<int>({ 3, 3, 1, 1 }));
+    REQUIRE(TickArena::stats().depth == 0);
+}
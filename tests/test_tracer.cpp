@@ -0,0 +1,73 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "diagnostics/Tracer.h"
+
+#include <QBuffer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <thread>
+
+namespace {
+
+QJsonArray exportedEvents() {
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    Tracer::instance().writeChromeTrace(buffer);
+    return QJsonDocument::fromJson(buffer.data()).object().value("traceEvents").toArray();
+}
+
+} // namespace
+
+TEST_CASE("Tracer records nothing while disabled", "[tracer]") {
+    Tracer& tracer = Tracer::instance();
+    tracer.setEnabled(false);
+    tracer.clear();
+
+    { TRACE_SCOPE("test", "disabled scope"); }
+    TRACE_COUNTER("test", "disabled counter", 1);
+    REQUIRE(tracer.eventCount() == 0);
+}
+
+TEST_CASE("Tracer exports scopes and counters as Chrome trace events", "[tracer]") {
+    Tracer& tracer = Tracer::instance();
+    tracer.clear();
+    tracer.setEnabled(true);
+
+    {
+        TRACE_SCOPE("test", "outer");
+        { TRACE_SCOPE("test", "inner \"quoted\""); }
+        TRACE_COUNTER("test", "voters", 42);
+    }
+    std::thread worker([]() { TRACE_SCOPE("test", "worker"); });
+    worker.join();
+    tracer.setEnabled(false);
+    REQUIRE(tracer.eventCount() == 4);
+
+    const QJsonArray events = exportedEvents();
+    QJsonObject outer, inner, counter, work;
+    int threadNames = 0;
+    for (const QJsonValue& value : events) {
+        const QJsonObject e = value.toObject();
+        const QString name = e.value("name").toString();
+        if (name == "thread_name") ++threadNames;
+        else if (name == "outer") outer = e;
+        else if (name == "inner \"quoted\"") inner = e;
+        else if (name == "voters") counter = e;
+        else if (name == "worker") work = e;
+    }
+
+    REQUIRE(threadNames >= 2);
+    REQUIRE(outer.value("ph").toString() == "X");
+    REQUIRE(outer.value("cat").toString() == "test");
+    REQUIRE(inner.value("ts").toDouble() >= outer.value("ts").toDouble());
+    REQUIRE(inner.value("ts").toDouble() + inner.value("dur").toDouble()
+            <= outer.value("ts").toDouble() + outer.value("dur").toDouble());
+    REQUIRE(counter.value("ph").toString() == "C");
+    REQUIRE(counter.value("args").toObject().value("value").toDouble() == 42.0);
+    REQUIRE(work.value("tid").toInt() != outer.value("tid").toInt());
+
+    tracer.clear();
+    REQUIRE(tracer.eventCount() == 0);
+}
@@ -0,0 +1,181 @@
+#include <catch2/catch_test_macros.hpp>
+#include <QPoint>
+#include <QPointF>
+#include <QSqlDatabase>
+
+#include "models/IdeologyModel.h"
+#include "models/PartyModel.h"
+#include "models/VoterModel.h"
+#include "simulation/VoterHistogram.h"
+#include "simulation/DensityQuadtree.h"
+#include "simulation/VoterSpatialIndex.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "utilities/ScopedFileRemover.h"
+
+TEST_CASE("Histogram answers rectangle counts from prefix sums", "[histogram]") {
+    VoterHistogram histogram;
+    histogram.add(0, 0, 3);
+    histogram.add(10, -10);
+    histogram.add(-100, 100);
+
+    REQUIRE(histogram.rectangleCount(-100, -100, 100, 100) == 5);
+    REQUIRE(histogram.rectangleCount(0, 0, 0, 0) == 3);
+    REQUIRE(histogram.rectangleCount(10, 0, 0, -10) == 4);          // bounds in any order
+    REQUIRE(histogram.rectangleCount(-500, 50, -90, 500) == 1);     // clipped to the compass
+    REQUIRE(histogram.rectangleCount(101, 101, 200, 200) == 0);
+
+    histogram.move(0, 0, 50, 50);
+    REQUIRE(histogram.rectangleCount(0, 0, 0, 0) == 2);
+    REQUIRE(histogram.rectangleCount(40, 40, 60, 60) == 1);
+}
+
+TEST_CASE("Density quadtree aggregates cells at every zoom level", "[histogram]") {
+    VoterHistogram histogram;
+    histogram.add(-100, -100, 2);
+    histogram.add(-99, -99);
+    histogram.add(100, 100, 5);
+
+    DensityQuadtree density(histogram);
+    REQUIRE(density.total() == 8);
+    REQUIRE(density.countAt(0, -100, -100) == 2);
+    REQUIRE(density.countAt(1, -99, -100) == 3);        // (-100..-99, -100..-99) is one level-1 node
+    REQUIRE(density.countAt(8, 0, 0) == 8);
+    REQUIRE(density.countAt(0, 101, 0) == 0);
+
+    density.add(100, 100, -5);
+    density.add(0, 0, 1);
+    REQUIRE(density.total() == 4);
+    REQUIRE(density.countAt(4, 0, 0) == 1);
+
+    REQUIRE(DensityQuadtree::levelForScale(0.5) == 0);
+    REQUIRE(DensityQuadtree::levelForScale(4.5) == 2);
+    REQUIRE(DensityQuadtree::levelForScale(1000.0) == DensityQuadtree::kLevels - 1);
+}
+
+TEST_CASE("Spatial index finds the same neighbours as a brute-force scan", "[histogram]") {
+    QVector<Voter> voters;
+    for (int id = 1; id <= 2000; ++id)
+        voters.append(Voter(id, "", "", -1, -1, "", (id * 37) % 201 - 100, (id * 91) % 201 - 100));
+
+    VoterSpatialIndex index;
+    index.rebuild(voters);
+    REQUIRE(index.size() == 2000);
+
+    // Move and drop a few voters so the incremental paths are exercised too
+    for (int id = 1; id <= 100; ++id) {
+        voters[id - 1].ideologyX = (voters[id - 1].ideologyX + 50) % 101;
+        index.move(id, voters[id - 1].ideologyX, voters[id - 1].ideologyY);
+    }
+    for (int id = 101; id <= 150; ++id)
+        index.remove(id);
+    voters.remove(100, 50);
+    REQUIRE(index.size() == 1950);
+
+    for (const QPoint& query : { QPoint(0, 0), QPoint(-100, -100), QPoint(100, 37), QPoint(55, -12) }) {
+        QVector<QPair<int, int>> expected;     // (squared distance, ID)
+        for (const Voter& v : voters) {
+            const int dx = v.ideologyX - query.x();
+            const int dy = v.ideologyY - query.y();
+            expected.append({ dx * dx + dy * dy, v.id });
+        }
+        std::sort(expected.begin(), expected.end());
+
+        const QVector<VoterNeighbour> nearest = index.nearest(query.x(), query.y(), 10);
+        REQUIRE(nearest.size() == 10);
+        for (int i = 0; i < nearest.size(); ++i) {
+            REQUIRE(nearest[i].voterId == expected[i].second);
+            REQUIRE(nearest[i].distance == std::sqrt(double(expected[i].first)));
+        }
+    }
+
+    const QVector<VoterNeighbour> withoutSelf = index.nearest(voters[0].ideologyX, voters[0].ideologyY, 1, voters[0].id);
+    REQUIRE(withoutSelf.size() == 1);
+    REQUIRE(withoutSelf[0].voterId != voters[0].id);
+    REQUIRE(index.nearest(0, 0, 5000).size() == 1950);
+}
+
+TEST_CASE("Spatial index answers rectangle and lasso queries by whole cells", "[histogram]") {
+    QVector<Voter> voters;
+    for (int id = 1; id <= 5000; ++id)
+        voters.append(Voter(id, "", "", -1, -1, "", (id * 37) % 201 - 100, (id * 91) % 201 - 100));
+    VoterSpatialIndex index;
+    index.rebuild(voters);
+
+    auto sorted = [](QVector<int> ids) {
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    };
+
+    QVector<int> inBox;
+    for (const Voter& v : voters) {
+        if (v.ideologyX >= -20 && v.ideologyX <= 30 && v.ideologyY >= -5 && v.ideologyY <= 40) inBox.append(v.id);
+    }
+    REQUIRE(sorted(index.inRectangle(30, 40, -20, -5)) == inBox);
+    REQUIRE(index.inRectangle(-500, -500, 500, 500).size() == 5000);
+    REQUIRE(index.inRectangle(101, 101, 200, 200).isEmpty());
+
+    // Vertices off the grid, so no voter sits exactly on an edge
+    const QVector<QPointF> lasso = { QPointF(-50.5, -40.3), QPointF(60.2, -10.7), QPointF(0.4, 70.9), QPointF(-10.1, 5.2) };
+    QVector<int> inLasso;
+    for (const Voter& v : voters) {
+        bool inside = false;
+        for (int i = 0, j = lasso.size() - 1; i < lasso.size(); j = i++) {
+            const QPointF& a = lasso[i];
+            const QPointF& b = lasso[j];
+            if ((a.y() > v.ideologyY) != (b.y() > v.ideologyY)
+                && v.ideologyX < a.x() + (v.ideologyY - a.y()) * (b.x() - a.x()) / (b.y() - a.y()))
+                inside = !inside;
+        }
+        if (inside) inLasso.append(v.id);
+    }
+    REQUIRE_FALSE(inLasso.isEmpty());
+    REQUIRE(sorted(index.inPolygon(lasso)) == inLasso);
+    REQUIRE(index.inPolygon({ QPointF(0, 0), QPointF(10, 10) }).isEmpty());
+}
+
+TEST_CASE("VoterModel keeps its histogram in step with edits", "[histogram]") {
+    const QString connName = "test_histogram_connection";
+    const QString dbPath = "test_histogram.sqlite";
+    ScopedFileRemover cleanup(dbPath);
+
+    {
+        PartyModel partyModel(connName, nullptr, false, dbPath);
+        IdeologyModel ideologyModel(connName);     // reloadData joins the ideologies table
+        VoterModel voterModel(connName, nullptr, dbPath);
+        voterModel.setPartyModel(&partyModel);
+
+        voterModel.addVoter(Voter(-1, "A", "", -1, -1, "", 10, 10));
+        voterModel.addVoter(Voter(-1, "B", "", -1, -1, "", 10, 10));
+        voterModel.addVoter(Voter(-1, "C", "", -1, -1, "", -20, 5));
+        REQUIRE(voterModel.rowCount() == 3);
+        REQUIRE(voterModel.histogram().total() == 3);
+        REQUIRE(voterModel.histogram().count(10, 10) == 2);
+
+        const int firstId = voterModel.getVoterIdAt(0);
+        Voter moved = voterModel.getVoterAt(0);
+        moved.ideologyX = -20;
+        moved.ideologyY = 5;
+        voterModel.updateVoter(firstId, moved);
+        REQUIRE(voterModel.histogram().count(10, 10) == 1);
+        REQUIRE(voterModel.histogram().count(-20, 5) == 2);
+
+        voterModel.deleteVoterById(firstId);
+        REQUIRE(voterModel.rowCount() == 2);
+        REQUIRE(voterModel.histogram().count(-20, 5) == 1);
+
+        voterModel.moveVoters({ VoterMove{ voterModel.getVoterIdAt(0), 0, 0 } });
+        REQUIRE(voterModel.histogram().rectangleCount(-1, -1, 1, 1) == 1);
+        REQUIRE(voterModel.spatialIndex().nearest(0, 0, 1).first().distance == 0.0);
+
+        // The incremental state must match a fresh load from the database
+        voterModel.reloadData();
+        REQUIRE(voterModel.histogram().total() == 2);
+        REQUIRE(voterModel.histogram().rectangleCount(-1, -1, 1, 1) == 1);
+        REQUIRE(voterModel.spatialIndex().size() == 2);
+    }
+
+    QSqlDatabase::database(connName).close();
+}
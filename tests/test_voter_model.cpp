@@ -5,7 +5,9 @@
 #include <QDebug>
 #include <QFile>
 
+#include "models/PartyModel.h"
 #include "models/VoterModel.h"
+#include "simulation/EventLog.h"
 
 #include "utilities/ScopedFileRemover.h"
 
@@ -67,3 +69,97 @@ TEST_CASE("VoterModel basic add/load", "[voter]") {
     }
     //QSqlDatabase::removeDatabase(connName);
 }
+
+TEST_CASE("VoterModel emits typed change notifications", "[voter]") {
+    const QString connName = "test_voter_signals_connection";
+    const QString dbPath = "test_voter_signals.sqlite";
+    ScopedFileRemover cleanup(dbPath);
+
+    {
+        PartyModel partyModel(connName, nullptr, false, dbPath);
+        VoterModel model(connName, nullptr, dbPath);
+
+        QVector<Voter> inserted, removed;
+        QVector<QPair<Voter, Voter>> changed;
+        int batches = 0;
+        QObject::connect(&model, &VoterModel::voterInserted, [&](const Voter& v) { inserted.append(v); });
+        QObject::connect(&model, &VoterModel::voterRemoved, [&](const Voter& v) { removed.append(v); });
+        QObject::connect(&model, &VoterModel::voterChanged, [&](const Voter& before, const Voter& after) {
+            changed.append({ before, after });
+        });
+        QObject::connect(&model, &VoterModel::votersChanged, [&](const QVector<Voter>& before, const QVector<Voter>& after) {
+            REQUIRE(before.size() == after.size());
+            batches += 1;
+        });
+
+        model.addVoter(Voter(-1, "A", "", -1, -1, "", 1, 2));
+        model.addVoter(Voter(-1, "B", "", -1, -1, "", 3, 4));
+        REQUIRE(inserted.size() == 2);
+        REQUIRE(inserted[1].id == model.getVoterIdAt(1));
+
+        model.updateVoter(inserted[0].id, Voter(-1, "A2", "", -1, -1, "", 5, 6));
+        REQUIRE(changed.size() == 1);
+        REQUIRE(changed[0].first.ideologyX == 1);
+        REQUIRE(changed[0].second.ideologyX == 5);
+        REQUIRE(changed[0].second.id == inserted[0].id);
+
+        model.moveVoters({ VoterMove{ inserted[1].id, -3, -4 } });
+        REQUIRE(batches == 1);
+
+        model.deleteVoterById(inserted[0].id);
+        REQUIRE(removed.size() == 1);
+        REQUIRE(removed[0].name == "A2");
+    }
+
+    QSqlDatabase::database(connName).close();
+}
+
+TEST_CASE("VoterModel deletes a selection of voters in one batch", "[voter]") {
+    const QString connName = "test_voter_bulk_connection";
+    const QString dbPath = "test_voter_bulk.sqlite";
+    const QString logPath = "test_voter_bulk.events";
+    ScopedFileRemover cleanup(dbPath);
+    ScopedFileRemover cleanupLog(logPath);
+
+    {
+        PartyModel partyModel(connName, nullptr, false, dbPath);
+        VoterModel model(connName, nullptr, dbPath);
+
+        for (int i = 0; i < 5; ++i)
+            model.addVoter(Voter(-1, QString("V%1").arg(i), "", -1, -1, "", i * 10, 0));
+        const int first = model.getVoterIdAt(0);
+        const int third = model.getVoterIdAt(2);
+        REQUIRE(model.rowOfVoter(third) == 2);
+
+        int resets = 0;
+        QObject::connect(&model, &VoterModel::votersReset, [&]() { ++resets; });
+
+        const QVector<int> selection = model.spatialIndex().inRectangle(0, -1, 25, 1);
+        REQUIRE(selection.size() == 3);
+
+        // IDs that match no row are not logged as removals and leave the model alone
+        EventLog log(logPath);
+        model.setEventLog(&log);
+        model.deleteVoters({ 99999 });
+        REQUIRE(log.isEmpty());
+        REQUIRE(resets == 0);
+
+        model.deleteVoters({ first, third, 99999 });
+        model.setEventLog(nullptr);
+        REQUIRE_FALSE(log.isEmpty());
+
+        REQUIRE(resets == 1);
+        REQUIRE(model.rowCount() == 3);
+        REQUIRE(model.rowOfVoter(first) == -1);
+        REQUIRE(model.rowOfVoter(third) == -1);
+        REQUIRE(model.histogram().total() == 3);
+        REQUIRE(model.spatialIndex().inRectangle(0, -1, 25, 1).size() == 1);
+
+        QSqlQuery count(QSqlDatabase::database(connName));
+        REQUIRE(count.exec("SELECT COUNT(*) FROM voters"));
+        REQUIRE(count.next());
+        REQUIRE(count.value(0).toInt() == 3);
+    }
+
+    QSqlDatabase::database(connName).close();
+}
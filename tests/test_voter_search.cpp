@@ -0,0 +1,71 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "search/VoterSearchIndex.h"
+
+namespace {
+
+Voter voter(int id, const QString& name, const QString& ideology, const QString& party) {
+    return Voter(id, name, ideology, -1, -1, party, 0, 0);
+}
+
+}
+
+TEST_CASE("Search index matches names, ideologies and parties ignoring case", "[search]") {
+    VoterSearchIndex index;
+    index.rebuild({
+        voter(1, "Alice Martin", "Liberalism", "Blue Party"),
+        voter(2, "Bob Stone", "Socialism", "Red Party"),
+        voter(3, "Martina Cole", "Conservatism", ""),
+    });
+    REQUIRE(index.size() == 3);
+
+    REQUIRE(index.matches("martin") == QVector<int>{ 1, 3 });
+    REQUIRE(index.matches("PARTY") == QVector<int>{ 1, 2 });
+    REQUIRE(index.matches("ism") == QVector<int>{ 1, 2, 3 });
+    REQUIRE(index.matches("n/a") == QVector<int>{ 3 });         // voters without a party show as N/A
+    REQUIRE(index.matches("bo") == QVector<int>{ 2 });          // short queries scan
+    REQUIRE(index.matches("").size() == 3);
+    REQUIRE(index.matches("zzz").isEmpty());
+    REQUIRE(index.matches("stone\nsoc") == QVector<int>{ 2 });   // columns are newline separated
+    REQUIRE(index.matches("Stone Soc").isEmpty());
+}
+
+TEST_CASE("Search index follows edits and removals", "[search]") {
+    VoterSearchIndex index;
+    index.insert(voter(1, "Alice", "Liberalism", "Blue"));
+    index.insert(voter(2, "Bob", "Socialism", "Red"));
+
+    REQUIRE_FALSE(index.insert(voter(1, "Alice", "Liberalism", "Blue")));      // unchanged text
+    REQUIRE(index.insert(voter(1, "Alice", "Liberalism", "Red")));
+    REQUIRE(index.matches("blue").isEmpty());
+    REQUIRE(index.matches("red") == QVector<int>{ 1, 2 });
+
+    REQUIRE(index.remove(2));
+    REQUIRE_FALSE(index.remove(2));
+    REQUIRE(index.matches("red") == QVector<int>{ 1 });
+    REQUIRE(index.size() == 1);
+
+    // Enough churn to trigger compaction must not change the answers
+    for (int round = 0; round < 2000; ++round) {
+        const QString party = (round % 2) ? "Blue" : "Green";
+        index.insert(voter(1, "Alice", "Liberalism", party));
+        index.insert(voter(100 + round, QString("Voter %1").arg(round), "Centrism", party));
+        index.remove(100 + round - 1);
+    }
+    REQUIRE(index.matches("alice") == QVector<int>{ 1 });
+    REQUIRE(index.matches("voter") == QVector<int>{ 2099 });
+    REQUIRE(index.matches("blue") == QVector<int>{ 1, 2099 });
+    REQUIRE(index.matches("green").isEmpty());
+    REQUIRE(index.size() == 2);
+}
+
+TEST_CASE("Search index stops when cancelled", "[search]") {
+    VoterSearchIndex index;
+    QVector<Voter> voters;
+    for (int i = 0; i < 20000; ++i)
+        voters.append(voter(i, QString("Voter %1").arg(i), "Centrism", "Grey"));
+    index.rebuild(voters);
+
+    REQUIRE(index.matches("grey").size() == 20000);
+    REQUIRE(index.matches("grey", []() { return true; }).size() < 20000);
+}